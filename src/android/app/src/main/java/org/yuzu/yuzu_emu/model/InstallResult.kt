@@ -7,7 +7,9 @@ enum class InstallResult(val int: Int) {
     Success(0),
     Overwrite(1),
     Failure(2),
-    BaseInstallAttempted(3);
+    BaseInstallAttempted(3),
+    HashMismatch(4),
+    Cancelled(5);
 
     companion object {
         fun from(int: Int): InstallResult = entries.firstOrNull { it.int == int } ?: Success
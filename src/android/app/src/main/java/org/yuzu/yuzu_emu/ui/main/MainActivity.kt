@@ -513,6 +513,7 @@ class MainActivity : AppCompatActivity(), ThemeProvider {
             var installSuccess = 0
             var installOverwrite = 0
             var errorBaseGame = 0
+            var errorHashMismatch = 0
             var error = 0
             documents.forEach {
                 messageCallback.invoke(FileUtil.getFilename(it))
@@ -536,7 +537,11 @@ class MainActivity : AppCompatActivity(), ThemeProvider {
                         errorBaseGame += 1
                     }
 
-                    InstallResult.Failure -> {
+                    InstallResult.HashMismatch -> {
+                        errorHashMismatch += 1
+                    }
+
+                    InstallResult.Failure, InstallResult.Cancelled -> {
                         error += 1
                     }
                 }
@@ -564,7 +569,7 @@ class MainActivity : AppCompatActivity(), ThemeProvider {
                 )
                 installResult.append(separator)
             }
-            val errorTotal: Int = errorBaseGame + error
+            val errorTotal: Int = errorBaseGame + errorHashMismatch + error
             if (errorTotal > 0) {
                 installResult.append(separator)
                 installResult.append(
@@ -581,6 +586,12 @@ class MainActivity : AppCompatActivity(), ThemeProvider {
                     )
                     installResult.append(separator)
                 }
+                if (errorHashMismatch > 0) {
+                    installResult.append(
+                        getString(R.string.install_game_content_failure_hash)
+                    )
+                    installResult.append(separator)
+                }
                 if (error > 0) {
                     installResult.append(
                         getString(R.string.install_game_content_failure_description)
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <vector>
 
 #include "common/fs/file.h"
@@ -13,6 +14,7 @@
 #ifdef _WIN32
 #include <io.h>
 #include <share.h>
+#include <windows.h>
 #else
 #include <unistd.h>
 #endif
@@ -452,4 +454,60 @@ s64 IOFile::Tell() const {
     return ftello(file);
 }
 
+size_t IOFile::ReadBytesAt(void* data, size_t size, u64 offset) const {
+    auto* const buffer = static_cast<u8*>(data);
+    size_t bytes_read = 0;
+
+#ifdef _WIN32
+    const auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(fileno(file)));
+
+    while (bytes_read < size) {
+        const u64 position = offset + bytes_read;
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(position);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+
+        const auto chunk_size = static_cast<DWORD>(std::min<size_t>(size - bytes_read, MAXDWORD));
+        DWORD chunk_read = 0;
+        if (!ReadFile(handle, buffer + bytes_read, chunk_size, &chunk_read, &overlapped)) {
+            const auto error = GetLastError();
+            if (error != ERROR_HANDLE_EOF) {
+                LOG_ERROR(Common_Filesystem,
+                          "Failed to read the file at path={}, offset={}, error={}",
+                          PathToUTF8String(file_path), position, error);
+            }
+            break;
+        }
+        if (chunk_read == 0) {
+            break;
+        }
+        bytes_read += chunk_read;
+    }
+#else
+    const int fd = fileno(file);
+
+    while (bytes_read < size) {
+        const u64 position = offset + bytes_read;
+        const auto result =
+            pread(fd, buffer + bytes_read, size - bytes_read, static_cast<off_t>(position));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const auto ec = std::error_code{errno, std::generic_category()};
+            LOG_ERROR(Common_Filesystem,
+                      "Failed to read the file at path={}, offset={}, ec_message={}",
+                      PathToUTF8String(file_path), position, ec.message());
+            break;
+        }
+        if (result == 0) {
+            break;
+        }
+        bytes_read += static_cast<size_t>(result);
+    }
+#endif
+
+    return bytes_read;
+}
+
 } // namespace Common::FS
@@ -287,6 +287,36 @@ public:
         return std::fread(data.data(), sizeof(T), data.size(), file);
     }
 
+    /**
+     * Reads a span of T data from a file at the specified offset.
+     * Unlike ReadSpan, this function bypasses the stream buffer and does not depend on the
+     * current position of the file pointer, so it may be called from multiple threads at once.
+     * Data written sequentially must be flushed before it can be read with this function.
+     * On Windows the file pointer may be moved, sequential accesses must Seek beforehand.
+     *
+     * Failures occur when:
+     * - The file is not open
+     * - The opened file lacks read permissions
+     * - Attempting to read beyond the end-of-file
+     *
+     * @tparam T Data type
+     *
+     * @param data Span of T data
+     * @param offset Offset in bytes from the start of the file
+     *
+     * @returns Count of T data successfully read.
+     */
+    template <typename T>
+    [[nodiscard]] size_t ReadSpanAt(std::span<T> data, u64 offset) const {
+        static_assert(std::is_trivially_copyable_v<T>, "Data type must be trivially copyable.");
+
+        if (!IsOpen()) {
+            return 0;
+        }
+
+        return ReadBytesAt(data.data(), data.size_bytes(), offset) / sizeof(T);
+    }
+
     /**
      * Writes a span of T data to a file sequentially.
      * This function writes from the current position of the file pointer and
@@ -449,6 +479,8 @@ public:
     [[nodiscard]] s64 Tell() const;
 
 private:
+    [[nodiscard]] size_t ReadBytesAt(void* data, size_t size, u64 offset) const;
+
     std::filesystem::path file_path;
     FileAccessMode file_access_mode{};
     FileType file_type{};
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/fs/mapped_file.h"
+#ifdef ANDROID
+#include "common/fs/fs_android.h"
+#endif
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+namespace Common::FS {
+
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+    }
+    return *this;
+}
+
+void MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+#ifdef _WIN32
+    const HANDLE file =
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={}, error={}",
+                  PathToUTF8String(path), GetLastError());
+        return;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, error={}",
+                  PathToUTF8String(path), GetLastError());
+        return;
+    }
+    // The view keeps the mapping object alive
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, error={}",
+                  PathToUTF8String(path), GetLastError());
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+#ifdef ANDROID
+    const int fd = Android::IsContentUri(path)
+                       ? Android::OpenContentUri(path, Android::OpenMode::Read)
+                       : open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    if (fd == -1) {
+        const auto ec = std::error_code{errno, std::generic_category()};
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={}, ec_message={}",
+                  PathToUTF8String(path), ec.message());
+        return;
+    }
+    struct stat file_status {};
+    if (fstat(fd, &file_status) != 0 || file_status.st_size <= 0) {
+        close(fd);
+        return;
+    }
+    const auto file_size = static_cast<size_t>(file_status.st_size);
+    // The mapping stays valid after the descriptor is closed
+    void* const view = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        const auto ec = std::error_code{errno, std::generic_category()};
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, ec_message={}",
+                  PathToUTF8String(path), ec.message());
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = file_size;
+#endif
+}
+
+void MappedFile::Close() {
+    if (!IsOpen()) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<u8*>(data), size);
+#endif
+
+    data = nullptr;
+    size = 0;
+}
+
+bool MappedFile::IsOpen() const {
+    return data != nullptr;
+}
+
+std::span<const u8> MappedFile::GetData() const {
+    return {data, size};
+}
+
+} // namespace Common::FS
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only view of the whole contents of a file mapped into the address space of the process.
+ * Reads from the mapping need no system call nor lock and may happen from any thread.
+ *
+ * The file must not be truncated while it is mapped, accessing pages past its new end faults.
+ */
+class MappedFile {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path, see Open.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path for reading.
+     * If a file is already mapped, it is unmapped first.
+     *
+     * Failures occur when:
+     * - The file does not exist or cannot be opened for reading
+     * - The file is empty
+     * - The operating system refuses to map the file
+     *
+     * @param path Filesystem path
+     */
+    void Open(const std::filesystem::path& path);
+
+    /// Unmaps the file, if one is mapped.
+    void Close();
+
+    /**
+     * Checks whether a file is mapped.
+     *
+     * @returns True if a file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsOpen() const;
+
+    /**
+     * Gets the contents of the mapped file.
+     *
+     * @returns The mapped contents, empty if no file is mapped.
+     */
+    [[nodiscard]] std::span<const u8> GetData() const;
+
+private:
+    const u8* data = nullptr;
+    size_t size = 0;
+};
+
+} // namespace Common::FS
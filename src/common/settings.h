@@ -192,6 +192,9 @@ struct Values {
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
+    // Host threads processing the sessions of the socket services, which several guest threads
+    // call at the same time
+    Setting<u16> bsd_host_threads{linkage, 3, "bsd_host_threads", Category::Core};
     SwitchableSetting<MemoryLayout, true> memory_layout_mode{linkage,
                                                              MemoryLayout::Memory_4Gb,
                                                              MemoryLayout::Memory_4Gb,
@@ -384,6 +387,10 @@ struct Values {
                                                                   AstcRecompression::Bc3,
                                                                   "astc_recompression",
                                                                   Category::RendererAdvanced};
+    SwitchableSetting<bool> use_astc_decode_cache{linkage, false, "use_astc_decode_cache",
+                                                  Category::RendererAdvanced};
+    SwitchableSetting<bool> use_disk_texture_cache{linkage, false, "use_disk_texture_cache",
+                                                   Category::RendererAdvanced};
     SwitchableSetting<VramUsageMode, true> vram_usage_mode{linkage,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Conservative,
@@ -570,6 +577,8 @@ struct Values {
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
                                        Category::DataStorage};
+    Setting<bool> map_game_files{linkage, false, "map_game_files", Category::DataStorage};
+    Setting<u16> fs_block_cache_size{linkage, 64, "fs_block_cache_size", Category::DataStorage};
 
     // Debugging
     bool record_frame_times;
@@ -583,6 +592,12 @@ struct Values {
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> dump_gpu_commands{
+        linkage, false, "dump_gpu_commands", Category::DebuggingGraphics, Specialization::Default,
+        false};
+    Setting<bool> profile_macros{
+        linkage, false, "profile_macros", Category::DebuggingGraphics, Specialization::Default,
+        false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
@@ -594,6 +609,8 @@ struct Values {
     Setting<bool> extended_logging{
         linkage, false, "extended_logging", Category::Debugging, Specialization::Default, false};
     Setting<bool> use_debug_asserts{linkage, false, "use_debug_asserts", Category::Debugging};
+    Setting<bool> guest_profiler{linkage, false, "guest_profiler", Category::Debugging};
+    Setting<bool> service_profiler{linkage, false, "service_profiler", Category::Debugging};
     Setting<bool> use_auto_stub{
         linkage, false, "use_auto_stub", Category::Debugging, Specialization::Default, false};
     Setting<bool> enable_all_controllers{linkage, false, "enable_all_controllers",
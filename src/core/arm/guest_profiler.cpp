@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "common/demangle.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/arm/debug.h"
+#include "core/arm/guest_profiler.h"
+#include "core/arm/symbols.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_core.h"
+#include "core/memory.h"
+
+namespace Core {
+
+namespace {
+
+std::vector<u64> WalkStack(Kernel::KProcess& process, const Kernel::Svc::ThreadContext& ctx) {
+    auto& memory = process.GetMemory();
+    const bool is_64 = process.Is64Bit();
+    const u64 word_size = is_64 ? sizeof(u64) : sizeof(u32);
+    const auto read_word = [&](u64 address) -> u64 {
+        return is_64 ? memory.Read64(address) : memory.Read32(address);
+    };
+
+    std::vector<u64> stack{ctx.pc};
+    if (ctx.lr != 0) {
+        stack.push_back(ctx.lr);
+    }
+
+    // fp points to the frame record of the current function, two words long:
+    // fp+0         : pointer to the previous frame record
+    // fp+word_size : value of lr for the frame
+    u64 fp = ctx.fp;
+    for (bool first = true; stack.size() < GuestProfiler::MaxStackDepth; first = false) {
+        if (fp == 0 || fp % 4 != 0 || !memory.IsValidVirtualAddressRange(fp, word_size * 2)) {
+            break;
+        }
+        const u64 lr = read_word(fp + word_size);
+        const u64 next_fp = read_word(fp);
+
+        // Once its prologue ran, the record of the current function holds the lr seen above.
+        if (lr == 0) {
+            break;
+        }
+        if (!first || lr != ctx.lr) {
+            stack.push_back(lr);
+        }
+
+        // Frame records are further up the stack the deeper they are, stop on a corrupt chain.
+        if (next_fp <= fp) {
+            break;
+        }
+        fp = next_fp;
+    }
+    return stack;
+}
+
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler(System& system_)
+    : system{system_}, sampling_thread{[this](std::stop_token stop_token) {
+          SamplingLoop(stop_token);
+      }} {}
+
+GuestProfiler::~GuestProfiler() = default;
+
+void GuestProfiler::SamplingLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("GuestProfiler");
+
+    auto& kernel = system.Kernel();
+    while (Common::StoppableTimedWait(stop_token, SampleInterval)) {
+        for (size_t core_index = 0; core_index < Hardware::NUM_CPU_CORES; ++core_index) {
+            kernel.PhysicalCore(core_index).RequestSample();
+        }
+    }
+}
+
+void GuestProfiler::Record(size_t core_index, Kernel::KProcess& process,
+                           const Kernel::Svc::ThreadContext& ctx) {
+    if (!process.IsApplication()) {
+        return;
+    }
+
+    auto stack = WalkStack(process, ctx);
+
+    CoreSamples& samples = cores[core_index];
+    std::scoped_lock lk{samples.mutex};
+    ++samples.stacks[std::move(stack)];
+}
+
+void GuestProfiler::Export(Kernel::KProcess& process) {
+    sampling_thread.request_stop();
+    if (sampling_thread.joinable()) {
+        sampling_thread.join();
+    }
+
+    std::map<std::vector<u64>, u64> stacks;
+    u64 num_samples = 0;
+    for (CoreSamples& samples : cores) {
+        std::scoped_lock lk{samples.mutex};
+        for (const auto& [stack, count] : samples.stacks) {
+            stacks[stack] += count;
+            num_samples += count;
+        }
+    }
+    if (stacks.empty()) {
+        LOG_INFO(Core_ARM, "The guest profiler recorded no samples");
+        return;
+    }
+
+    // Resolve every distinct address once.
+    const bool is_64 = process.Is64Bit();
+    const auto modules = FindModules(&process);
+    std::map<VAddr, Symbols::Symbols> symbols;
+    for (const auto& [base, name] : modules) {
+        symbols.emplace(base, Symbols::GetSymbols(base, process.GetMemory(), is_64));
+    }
+
+    std::unordered_map<u64, std::string> frame_names;
+    const auto get_frame_name = [&](u64 address) -> const std::string& {
+        auto [it, inserted] = frame_names.try_emplace(address);
+        if (!inserted) {
+            return it->second;
+        }
+
+        auto module = modules.upper_bound(address);
+        if (module == modules.begin()) {
+            it->second = fmt::format("unknown+{:#x}", address);
+            return it->second;
+        }
+        --module;
+
+        const u64 offset = address - module->first;
+        const auto symbol = Symbols::GetSymbolName(symbols.at(module->first), offset);
+        std::string name = symbol ? Common::DemangleSymbol(*symbol)
+                                  : fmt::format("{:#x}", offset);
+        // Semicolons separate the frames of folded stacks.
+        std::ranges::replace(name, ';', ':');
+        it->second = fmt::format("{}`{}", module->second, name);
+        return it->second;
+    };
+
+    std::string folded;
+    for (const auto& [stack, count] : stacks) {
+        // Folded stacks go from the root to the leaf. Return addresses point after the call, so
+        // step back into the calling instruction to resolve the caller.
+        for (size_t i = stack.size(); i-- > 0;) {
+            folded += get_frame_name(i == 0 ? stack[i] : stack[i] - 1);
+            folded += i == 0 ? ' ' : ';';
+        }
+        folded += fmt::format("{}\n", count);
+    }
+
+    const auto path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) /
+                      fmt::format("guest_profile_{:016X}.folded", process.GetProgramId());
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, folded) !=
+        folded.size()) {
+        LOG_ERROR(Core_ARM, "Failed to write the guest profile to {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    LOG_INFO(Core_ARM, "Wrote {} guest samples ({} distinct stacks) to {}", num_samples,
+             stacks.size(), Common::FS::PathToUTF8String(path));
+}
+
+} // namespace Core
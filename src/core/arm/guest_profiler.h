@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "core/hardware_properties.h"
+
+namespace Kernel {
+class KProcess;
+namespace Svc {
+struct ThreadContext;
+}
+} // namespace Kernel
+
+namespace Core {
+
+class System;
+
+/**
+ * Sampling profiler of the guest code run by the application. A host thread periodically asks
+ * every physical core for a sample, the cores then stop running guest code for a moment and
+ * record their PC, LR and the return addresses found by walking the frame pointer chain.
+ *
+ * Samples are kept as raw addresses and only resolved to module and symbol names when exported,
+ * as a folded-stack file which flamegraph.pl and speedscope read.
+ */
+class GuestProfiler {
+public:
+    /// Time between two samples of a core.
+    static constexpr std::chrono::microseconds SampleInterval{1000};
+
+    /// Frames kept per sample, deeper ones are dropped.
+    static constexpr size_t MaxStackDepth = 64;
+
+    explicit GuestProfiler(System& system_);
+    ~GuestProfiler();
+
+    /**
+     * Records a sample of a core, called by the core while it does not run guest code.
+     * @param core_index Index of the physical core
+     * @param process    Process of the thread the core runs
+     * @param ctx        Context of the thread
+     */
+    void Record(size_t core_index, Kernel::KProcess& process,
+                const Kernel::Svc::ThreadContext& ctx);
+
+    /**
+     * Stops sampling and writes the samples to a folded-stack file in the log directory.
+     * @param process Application process the samples were recorded from, its modules give the
+     *                symbols and its program ID names the file
+     */
+    void Export(Kernel::KProcess& process);
+
+private:
+    struct CoreSamples {
+        std::mutex mutex;
+        std::map<std::vector<u64>, u64> stacks; ///< Stacks from leaf to root, by sample count
+    };
+
+    void SamplingLoop(std::stop_token stop_token);
+
+    System& system;
+    std::array<CoreSamples, Hardware::NUM_CPU_CORES> cores;
+    std::jthread sampling_thread;
+};
+
+} // namespace Core
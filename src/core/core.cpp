@@ -14,6 +14,7 @@
 #include "common/settings_enums.h"
 #include "common/string_util.h"
 #include "core/arm/exclusive_monitor.h"
+#include "core/arm/guest_profiler.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
@@ -25,6 +26,7 @@
 #include "core/file_sys/romfs_factory.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/vfs/vfs_concat.h"
+#include "core/file_sys/vfs/vfs_mapped.h"
 #include "core/file_sys/vfs/vfs_real.h"
 #include "core/gpu_dirty_memory_manager.h"
 #include "core/hle/kernel/k_memory_manager.h"
@@ -46,6 +48,7 @@
 #include "core/hle/service/psc/time/system_clock.h"
 #include "core/hle/service/psc/time/time_zone_service.h"
 #include "core/hle/service/service.h"
+#include "core/hle/service/service_profiler.h"
 #include "core/hle/service/services.h"
 #include "core/hle/service/set/system_settings_server.h"
 #include "core/hle/service/sm/sm.h"
@@ -107,7 +110,17 @@ FileSys::VirtualFile GetGameFileFromPath(const FileSys::VirtualFilesystem& vfs,
         return vfs->OpenFile(path + "/main", FileSys::OpenMode::Read);
     }
 
-    return vfs->OpenFile(path, FileSys::OpenMode::Read);
+    auto file = vfs->OpenFile(path, FileSys::OpenMode::Read);
+    if (file == nullptr || !Settings::values.map_game_files.GetValue()) {
+        return file;
+    }
+
+    // Containers are read all over by the RomFS, let every thread read them without locking
+    const auto extension = Common::ToLower(file->GetExtension());
+    if (extension == "xci" || extension == "nsp" || extension == "nca") {
+        return FileSys::MappedVfsFile::MakeMappedFile(std::move(file), path);
+    }
+    return file;
 }
 
 struct System::Impl {
@@ -271,6 +284,21 @@ struct System::Impl {
         cpu_manager.Initialize();
     }
 
+    SystemResultStatus InitializeGPU(System& system, Frontend::EmuWindow& emu_window) {
+        InitializeKernel(system);
+
+        telemetry_session = std::make_unique<Core::TelemetrySession>();
+
+        host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
+        gpu_core = VideoCore::CreateGPU(emu_window, system);
+        if (!gpu_core) {
+            return SystemResultStatus::ErrorVideoCore;
+        }
+
+        is_powered_on = true;
+        return SystemResultStatus::Success;
+    }
+
     SystemResultStatus SetupForApplicationProcess(System& system, Frontend::EmuWindow& emu_window) {
         telemetry_session = std::make_unique<Core::TelemetrySession>();
 
@@ -282,6 +310,11 @@ struct System::Impl {
 
         audio_core = std::make_unique<AudioCore::AudioCore>(system);
 
+        // The services register their commands to the profiler when they are created.
+        if (Settings::values.service_profiler) {
+            service_profiler = std::make_unique<Service::ServiceProfiler>();
+        }
+
         service_manager = std::make_shared<Service::SM::ServiceManager>(kernel);
         services =
             std::make_unique<Service::Services>(service_manager, system, stop_event.get_token());
@@ -307,6 +340,7 @@ struct System::Impl {
     SystemResultStatus Load(System& system, Frontend::EmuWindow& emu_window,
                             const std::string& filepath,
                             Service::AM::FrontendAppletParameters& params) {
+        const auto load_start = PerfStats::Clock::now();
         InitializeKernel(system);
 
         const auto file = GetGameFileFromPath(virtual_filesystem, filepath);
@@ -374,7 +408,16 @@ struct System::Impl {
             }
         }
 
-        perf_stats = std::make_unique<PerfStats>(params.program_id);
+        LOG_INFO(Core, "Loaded the application in {} ms",
+                 std::chrono::duration_cast<std::chrono::milliseconds>(PerfStats::Clock::now() -
+                                                                       load_start)
+                     .count());
+
+        if (Settings::values.guest_profiler) {
+            guest_profiler = std::make_unique<GuestProfiler>(system);
+        }
+
+        perf_stats = std::make_unique<PerfStats>(params.program_id, load_start);
         // Reset counters and set time origin to current frame
         GetAndResetPerfStats();
         perf_stats->BeginSystemFrame();
@@ -416,6 +459,18 @@ struct System::Impl {
                                         perf_stats->GetMeanFrametime());
         }
 
+        // Export the guest profile while the modules of the application are still mapped.
+        if (guest_profiler) {
+            if (auto* const application = kernel.ApplicationProcess()) {
+                guest_profiler->Export(*application);
+            }
+        }
+
+        // The service profile is exported once the services stopped, name it before.
+        const u64 program_id = kernel.ApplicationProcess() != nullptr
+                                   ? kernel.ApplicationProcess()->GetProgramId()
+                                   : 0;
+
         is_powered_on = false;
         exit_locked = false;
         exit_requested = false;
@@ -432,6 +487,9 @@ struct System::Impl {
         kernel.ShutdownCores();
         services.reset();
         service_manager.reset();
+        if (service_profiler) {
+            service_profiler->Export(program_id);
+        }
         fs_controller.Reset();
         cheat_engine.reset();
         telemetry_session.reset();
@@ -442,8 +500,10 @@ struct System::Impl {
         host1x_core.reset();
         perf_stats.reset();
         cpu_manager.Shutdown();
+        guest_profiler.reset();
         debugger.reset();
         kernel.Shutdown();
+        service_profiler.reset();
         stop_event = {};
         Network::RestartSocketOperations();
 
@@ -547,6 +607,8 @@ struct System::Impl {
     std::string status_details = "";
 
     std::unique_ptr<Core::PerfStats> perf_stats;
+    std::unique_ptr<Core::GuestProfiler> guest_profiler;
+    std::unique_ptr<Service::ServiceProfiler> service_profiler;
     Core::SpeedLimiter speed_limiter;
 
     bool is_multicore{};
@@ -598,6 +660,14 @@ void System::ShutdownMainProcess() {
     impl->ShutdownMainProcess();
 }
 
+void System::InitializeKernel() {
+    impl->InitializeKernel(*this);
+}
+
+SystemResultStatus System::InitializeGPU(Frontend::EmuWindow& emu_window) {
+    return impl->InitializeGPU(*this, emu_window);
+}
+
 bool System::IsShuttingDown() const {
     return impl->IsShuttingDown();
 }
@@ -777,6 +847,14 @@ const Core::PerfStats& System::GetPerfStats() const {
     return *impl->perf_stats;
 }
 
+Core::GuestProfiler* System::GetGuestProfiler() {
+    return impl->guest_profiler.get();
+}
+
+Service::ServiceProfiler* System::GetServiceProfiler() {
+    return impl->service_profiler.get();
+}
+
 Core::SpeedLimiter& System::SpeedLimiter() {
     return impl->speed_limiter;
 }
@@ -73,6 +73,7 @@ class ARPManager;
 }
 
 class ServerManager;
+class ServiceProfiler;
 
 namespace SM {
 class ServiceManager;
@@ -119,6 +120,7 @@ class Debugger;
 class DeviceMemory;
 class ExclusiveMonitor;
 class GPUDirtyMemoryManager;
+class GuestProfiler;
 class PerfStats;
 class Reporter;
 class SpeedLimiter;
@@ -179,6 +181,20 @@ public:
     /// Shutdown the main emulated process.
     void ShutdownMainProcess();
 
+    /**
+     * Initializes the kernel without loading an application, for tools and tests driving it
+     * directly. Torn down with ShutdownMainProcess.
+     */
+    void InitializeKernel();
+
+    /**
+     * Initializes the kernel and creates the GPU without loading an application, for tools
+     * driving the GPU directly. Torn down with ShutdownMainProcess.
+     * @param emu_window Reference to the host-system window used for video output.
+     * @returns SystemResultStatus code, indicating if the operation succeeded.
+     */
+    [[nodiscard]] SystemResultStatus InitializeGPU(Frontend::EmuWindow& emu_window);
+
     /// Check if the core is shutting down.
     [[nodiscard]] bool IsShuttingDown() const;
 
@@ -320,6 +336,12 @@ public:
     /// Provides a constant reference to the internal PerfStats instance.
     [[nodiscard]] const Core::PerfStats& GetPerfStats() const;
 
+    /// Returns the guest profiler, or nullptr if the guest code is not being profiled.
+    [[nodiscard]] Core::GuestProfiler* GetGuestProfiler();
+
+    /// Returns the service profiler, or nullptr if the HLE services are not being profiled.
+    [[nodiscard]] Service::ServiceProfiler* GetServiceProfiler();
+
     /// Provides a reference to the speed limiter;
     [[nodiscard]] Core::SpeedLimiter& SpeedLimiter();
 
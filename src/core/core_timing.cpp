@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <limits>
 #include <mutex>
 #include <string>
 #include <tuple>
@@ -22,6 +23,42 @@ namespace Core::Timing {
 
 constexpr s64 MAX_SLICE_LENGTH = 10000;
 
+namespace {
+
+constexpr u64 GENERATION_SHIFT = 32;
+constexpr u64 INSTANCE_COUNT_MASK = (u64{1} << GENERATION_SHIFT) - 1;
+
+/// Event queue size under which unscheduled events are left in it until they are reached.
+constexpr size_t MIN_COMPACTED_QUEUE_SIZE = 256;
+
+constexpr u32 GetGeneration(u64 schedule_state) {
+    return static_cast<u32>(schedule_state >> GENERATION_SHIFT);
+}
+
+/// Starts a new generation of the event, returns the number of instances the old one had.
+u64 CancelGeneration(EventType& event_type) {
+    u64 state = event_type.schedule_state.load(std::memory_order_relaxed);
+    while (!event_type.schedule_state.compare_exchange_weak(
+        state, u64{GetGeneration(state) + 1U} << GENERATION_SHIFT, std::memory_order_acq_rel,
+        std::memory_order_relaxed)) {
+    }
+    return state & INSTANCE_COUNT_MASK;
+}
+
+/// Uncounts an instance of the event which ran, returns false if it was unscheduled meanwhile.
+bool CompleteInstance(EventType& event_type, u32 generation) {
+    u64 state = event_type.schedule_state.load(std::memory_order_relaxed);
+    do {
+        if (GetGeneration(state) != generation) {
+            return false;
+        }
+    } while (!event_type.schedule_state.compare_exchange_weak(
+        state, state - 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return true;
+}
+
+} // Anonymous namespace
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -31,7 +68,15 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::weak_ptr<EventType> type;
     s64 reschedule_time;
-    heap_t::handle_type handle{};
+    u32 generation;
+
+    /// Checks if the event type was destroyed or unscheduled since this event was scheduled.
+    bool IsStale() const {
+        const auto event_type{type.lock()};
+        return !event_type ||
+               GetGeneration(event_type->schedule_state.load(std::memory_order_acquire)) !=
+                   generation;
+    }
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
@@ -44,10 +89,18 @@ struct CoreTiming::Event {
     }
 };
 
+struct CoreTiming::QueuedEvent {
+    Event event;
+    QueuedEvent* next;
+};
+
 CoreTiming::CoreTiming() : clock{Common::CreateOptimalClock()} {}
 
 CoreTiming::~CoreTiming() {
     Reset();
+
+    std::scoped_lock lock{advance_lock};
+    TakeQueuedEvents();
 }
 
 void CoreTiming::ThreadEntry(CoreTiming& instance) {
@@ -72,8 +125,17 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 }
 
 void CoreTiming::ClearPendingEvents() {
-    std::scoped_lock lock{advance_lock, basic_lock};
+    std::scoped_lock lock{advance_lock};
+    TakeQueuedEvents();
+    // Only uncount the instances cancelled here, other threads may be scheduling meanwhile.
+    u64 num_instances = 0;
+    for (const Event& evt : event_queue) {
+        if (const auto event_type{evt.type.lock()}) {
+            num_instances += CancelGeneration(*event_type);
+        }
+    }
     event_queue.clear();
+    num_pending_events.fetch_sub(static_cast<s64>(num_instances), std::memory_order_relaxed);
     event.Set();
 }
 
@@ -111,58 +173,47 @@ bool CoreTiming::IsRunning() const {
 }
 
 bool CoreTiming::HasPendingEvents() const {
-    std::scoped_lock lock{basic_lock};
-    return !(wait_set && event_queue.empty());
+    return num_pending_events.load(std::memory_order_acquire) > 0;
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
                                const std::shared_ptr<EventType>& event_type, bool absolute_time) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
-
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
-        (*h).handle = h;
-    }
-
-    event.Set();
+    const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
+    QueueEvent(next_time.count(), 0, event_type);
 }
 
 void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
                                       std::chrono::nanoseconds resched_time,
                                       const std::shared_ptr<EventType>& event_type,
                                       bool absolute_time) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
+    const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
+    QueueEvent(next_time.count(), resched_time.count(), event_type);
+}
 
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
-        (*h).handle = h;
+void CoreTiming::QueueEvent(s64 time, s64 reschedule_time,
+                            const std::shared_ptr<EventType>& event_type) {
+    const u64 state = event_type->schedule_state.fetch_add(1, std::memory_order_acq_rel);
+    num_pending_events.fetch_add(1, std::memory_order_relaxed);
+
+    auto* const queued = new QueuedEvent{
+        .event = Event{time, event_fifo_id.fetch_add(1, std::memory_order_relaxed), event_type,
+                       reschedule_time, GetGeneration(state)},
+        .next = queued_events.load(std::memory_order_relaxed),
+    };
+    while (!queued_events.compare_exchange_weak(queued->next, queued)) {
     }
 
-    event.Set();
+    // Pairs with the check of Advance, either it takes this event or we see its wake up time.
+    if (time < next_wakeup_time.load()) {
+        event.Set();
+    }
 }
 
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  UnscheduleEventType type) {
-    {
-        std::scoped_lock lk{basic_lock};
-
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
-            }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
-        }
-
-        event_type->sequence_number++;
-    }
+    // The queued instances of the event are dropped once they are reached.
+    const u64 num_instances = CancelGeneration(*event_type);
+    num_pending_events.fetch_sub(static_cast<s64>(num_instances), std::memory_order_relaxed);
 
     // Force any in-progress events to finish
     if (type == UnscheduleEventType::Wait) {
@@ -198,64 +249,98 @@ u64 CoreTiming::GetGPUTicks() const {
 }
 
 std::optional<s64> CoreTiming::Advance() {
-    std::scoped_lock lock{advance_lock, basic_lock};
-    global_timer = GetGlobalTimeNs().count();
-
-    while (!event_queue.empty() && event_queue.top().time <= global_timer) {
-        const Event& evt = event_queue.top();
+    std::scoped_lock lock{advance_lock};
 
-        if (const auto event_type{evt.type.lock()}) {
-            const auto evt_time = evt.time;
-            const auto evt_sequence_num = event_type->sequence_number;
-
-            if (evt.reschedule_time == 0) {
-                event_queue.pop();
-
-                basic_lock.unlock();
-
-                event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time});
-
-                basic_lock.lock();
-            } else {
-                basic_lock.unlock();
+    // Events scheduled from now on are taken before returning, they need not wake anyone up.
+    next_wakeup_time = std::numeric_limits<s64>::min();
+    TakeQueuedEvents();
+    global_timer = GetGlobalTimeNs().count();
 
-                const auto new_schedule_time{event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
+    while (true) {
+        if (!event_queue.empty() && event_queue.front().IsStale()) {
+            std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>{});
+            event_queue.pop_back();
+            continue;
+        }
 
-                basic_lock.lock();
+        if (event_queue.empty() || event_queue.front().time > global_timer) {
+            next_wakeup_time = event_queue.empty() ? std::numeric_limits<s64>::max()
+                                                   : event_queue.front().time;
+            // Pairs with the check of QueueEvent, either we see its event or it wakes us up.
+            if (queued_events.load() == nullptr) {
+                break;
+            }
+            next_wakeup_time = std::numeric_limits<s64>::min();
+            TakeQueuedEvents();
+            continue;
+        }
 
-                if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
-                    continue;
-                }
+        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>{});
+        Event evt = std::move(event_queue.back());
+        event_queue.pop_back();
 
-                const auto next_schedule_time{new_schedule_time.has_value()
-                                                  ? new_schedule_time.value().count()
-                                                  : evt.reschedule_time};
+        const auto event_type{evt.type.lock()};
+        if (!event_type || evt.IsStale()) {
+            continue;
+        }
 
-                // If this event was scheduled into a pause, its time now is going to be way
-                // behind. Re-set this event to continue from the end of the pause.
-                auto next_time{evt.time + next_schedule_time};
-                if (evt.time < pause_end_time) {
-                    next_time = pause_end_time + next_schedule_time;
-                }
+        const auto new_schedule_time{event_type->callback(
+            evt.time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt.time})};
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
+        if (evt.reschedule_time == 0) {
+            if (CompleteInstance(*event_type, evt.generation)) {
+                num_pending_events.fetch_sub(1, std::memory_order_release);
+            }
+        } else if (!evt.IsStale()) {
+            const auto next_schedule_time{new_schedule_time.has_value()
+                                              ? new_schedule_time.value().count()
+                                              : evt.reschedule_time};
+
+            // If this event was scheduled into a pause, its time now is going to be way
+            // behind. Re-set this event to continue from the end of the pause.
+            auto next_time{evt.time + next_schedule_time};
+            if (evt.time < pause_end_time) {
+                next_time = pause_end_time + next_schedule_time;
             }
+
+            evt.time = next_time;
+            evt.fifo_order = event_fifo_id.fetch_add(1, std::memory_order_relaxed);
+            evt.reschedule_time = next_schedule_time;
+            event_queue.push_back(std::move(evt));
+            std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>{});
         }
 
+        TakeQueuedEvents();
         global_timer = GetGlobalTimeNs().count();
     }
 
     if (!event_queue.empty()) {
-        return event_queue.top().time;
+        return event_queue.front().time;
     } else {
         return std::nullopt;
     }
 }
 
+void CoreTiming::TakeQueuedEvents() {
+    QueuedEvent* queued = queued_events.exchange(nullptr, std::memory_order_acquire);
+    while (queued != nullptr) {
+        const std::unique_ptr<QueuedEvent> owned{queued};
+        queued = queued->next;
+
+        event_queue.push_back(std::move(owned->event));
+        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>{});
+    }
+
+    // Unscheduled events are only dropped once they are reached, rebuild the queue without them
+    // when they make most of it.
+    if (event_queue.size() >= MIN_COMPACTED_QUEUE_SIZE &&
+        static_cast<s64>(event_queue.size()) >
+            2 * num_pending_events.load(std::memory_order_relaxed)) {
+        std::erase_if(event_queue, [](const Event& evt) { return evt.IsStale(); });
+        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>{});
+    }
+}
+
 void CoreTiming::ThreadLoop() {
     has_started = true;
     while (!shutting_down) {
@@ -290,10 +375,8 @@ void CoreTiming::ThreadLoop() {
             } else {
                 // Queue is empty, wait until another event is scheduled and signals us to
                 // continue.
-                wait_set = true;
                 event.Wait();
             }
-            wait_set = false;
         }
 
         paused_set = true;
@@ -11,8 +11,7 @@
 #include <optional>
 #include <string>
 #include <thread>
-
-#include <boost/heap/fibonacci_heap.hpp>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/thread.h"
@@ -27,15 +26,16 @@ using TimedCallback = std::function<std::optional<std::chrono::nanoseconds>(
 /// Contains the characteristics of a particular event.
 struct EventType {
     explicit EventType(TimedCallback&& callback_, std::string&& name_)
-        : callback{std::move(callback_)}, name{std::move(name_)}, sequence_number{0} {}
+        : callback{std::move(callback_)}, name{std::move(name_)} {}
 
     /// The event's callback function.
     TimedCallback callback;
     /// A pointer to the name of the event.
     const std::string name;
-    /// A monotonic sequence number, incremented when this event is
-    /// changed externally.
-    size_t sequence_number;
+    /// Generation of the event in the upper 32 bits, incremented when it is unscheduled, and
+    /// number of scheduled instances of that generation in the lower 32 bits. Instances of an
+    /// older generation are dropped instead of run.
+    std::atomic<u64> schedule_state{};
 };
 
 enum class UnscheduleEventType {
@@ -54,6 +54,11 @@ enum class UnscheduleEventType {
  * So to schedule a new event on a regular basis:
  * inside callback:
  *   ScheduleEvent(period_in_ns - ns_late, callback, "whatever")
+ *
+ * Scheduling and unscheduling take no lock, so any thread can do it without contending with the
+ * others or with the timer thread. Scheduled events are pushed to a lock-free list which the
+ * thread advancing the timing moves into its own queue, and unscheduling bumps the generation of
+ * the event type, so its queued instances are dropped once they are reached.
  */
 class CoreTiming {
 public:
@@ -140,10 +145,16 @@ public:
 
 private:
     struct Event;
+    struct QueuedEvent;
 
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
+    void QueueEvent(s64 time, s64 reschedule_time, const std::shared_ptr<EventType>& event_type);
+
+    /// Moves the newly scheduled events to the event queue, must hold advance_lock.
+    void TakeQueuedEvents();
+
     void Reset();
 
     std::unique_ptr<Common::WallClock> clock;
@@ -154,20 +165,22 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
-
-    heap_t event_queue;
-    u64 event_fifo_id = 0;
+    /// Min-heap of the events by time, only accessed with advance_lock held.
+    std::vector<Event> event_queue;
+    /// Events scheduled since the last time the event queue was updated, newest first.
+    std::atomic<QueuedEvent*> queued_events{};
+    std::atomic<u64> event_fifo_id{};
+    /// Events scheduled and not yet run or unscheduled.
+    std::atomic<s64> num_pending_events{};
+    /// Time the timer thread wakes up at, events scheduled before it have to wake it up.
+    std::atomic<s64> next_wakeup_time{};
 
     Common::Event event{};
     Common::Event pause_event{};
-    mutable std::mutex basic_lock;
     std::mutex advance_lock;
     std::unique_ptr<std::jthread> timer_thread;
     std::atomic<bool> paused{};
     std::atomic<bool> paused_set{};
-    std::atomic<bool> wait_set{};
     std::atomic<bool> shutting_down{};
     std::atomic<bool> has_started{};
     std::function<void()> on_thread_init{};
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "core/crypto/aes_kernels_impl.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_AES
+#define HWCAP_AES (1 << 3)
+#endif
+#endif
+#endif
+
+namespace Core::Crypto {
+namespace {
+
+// clang-format off
+constexpr std::array<u8, 256> SBOX{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+// clang-format on
+
+constexpr u8 GaloisMultiply(u8 lhs, u8 rhs) {
+    u8 result = 0;
+    while (rhs != 0) {
+        if ((rhs & 1) != 0) {
+            result ^= lhs;
+        }
+        lhs = static_cast<u8>((lhs << 1) ^ ((lhs & 0x80) != 0 ? 0x1b : 0));
+        rhs >>= 1;
+    }
+    return result;
+}
+
+std::array<u8, AesBlockSize> InvMixColumns(const std::array<u8, AesBlockSize>& block) {
+    std::array<u8, AesBlockSize> result;
+    for (std::size_t column = 0; column < 4; ++column) {
+        const u8* const in = block.data() + column * 4;
+        u8* const out = result.data() + column * 4;
+        for (std::size_t row = 0; row < 4; ++row) {
+            out[row] = GaloisMultiply(in[row], 0x0e) ^ GaloisMultiply(in[(row + 1) % 4], 0x0b) ^
+                       GaloisMultiply(in[(row + 2) % 4], 0x0d) ^
+                       GaloisMultiply(in[(row + 3) % 4], 0x09);
+        }
+    }
+    return result;
+}
+
+const AesKernels* DetectAesKernels() {
+#if defined(ARCHITECTURE_x86_64)
+    if (Common::GetCPUCaps().aes) {
+        return &GetAesNiKernels();
+    }
+#elif defined(ARCHITECTURE_arm64)
+#if defined(__APPLE__)
+    // Every Apple CPU running AArch64 code implements the Cryptography Extension.
+    return &GetArmv8AesKernels();
+#elif defined(_WIN32)
+    if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE)) {
+        return &GetArmv8AesKernels();
+    }
+#elif defined(__linux__)
+    if ((getauxval(AT_HWCAP) & HWCAP_AES) != 0) {
+        return &GetArmv8AesKernels();
+    }
+#endif
+#endif
+    return nullptr;
+}
+
+} // Anonymous namespace
+
+void ExpandAesKey(AesRoundKeys& out, const u8* key, std::size_t key_size) {
+    ASSERT(key_size == 16 || key_size == 32);
+
+    const std::size_t key_words = key_size / 4;
+    const std::size_t num_words = (key_words + 7) * 4;
+    out.rounds = static_cast<u32>(key_words + 6);
+
+    std::array<std::array<u8, 4>, 60> words{};
+    std::memcpy(words.data(), key, key_size);
+    u8 round_constant = 1;
+    for (std::size_t i = key_words; i < num_words; ++i) {
+        std::array<u8, 4> word = words[i - 1];
+        if (i % key_words == 0) {
+            word = {static_cast<u8>(SBOX[word[1]] ^ round_constant), SBOX[word[2]], SBOX[word[3]],
+                    SBOX[word[0]]};
+            round_constant = GaloisMultiply(round_constant, 2);
+        } else if (key_words > 6 && i % key_words == 4) {
+            std::ranges::transform(word, word.begin(), [](u8 value) { return SBOX[value]; });
+        }
+        for (std::size_t byte = 0; byte < 4; ++byte) {
+            words[i][byte] = words[i - key_words][byte] ^ word[byte];
+        }
+    }
+    std::memcpy(out.encrypt.data(), words.data(), num_words * 4);
+
+    out.decrypt[0] = out.encrypt[out.rounds];
+    for (u32 round = 1; round < out.rounds; ++round) {
+        out.decrypt[round] = InvMixColumns(out.encrypt[out.rounds - round]);
+    }
+    out.decrypt[out.rounds] = out.encrypt[0];
+}
+
+const AesKernels* GetAesKernels() {
+    static const AesKernels* const kernels = [] {
+        const AesKernels* const detected = DetectAesKernels();
+        if (detected != nullptr) {
+            LOG_INFO(Crypto, "Using {} AES kernels", detected->name);
+        } else {
+            LOG_INFO(Crypto, "Host has no AES instructions, using mbedtls");
+        }
+        return detected;
+    }();
+    return kernels;
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+namespace Core::Crypto {
+
+constexpr std::size_t AesBlockSize = 16;
+
+/**
+ * Round keys of an AES key expanded for the AES instructions of the host. The decryption keys are
+ * laid out for the equivalent inverse cipher, as used by both AES-NI and the ARMv8 Cryptography
+ * Extension: in reverse order, with InvMixColumns applied to all but the first and last one.
+ */
+struct AesRoundKeys {
+    using Schedule = std::array<std::array<u8, AesBlockSize>, 15>;
+
+    Schedule encrypt;
+    Schedule decrypt;
+    u32 rounds;
+};
+
+/**
+ * Expands a 128 or 256-bit AES key.
+ * @param out      Round keys to fill
+ * @param key      Key to expand
+ * @param key_size Size of the key in bytes, 16 or 32
+ */
+void ExpandAesKey(AesRoundKeys& out, const u8* key, std::size_t key_size);
+
+/**
+ * Transforms data in CTR mode, encryption and decryption are the same operation.
+ * @param keys    Expanded key
+ * @param counter Big endian 128-bit counter of the first block, advanced past the blocks used
+ * @param src     Source data
+ * @param size    Size of the data in bytes, the last block may be partial
+ * @param dest    Destination of the data, may be the same as src
+ */
+using AesCtrFn = void (*)(const AesRoundKeys& keys, u8* counter, const u8* src, std::size_t size,
+                          u8* dest);
+
+/**
+ * Transforms a single XTS data unit.
+ * @param data_keys  Expanded key of the data, the first half of the XTS key
+ * @param tweak_keys Expanded key of the tweak, the second half of the XTS key
+ * @param iv         Data unit number, encrypted to form the initial tweak
+ * @param src        Source data
+ * @param size       Size of the data unit in bytes, a multiple of the AES block size
+ * @param dest       Destination of the data, may be the same as src
+ */
+using AesXtsFn = void (*)(const AesRoundKeys& data_keys, const AesRoundKeys& tweak_keys,
+                          const u8* iv, const u8* src, std::size_t size, u8* dest);
+
+struct AesKernels {
+    AesCtrFn ctr;
+    AesXtsFn xts_encrypt;
+    AesXtsFn xts_decrypt;
+    const char* name;
+};
+
+/// Returns the kernels using the AES instructions of the host CPU, detected on first use, or
+/// nullptr when the host has none
+const AesKernels* GetAesKernels();
+
+} // namespace Core::Crypto
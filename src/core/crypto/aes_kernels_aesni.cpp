@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#include "core/crypto/aes_kernels_impl.h"
+
+namespace Core::Crypto {
+namespace {
+
+struct AesNiOps {
+    using Block = __m128i;
+
+    struct Keys {
+        __m128i round_keys[15];
+        u32 rounds;
+    };
+
+    static Keys LoadKeys(const AesRoundKeys::Schedule& schedule, u32 rounds) {
+        Keys keys;
+        for (u32 round = 0; round <= rounds; ++round) {
+            keys.round_keys[round] = Load(schedule[round].data());
+        }
+        keys.rounds = rounds;
+        return keys;
+    }
+
+    static Block Load(const u8* src) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+
+    static void Store(u8* dest, Block block) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), block);
+    }
+
+    static Block Xor(Block lhs, Block rhs) {
+        return _mm_xor_si128(lhs, rhs);
+    }
+
+    static Block Make(u64 low, u64 high) {
+        return _mm_set_epi64x(static_cast<s64>(high), static_cast<s64>(low));
+    }
+
+    template <std::size_t N>
+    AES_FORCE_INLINE static void Encrypt(const Keys& keys, Block (&blocks)[N]) {
+        ForEachBlock<N>([&](std::size_t i) {
+            blocks[i] = _mm_xor_si128(blocks[i], keys.round_keys[0]);
+        });
+        for (u32 round = 1; round < keys.rounds; ++round) {
+            ForEachBlock<N>([&](std::size_t i) {
+                blocks[i] = _mm_aesenc_si128(blocks[i], keys.round_keys[round]);
+            });
+        }
+        ForEachBlock<N>([&](std::size_t i) {
+            blocks[i] = _mm_aesenclast_si128(blocks[i], keys.round_keys[keys.rounds]);
+        });
+    }
+
+    template <std::size_t N>
+    AES_FORCE_INLINE static void Decrypt(const Keys& keys, Block (&blocks)[N]) {
+        ForEachBlock<N>([&](std::size_t i) {
+            blocks[i] = _mm_xor_si128(blocks[i], keys.round_keys[0]);
+        });
+        for (u32 round = 1; round < keys.rounds; ++round) {
+            ForEachBlock<N>([&](std::size_t i) {
+                blocks[i] = _mm_aesdec_si128(blocks[i], keys.round_keys[round]);
+            });
+        }
+        ForEachBlock<N>([&](std::size_t i) {
+            blocks[i] = _mm_aesdeclast_si128(blocks[i], keys.round_keys[keys.rounds]);
+        });
+    }
+};
+
+constexpr AesKernels AES_NI_KERNELS = MakeAesKernels<AesNiOps>("AES-NI");
+
+} // Anonymous namespace
+
+const AesKernels& GetAesNiKernels() {
+    return AES_NI_KERNELS;
+}
+
+} // namespace Core::Crypto
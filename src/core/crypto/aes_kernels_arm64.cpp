@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <arm_neon.h>
+
+#include "core/crypto/aes_kernels_impl.h"
+
+namespace Core::Crypto {
+namespace {
+
+struct Armv8AesOps {
+    using Block = uint8x16_t;
+
+    struct Keys {
+        uint8x16_t round_keys[15];
+        u32 rounds;
+    };
+
+    static Keys LoadKeys(const AesRoundKeys::Schedule& schedule, u32 rounds) {
+        Keys keys;
+        for (u32 round = 0; round <= rounds; ++round) {
+            keys.round_keys[round] = Load(schedule[round].data());
+        }
+        keys.rounds = rounds;
+        return keys;
+    }
+
+    static Block Load(const u8* src) {
+        return vld1q_u8(src);
+    }
+
+    static void Store(u8* dest, Block block) {
+        vst1q_u8(dest, block);
+    }
+
+    static Block Xor(Block lhs, Block rhs) {
+        return veorq_u8(lhs, rhs);
+    }
+
+    static Block Make(u64 low, u64 high) {
+        return vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(low), vcreate_u64(high)));
+    }
+
+    // AESE and AESD add the round key before substituting, so the last key is added on its own.
+    template <std::size_t N>
+    AES_FORCE_INLINE static void Encrypt(const Keys& keys, Block (&blocks)[N]) {
+        for (u32 round = 0; round < keys.rounds - 1; ++round) {
+            ForEachBlock<N>([&](std::size_t i) {
+                blocks[i] = vaesmcq_u8(vaeseq_u8(blocks[i], keys.round_keys[round]));
+            });
+        }
+        ForEachBlock<N>([&](std::size_t i) {
+            blocks[i] = veorq_u8(vaeseq_u8(blocks[i], keys.round_keys[keys.rounds - 1]),
+                                 keys.round_keys[keys.rounds]);
+        });
+    }
+
+    template <std::size_t N>
+    AES_FORCE_INLINE static void Decrypt(const Keys& keys, Block (&blocks)[N]) {
+        for (u32 round = 0; round < keys.rounds - 1; ++round) {
+            ForEachBlock<N>([&](std::size_t i) {
+                blocks[i] = vaesimcq_u8(vaesdq_u8(blocks[i], keys.round_keys[round]));
+            });
+        }
+        ForEachBlock<N>([&](std::size_t i) {
+            blocks[i] = veorq_u8(vaesdq_u8(blocks[i], keys.round_keys[keys.rounds - 1]),
+                                 keys.round_keys[keys.rounds]);
+        });
+    }
+};
+
+constexpr AesKernels ARMV8_AES_KERNELS = MakeAesKernels<Armv8AesOps>("ARMv8 AES");
+
+} // Anonymous namespace
+
+const AesKernels& GetArmv8AesKernels() {
+    return ARMV8_AES_KERNELS;
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "common/swap.h"
+#include "core/crypto/aes_kernels.h"
+
+#ifdef _MSC_VER
+#define AES_FORCE_INLINE __forceinline
+#else
+#define AES_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace Core::Crypto {
+
+/// Blocks transformed together, enough independent work to hide the latency of the AES rounds.
+constexpr std::size_t AesBlocksInFlight = 8;
+
+/// Calls func with every index below N, unrolled so the blocks in flight stay in registers.
+template <std::size_t N, typename Func>
+AES_FORCE_INLINE void ForEachBlock(Func&& func) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (func(I), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+/*
+ * The kernels are written once over an 'Ops' type providing the instructions of the host:
+ * - Block: a 128-bit vector
+ * - Keys LoadKeys(schedule, rounds): round keys loaded into vectors
+ * - Block Load(const u8*), void Store(u8*, Block), Block Xor(Block, Block)
+ * - Block Make(u64 low, u64 high): a vector from the little endian halves of its memory
+ * - void Encrypt(const Keys&, Block (&)[N]), void Decrypt(...): transform N blocks in place,
+ *   AES_FORCE_INLINE to keep the blocks in registers
+ */
+
+template <typename Ops>
+void CtrTranscode(const AesRoundKeys& keys, u8* counter, const u8* src, std::size_t size,
+                  u8* dest) {
+    using Block = typename Ops::Block;
+    const auto round_keys = Ops::LoadKeys(keys.encrypt, keys.rounds);
+
+    u64 counter_high;
+    u64 counter_low;
+    std::memcpy(&counter_high, counter, sizeof(u64));
+    std::memcpy(&counter_low, counter + sizeof(u64), sizeof(u64));
+    counter_high = Common::swap64(counter_high);
+    counter_low = Common::swap64(counter_low);
+
+    const auto next_counter = [&] {
+        const Block block = Ops::Make(Common::swap64(counter_high), Common::swap64(counter_low));
+        if (++counter_low == 0) {
+            ++counter_high;
+        }
+        return block;
+    };
+
+    std::size_t offset = 0;
+    Block blocks[AesBlocksInFlight];
+    for (; size - offset >= AesBlocksInFlight * AesBlockSize;
+         offset += AesBlocksInFlight * AesBlockSize) {
+        ForEachBlock<AesBlocksInFlight>([&](std::size_t i) { blocks[i] = next_counter(); });
+        Ops::Encrypt(round_keys, blocks);
+        ForEachBlock<AesBlocksInFlight>([&](std::size_t i) {
+            const std::size_t block_offset = offset + i * AesBlockSize;
+            Ops::Store(dest + block_offset, Ops::Xor(Ops::Load(src + block_offset), blocks[i]));
+        });
+    }
+    for (; offset < size; offset += AesBlockSize) {
+        Block block[1]{next_counter()};
+        Ops::Encrypt(round_keys, block);
+
+        // The last block may be partial, go through a full one.
+        std::array<u8, AesBlockSize> data{};
+        const std::size_t data_size = std::min(AesBlockSize, size - offset);
+        std::memcpy(data.data(), src + offset, data_size);
+        Ops::Store(data.data(), Ops::Xor(Ops::Load(data.data()), block[0]));
+        std::memcpy(dest + offset, data.data(), data_size);
+    }
+
+    counter_high = Common::swap64(counter_high);
+    counter_low = Common::swap64(counter_low);
+    std::memcpy(counter, &counter_high, sizeof(u64));
+    std::memcpy(counter + sizeof(u64), &counter_low, sizeof(u64));
+}
+
+template <typename Ops, bool DECRYPT, std::size_t NUM_BLOCKS>
+AES_FORCE_INLINE void XtsTranscodeBlocks(const typename Ops::Keys& round_keys, u64& tweak_low,
+                                         u64& tweak_high, const u8* src, u8* dest) {
+    using Block = typename Ops::Block;
+    Block tweaks[NUM_BLOCKS];
+    Block blocks[NUM_BLOCKS];
+    ForEachBlock<NUM_BLOCKS>([&](std::size_t i) {
+        tweaks[i] = Ops::Make(tweak_low, tweak_high);
+        blocks[i] = Ops::Xor(Ops::Load(src + i * AesBlockSize), tweaks[i]);
+
+        // Multiply the tweak by x in GF(2^128), little endian as in IEEE 1619.
+        const u64 carry = tweak_high >> 63;
+        tweak_high = (tweak_high << 1) | (tweak_low >> 63);
+        tweak_low = (tweak_low << 1) ^ (carry * 0x87);
+    });
+    if constexpr (DECRYPT) {
+        Ops::Decrypt(round_keys, blocks);
+    } else {
+        Ops::Encrypt(round_keys, blocks);
+    }
+    ForEachBlock<NUM_BLOCKS>([&](std::size_t i) {
+        Ops::Store(dest + i * AesBlockSize, Ops::Xor(blocks[i], tweaks[i]));
+    });
+}
+
+template <typename Ops, bool DECRYPT>
+void XtsTranscode(const AesRoundKeys& data_keys, const AesRoundKeys& tweak_keys, const u8* iv,
+                  const u8* src, std::size_t size, u8* dest) {
+    // The initial tweak is the data unit number encrypted with the second key.
+    typename Ops::Block tweak[1]{Ops::Load(iv)};
+    Ops::Encrypt(Ops::LoadKeys(tweak_keys.encrypt, tweak_keys.rounds), tweak);
+    std::array<u8, AesBlockSize> tweak_bytes;
+    Ops::Store(tweak_bytes.data(), tweak[0]);
+    u64 tweak_low;
+    u64 tweak_high;
+    std::memcpy(&tweak_low, tweak_bytes.data(), sizeof(u64));
+    std::memcpy(&tweak_high, tweak_bytes.data() + sizeof(u64), sizeof(u64));
+
+    const auto round_keys =
+        Ops::LoadKeys(DECRYPT ? data_keys.decrypt : data_keys.encrypt, data_keys.rounds);
+    std::size_t offset = 0;
+    for (; size - offset >= AesBlocksInFlight * AesBlockSize;
+         offset += AesBlocksInFlight * AesBlockSize) {
+        XtsTranscodeBlocks<Ops, DECRYPT, AesBlocksInFlight>(round_keys, tweak_low, tweak_high,
+                                                            src + offset, dest + offset);
+    }
+    for (; offset < size; offset += AesBlockSize) {
+        XtsTranscodeBlocks<Ops, DECRYPT, 1>(round_keys, tweak_low, tweak_high, src + offset,
+                                            dest + offset);
+    }
+}
+
+template <typename Ops>
+constexpr AesKernels MakeAesKernels(const char* name) {
+    return AesKernels{
+        .ctr = &CtrTranscode<Ops>,
+        .xts_encrypt = &XtsTranscode<Ops, false>,
+        .xts_decrypt = &XtsTranscode<Ops, true>,
+        .name = name,
+    };
+}
+
+#if defined(ARCHITECTURE_x86_64)
+/// Implemented in a translation unit built with AES-NI enabled, only call when the host has it.
+const AesKernels& GetAesNiKernels();
+#elif defined(ARCHITECTURE_arm64)
+/// Implemented in a translation unit built with the Cryptography Extension enabled, only call
+/// when the host has it.
+const AesKernels& GetArmv8AesKernels();
+#endif
+
+} // namespace Core::Crypto
@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_kernels.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -36,11 +39,34 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // Hardware path, used instead of mbedtls for CTR and XTS when the host supports it
+    const AesKernels* kernels;
+    Mode mode;
+    AesRoundKeys keys;
+    AesRoundKeys tweak_keys;
+    std::array<u8, AesBlockSize> iv;
 };
 
 template <typename Key, std::size_t KeySize>
 Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     : ctx(std::make_unique<CipherContext>()) {
+    // Only the AES-128 flavours of the modes exist, XTS splits its key into two.
+    ctx->mode = mode;
+    ctx->kernels = nullptr;
+    if (mode == Mode::CTR && KeySize == 0x10) {
+        ctx->kernels = GetAesKernels();
+        if (ctx->kernels != nullptr) {
+            ExpandAesKey(ctx->keys, key.data(), KeySize);
+        }
+    } else if (mode == Mode::XTS && KeySize == 0x20) {
+        ctx->kernels = GetAesKernels();
+        if (ctx->kernels != nullptr) {
+            ExpandAesKey(ctx->keys, key.data(), KeySize / 2);
+            ExpandAesKey(ctx->tweak_keys, key.data() + KeySize / 2, KeySize / 2);
+        }
+    }
+
     mbedtls_cipher_init(&ctx->encryption_context);
     mbedtls_cipher_init(&ctx->decryption_context);
 
@@ -67,6 +93,21 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->kernels != nullptr) {
+        if (ctx->mode == Mode::CTR) {
+            // Like mbedtls, the counter continues after the blocks used.
+            ctx->kernels->ctr(ctx->keys, ctx->iv.data(), src, size, dest);
+            return;
+        }
+        if (size >= AesBlockSize && size % AesBlockSize == 0) {
+            // Data units ending with a partial block use ciphertext stealing, left to mbedtls.
+            const auto xts = op == Op::Encrypt ? ctx->kernels->xts_encrypt
+                                               : ctx->kernels->xts_decrypt;
+            xts(ctx->keys, ctx->tweak_keys, ctx->iv.data(), src, size, dest);
+            return;
+        }
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -78,6 +119,13 @@ void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* des
             LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
                         size, written);
         }
+    } else if (mbedtls_cipher_get_cipher_mode(context) == MBEDTLS_MODE_CTR && size != 0) {
+        // Counter mode takes any length at once, a partial last block ends the stream.
+        mbedtls_cipher_update(context, src, size, dest, &written);
+        if (written != size) {
+            LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
+                        size, written);
+        }
     } else {
         const auto block_size = mbedtls_cipher_get_block_size(context);
         if (size < block_size) {
@@ -119,6 +167,9 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+    ctx->iv = {};
+    std::memcpy(ctx->iv.data(), data.data(), std::min(data.size(), ctx->iv.size()));
+
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
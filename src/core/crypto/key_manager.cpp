@@ -639,6 +639,8 @@ KeyManager::KeyManager() {
 }
 
 void KeyManager::ReloadKeys() {
+    std::scoped_lock lk{mutex};
+
     // Initialize keys
     const auto yuzu_keys_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::KeysDir);
 
@@ -808,14 +810,17 @@ bool KeyManager::BaseDeriveNecessary() const {
 }
 
 bool KeyManager::HasKey(S128KeyType id, u64 field1, u64 field2) const {
+    std::scoped_lock lk{mutex};
     return s128_keys.find({id, field1, field2}) != s128_keys.end();
 }
 
 bool KeyManager::HasKey(S256KeyType id, u64 field1, u64 field2) const {
+    std::scoped_lock lk{mutex};
     return s256_keys.find({id, field1, field2}) != s256_keys.end();
 }
 
 Key128 KeyManager::GetKey(S128KeyType id, u64 field1, u64 field2) const {
+    std::scoped_lock lk{mutex};
     if (!HasKey(id, field1, field2)) {
         return {};
     }
@@ -823,6 +828,7 @@ Key128 KeyManager::GetKey(S128KeyType id, u64 field1, u64 field2) const {
 }
 
 Key256 KeyManager::GetKey(S256KeyType id, u64 field1, u64 field2) const {
+    std::scoped_lock lk{mutex};
     if (!HasKey(id, field1, field2)) {
         return {};
     }
@@ -830,6 +836,7 @@ Key256 KeyManager::GetKey(S256KeyType id, u64 field1, u64 field2) const {
 }
 
 Key256 KeyManager::GetBISKey(u8 partition_id) const {
+    std::scoped_lock lk{mutex};
     Key256 out{};
 
     for (const auto& bis_type : {BISKeyType::Crypto, BISKeyType::Tweak}) {
@@ -879,6 +886,7 @@ void KeyManager::WriteKeyToFile(KeyCategory category, std::string_view keyname,
 }
 
 void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
+    std::scoped_lock lk{mutex};
     if (s128_keys.find({id, field1, field2}) != s128_keys.end() || key == Key128{}) {
         return;
     }
@@ -932,6 +940,7 @@ void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
 }
 
 void KeyManager::SetKey(S256KeyType id, Key256 key, u64 field1, u64 field2) {
+    std::scoped_lock lk{mutex};
     if (s256_keys.find({id, field1, field2}) != s256_keys.end() || key == Key256{}) {
         return;
     }
@@ -1339,11 +1348,13 @@ void KeyManager::PopulateFromPartitionData(PartitionDataManager& data) {
     DeriveBase();
 }
 
-const std::map<u128, Ticket>& KeyManager::GetCommonTickets() const {
+std::map<u128, Ticket> KeyManager::GetCommonTickets() const {
+    std::scoped_lock lk{mutex};
     return common_tickets;
 }
 
-const std::map<u128, Ticket>& KeyManager::GetPersonalizedTickets() const {
+std::map<u128, Ticket> KeyManager::GetPersonalizedTickets() const {
+    std::scoped_lock lk{mutex};
     return personal_tickets;
 }
 
@@ -1353,6 +1364,8 @@ bool KeyManager::AddTicket(const Ticket& ticket) {
         return false;
     }
 
+    std::scoped_lock lk{mutex};
+
     const auto& rid = ticket.GetData().rights_id;
     u128 rights_id;
     std::memcpy(rights_id.data(), rid.data(), rid.size());
@@ -3,14 +3,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bit>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
 
+#include "common/alignment.h"
 #include "common/common_types.h"
+#include "common/div_ceil.h"
 #include "common/range_mutex.h"
 #include "common/scratch_buffer.h"
 #include "common/virtual_buffer.h"
@@ -34,6 +41,119 @@ struct Asid {
     size_t id;
 };
 
+/// Ranges of a batch which share or touch device pages, updated under a single lock
+struct CachedRangeGroup {
+    DAddr lock_begin; ///< Start of the first page of the group
+    DAddr lock_end;   ///< End of the last page of the group
+    size_t first;     ///< Index of the first range of the group
+    size_t last;      ///< Index past the last range of the group
+};
+
+/**
+ * Splits sorted ranges into the groups locked and walked together. Overlapping ranges are not
+ * merged, each of them applies its delta to the pages they share.
+ */
+template <typename Func>
+void ForEachCachedRangeGroup(std::span<const std::pair<DAddr, size_t>> ranges, Func&& func) {
+    size_t first = 0;
+    while (first < ranges.size()) {
+        const DAddr lock_begin = Common::AlignDown(ranges[first].first, DEVICE_PAGESIZE);
+        DAddr lock_end = ranges[first].first + ranges[first].second;
+        size_t last = first + 1;
+        while (last < ranges.size() &&
+               ranges[last].first <= Common::AlignUp(lock_end, DEVICE_PAGESIZE)) {
+            lock_end = std::max<DAddr>(lock_end, ranges[last].first + ranges[last].second);
+            ++last;
+        }
+        func(CachedRangeGroup{
+            .lock_begin = lock_begin,
+            .lock_end = Common::AlignUp(lock_end, DEVICE_PAGESIZE),
+            .first = first,
+            .last = last,
+        });
+        first = last;
+    }
+}
+
+/**
+ * Applies delta, either -1 or 1, to the cached counters of the pages of sorted ranges, and
+ * reports the runs of CPU pages whose counter reached or left zero. Runs continue from one range
+ * to the next when their CPU pages follow each other in the same process.
+ * @param get_counter Returns the atomic counter of a device page
+ * @param get_backing Returns the process and CPU address backing a device page, 0 if unmapped
+ * @param mark        Called with the process, CPU address and size of each run, and whether its
+ *                    pages became cached
+ */
+template <typename GetCounter, typename GetBacking, typename Mark>
+void UpdateCachedPageCounters(std::span<const std::pair<DAddr, size_t>> ranges, s32 delta,
+                              GetCounter&& get_counter, GetBacking&& get_backing, Mark&& mark) {
+    u64 uncache_begin = 0;
+    u64 cache_begin = 0;
+    u64 uncache_bytes = 0;
+    u64 cache_bytes = 0;
+
+    auto [asid, base_vaddress] = get_backing(ranges.front().first >> DEVICE_PAGEBITS);
+    const auto release_pending = [&] {
+        if (uncache_bytes > 0) {
+            mark(asid, uncache_begin << DEVICE_PAGEBITS, uncache_bytes, false);
+            uncache_bytes = 0;
+        }
+        if (cache_bytes > 0) {
+            mark(asid, cache_begin << DEVICE_PAGEBITS, cache_bytes, true);
+            cache_bytes = 0;
+        }
+    };
+    size_t old_vpage = (base_vaddress >> DEVICE_PAGEBITS) - 1;
+    for (const auto& [addr, size] : ranges) {
+        const size_t page_end = Common::DivCeil(addr + size, DEVICE_PAGESIZE);
+        for (size_t page = addr >> DEVICE_PAGEBITS; page != page_end; ++page) {
+            auto& count = get_counter(page);
+            using CounterType = typename std::remove_reference_t<decltype(count)>::value_type;
+            auto [asid_2, vpage] = get_backing(page);
+            vpage >>= DEVICE_PAGEBITS;
+
+            if (vpage == 0) [[unlikely]] {
+                release_pending();
+                continue;
+            }
+
+            if (asid.id != asid_2.id) [[unlikely]] {
+                release_pending();
+                asid = asid_2;
+            }
+
+            if (vpage != old_vpage + 1) [[unlikely]] {
+                release_pending();
+            }
+
+            old_vpage = vpage;
+
+            // Adds or subtracts 1, as count is a unsigned 8-bit value
+            count.fetch_add(static_cast<CounterType>(delta), std::memory_order_release);
+
+            if (count.load(std::memory_order::relaxed) == 0) {
+                if (uncache_bytes == 0) {
+                    uncache_begin = vpage;
+                }
+                uncache_bytes += DEVICE_PAGESIZE;
+            } else if (uncache_bytes > 0) {
+                mark(asid, uncache_begin << DEVICE_PAGEBITS, uncache_bytes, false);
+                uncache_bytes = 0;
+            }
+            if (count.load(std::memory_order::relaxed) == 1 && delta > 0) {
+                if (cache_bytes == 0) {
+                    cache_begin = vpage;
+                }
+                cache_bytes += DEVICE_PAGESIZE;
+            } else if (cache_bytes > 0) {
+                mark(asid, cache_begin << DEVICE_PAGEBITS, cache_bytes, true);
+                cache_bytes = 0;
+            }
+        }
+    }
+    release_pending();
+}
+
 template <typename Traits>
 class DeviceMemoryManager {
     using DeviceInterface = typename Traits::DeviceInterface;
@@ -47,6 +167,13 @@ public:
 
     void BindInterface(DeviceInterface* device_inter);
 
+    /// Called with the device address ranges read or cached by the GPU
+    using AccessObserver = std::function<void(DAddr address, size_t size)>;
+
+    /// Sets the observer of the accesses, used by GPU captures. Must be set before the GPU
+    /// starts processing commands.
+    void SetAccessObserver(AccessObserver&& observer);
+
     DAddr Allocate(size_t size);
     void AllocateFixed(DAddr start, size_t size);
     void Free(DAddr start, size_t size);
@@ -117,6 +244,13 @@ public:
 
     void UpdatePagesCachedCount(DAddr addr, size_t size, s32 delta);
 
+    /**
+     * Updates the cached counters of many ranges at once. Ranges touching the same pages are
+     * locked together and their caching runs are merged, so a registration split in many
+     * adjacent ranges marks the memory with as few calls as a single range would.
+     */
+    void UpdatePagesCachedBatch(std::span<const std::pair<DAddr, size_t>> ranges, s32 delta);
+
     static constexpr size_t AS_BITS = Traits::device_virtual_bits;
 
 private:
@@ -156,6 +290,7 @@ private:
 
     const uintptr_t physical_base;
     DeviceInterface* device_inter;
+    AccessObserver access_observer;
     Common::VirtualBuffer<u32> compressed_physical_ptr;
     Common::VirtualBuffer<u32> compressed_device_addr;
     Common::VirtualBuffer<u32> continuity_tracker;
@@ -179,6 +314,10 @@ private:
         return std::make_pair(asid, address);
     }
 
+    /// Updates the cached counters of sorted ranges, counter_guard must cover all of them.
+    void UpdatePagesCachedCountLocked(std::span<const std::pair<DAddr, size_t>> ranges,
+                                      s32 delta);
+
     void InsertCPUBacking(size_t page_index, VAddr address, Asid asid) {
         cpu_backing_address[page_index] = address | (asid.id << asid_start_bit);
     }
@@ -0,0 +1,346 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/settings.h"
+#include "common/thread.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+
+namespace FileSys {
+
+struct BlockCacheStorage::Source {
+    VirtualFile storage;
+    std::mutex mutex;
+    u32 id;
+    // Bumped under the mutex when the cached blocks are invalidated.
+    u32 generation;
+};
+
+namespace {
+
+constexpr size_t NumShards = 16;
+constexpr size_t MaxQueuedReadAheads = 64;
+
+using Block = std::vector<u8>;
+
+constexpr u64 MakeKey(u32 id, size_t block_index) {
+    return (u64{id} << 32) | static_cast<u32>(block_index);
+}
+
+class BlockCache {
+public:
+    static BlockCache& GetInstance() {
+        static BlockCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const Block> Find(u64 key) {
+        auto& shard = GetShard(key);
+        std::scoped_lock lk{shard.mutex};
+
+        const auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return nullptr;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return it->second->block;
+    }
+
+    bool Contains(u64 key) {
+        auto& shard = GetShard(key);
+        std::scoped_lock lk{shard.mutex};
+        return shard.entries.contains(key);
+    }
+
+    void Insert(u64 key, std::shared_ptr<const Block> block) {
+        const size_t capacity =
+            static_cast<size_t>(Settings::values.fs_block_cache_size.GetValue()) * 1_MiB /
+            NumShards;
+
+        auto& shard = GetShard(key);
+        std::scoped_lock lk{shard.mutex};
+
+        shard.size += block->size();
+        if (const auto it = shard.entries.find(key); it != shard.entries.end()) {
+            shard.size -= it->second->block->size();
+            it->second->block = std::move(block);
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        } else {
+            shard.lru.push_front(Entry{key, std::move(block)});
+            shard.entries.emplace(key, shard.lru.begin());
+        }
+
+        // Evict the least recently used blocks until the shard fits.
+        while (shard.size > capacity && !shard.lru.empty()) {
+            const auto& victim = shard.lru.back();
+            shard.size -= victim.block->size();
+            shard.entries.erase(victim.key);
+            shard.lru.pop_back();
+            ++evictions;
+        }
+    }
+
+    void Invalidate(u32 id) {
+        for (auto& shard : shards) {
+            std::scoped_lock lk{shard.mutex};
+            for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+                if (static_cast<u32>(it->key >> 32) != id) {
+                    ++it;
+                    continue;
+                }
+                shard.size -= it->block->size();
+                shard.entries.erase(it->key);
+                it = shard.lru.erase(it);
+            }
+        }
+    }
+
+    void QueueReadAhead(std::shared_ptr<BlockCacheStorage::Source> source, size_t block_index,
+                        size_t block_size) {
+        {
+            std::scoped_lock lk{queue_mutex};
+            // Requests past the limit are dropped, the reader is already too far ahead.
+            if (requests.size() >= MaxQueuedReadAheads) {
+                return;
+            }
+            const u32 generation = source->generation;
+            requests.push_back(
+                ReadAheadRequest{std::move(source), block_index, block_size, generation});
+        }
+        queue_cv.notify_one();
+    }
+
+    BlockCacheStatistics GetStatistics() {
+        BlockCacheStatistics statistics{
+            .hits = hits,
+            .misses = misses,
+            .read_ahead_blocks = read_ahead_blocks,
+            .evictions = evictions,
+            .cached_size = 0,
+        };
+        for (auto& shard : shards) {
+            std::scoped_lock lk{shard.mutex};
+            statistics.cached_size += shard.size;
+        }
+        return statistics;
+    }
+
+    std::atomic<u64> hits{};
+    std::atomic<u64> misses{};
+    std::atomic<u64> read_ahead_blocks{};
+    std::atomic<u64> evictions{};
+
+private:
+    struct Entry {
+        u64 key;
+        std::shared_ptr<const Block> block;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru;
+        std::unordered_map<u64, std::list<Entry>::iterator> entries;
+        size_t size{};
+    };
+
+    struct ReadAheadRequest {
+        std::shared_ptr<BlockCacheStorage::Source> source;
+        size_t block_index;
+        size_t block_size;
+        u32 generation;
+    };
+
+    BlockCache() : worker{[this](std::stop_token stop_token) { WorkerLoop(stop_token); }} {}
+
+    Shard& GetShard(u64 key) {
+        // Neighbouring blocks land on different shards.
+        return shards[(key * 0x9E3779B97F4A7C15ULL) >> 60];
+    }
+
+    void WorkerLoop(std::stop_token stop_token) {
+        Common::SetCurrentThreadName("FsReadAhead");
+        Common::SetCurrentThreadPriority(Common::ThreadPriority::Low);
+
+        while (!stop_token.stop_requested()) {
+            ReadAheadRequest request;
+            {
+                std::unique_lock lk{queue_mutex};
+                queue_cv.wait(lk, stop_token, [this] { return !requests.empty(); });
+                if (requests.empty()) {
+                    continue;
+                }
+                request = std::move(requests.front());
+                requests.pop_front();
+            }
+
+            const u64 key = MakeKey(request.source->id, request.block_index);
+            if (Contains(key)) {
+                continue;
+            }
+
+            auto block = std::make_shared<Block>(request.block_size);
+            {
+                // Insert under the source lock, so an invalidation either drops this block or
+                // runs after the insert and removes it.
+                std::scoped_lock lk{request.source->mutex};
+                if (request.source->generation != request.generation) {
+                    continue;
+                }
+                const size_t read_size = request.source->storage->Read(
+                    block->data(), block->size(),
+                    request.block_index * BlockCacheStorage::BlockSize);
+                if (read_size != request.block_size) {
+                    continue;
+                }
+                Insert(key, std::move(block));
+            }
+            ++read_ahead_blocks;
+        }
+    }
+
+    std::array<Shard, NumShards> shards;
+
+    std::mutex queue_mutex;
+    std::condition_variable_any queue_cv;
+    std::deque<ReadAheadRequest> requests;
+
+    // Declared last to stop before the state it uses is destroyed.
+    std::jthread worker;
+};
+
+std::atomic<u32> next_storage_id{};
+
+} // namespace
+
+BlockCacheStatistics GetBlockCacheStatistics() {
+    return BlockCache::GetInstance().GetStatistics();
+}
+
+BlockCacheStorage::BlockCacheStorage(VirtualFile base_storage)
+    : m_source(std::make_shared<Source>()), m_size(base_storage->GetSize()),
+      m_next_sequential_offset(0), m_read_ahead_end_block(0) {
+    m_source->storage = std::move(base_storage);
+    m_source->id = next_storage_id++;
+    m_source->generation = 0;
+}
+
+BlockCacheStorage::~BlockCacheStorage() {
+    // Queued read-aheads of the previous generation are dropped instead of inserted.
+    {
+        std::scoped_lock lk{m_source->mutex};
+        ++m_source->generation;
+    }
+    BlockCache::GetInstance().Invalidate(m_source->id);
+}
+
+bool BlockCacheStorage::IsEnabled() {
+    return Settings::values.fs_block_cache_size.GetValue() != 0;
+}
+
+size_t BlockCacheStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    // Clamp the read to the storage.
+    if (offset >= m_size) {
+        return 0;
+    }
+    size = std::min(size, m_size - offset);
+    if (size == 0) {
+        return 0;
+    }
+
+    auto& cache = BlockCache::GetInstance();
+    const size_t end_offset = offset + size;
+    const size_t last_block = (end_offset - 1) / BlockSize;
+
+    // Copies the part of a block overlapping the read into the buffer.
+    size_t processed = 0;
+    const auto copy_block = [&](const u8* data, size_t block_offset, size_t block_size) {
+        const size_t copy_start = std::max(offset, block_offset);
+        const size_t copy_end = std::min(end_offset, block_offset + block_size);
+        if (copy_start < copy_end) {
+            std::memcpy(buffer + (copy_start - offset), data + (copy_start - block_offset),
+                        copy_end - copy_start);
+            processed += copy_end - copy_start;
+        }
+    };
+
+    size_t block_index = offset / BlockSize;
+    while (block_index <= last_block) {
+        if (const auto block = cache.Find(MakeKey(m_source->id, block_index))) {
+            ++cache.hits;
+            copy_block(block->data(), block_index * BlockSize, block->size());
+            ++block_index;
+            continue;
+        }
+
+        // Read the whole run of missing blocks at once.
+        size_t run_end = block_index + 1;
+        while (run_end <= last_block && !cache.Contains(MakeKey(m_source->id, run_end))) {
+            ++run_end;
+        }
+        cache.misses += run_end - block_index;
+
+        const size_t run_offset = block_index * BlockSize;
+        const size_t run_size = std::min(run_end * BlockSize, m_size) - run_offset;
+        std::vector<u8> data(run_size);
+        size_t read_size;
+        {
+            std::scoped_lock lk{m_source->mutex};
+            read_size = m_source->storage->Read(data.data(), run_size, run_offset);
+        }
+        if (read_size != run_size) {
+            // Do not cache a failed read.
+            copy_block(data.data(), run_offset, read_size);
+            return processed;
+        }
+
+        for (; block_index < run_end; ++block_index) {
+            const size_t block_offset = block_index * BlockSize - run_offset;
+            const size_t block_size = std::min(BlockSize, run_size - block_offset);
+            auto block = std::make_shared<Block>(data.begin() + block_offset,
+                                                 data.begin() + block_offset + block_size);
+            copy_block(block->data(), block_index * BlockSize, block_size);
+            cache.Insert(MakeKey(m_source->id, block_index), std::move(block));
+        }
+    }
+
+    // Read ahead when this read continues the previous one.
+    if (m_next_sequential_offset.exchange(end_offset) == offset) {
+        this->ReadAhead(last_block + 1);
+    }
+
+    return processed;
+}
+
+void BlockCacheStorage::ReadAhead(size_t block_index) const {
+    const size_t num_blocks = Common::DivideUp(m_size, BlockSize);
+    const size_t end_block = std::min(block_index + ReadAheadBlockCount, num_blocks);
+
+    // Skip the blocks requested by the previous reads, unless the reader moved elsewhere.
+    size_t start_block = m_read_ahead_end_block.load();
+    if (start_block < block_index || start_block > end_block) {
+        start_block = block_index;
+    }
+    if (start_block >= end_block) {
+        return;
+    }
+    m_read_ahead_end_block = end_block;
+
+    auto& cache = BlockCache::GetInstance();
+    for (size_t index = start_block; index < end_block; ++index) {
+        cache.QueueReadAhead(m_source, index, std::min(BlockSize, m_size - index * BlockSize));
+    }
+}
+
+} // namespace FileSys
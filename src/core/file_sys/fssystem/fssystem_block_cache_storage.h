@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "common/literals.h"
+
+#include "core/file_sys/fssystem/fs_i_storage.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+struct BlockCacheStatistics {
+    u64 hits;
+    u64 misses;
+    u64 read_ahead_blocks;
+    u64 evictions;
+    u64 cached_size;
+};
+
+// Returns the counters of the block cache shared by every BlockCacheStorage.
+BlockCacheStatistics GetBlockCacheStatistics();
+
+// Caches the plaintext of a storage in blocks, in a size-bounded LRU cache shared by every
+// storage and sharded to keep concurrent readers apart. Sequential reads queue the following
+// blocks to be read ahead on a worker thread. Accesses to the base storage are serialized, the
+// decryption layers below it are not safe to use from several threads. The size of the cache is
+// read from the fs_block_cache_size setting, in MiB.
+class BlockCacheStorage : public IReadOnlyStorage {
+    YUZU_NON_COPYABLE(BlockCacheStorage);
+    YUZU_NON_MOVEABLE(BlockCacheStorage);
+
+public:
+    static constexpr size_t BlockSize = 64_KiB;
+    static constexpr size_t ReadAheadBlockCount = 8;
+
+public:
+    explicit BlockCacheStorage(VirtualFile base_storage);
+    ~BlockCacheStorage() override;
+
+    // Returns whether the cache is enabled by the settings.
+    static bool IsEnabled();
+
+    virtual size_t GetSize() const override {
+        return m_size;
+    }
+
+    virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
+
+public:
+    // The base storage, shared with the read-ahead requests which may outlive this storage.
+    struct Source;
+
+private:
+    void ReadAhead(size_t block_index) const;
+
+private:
+    std::shared_ptr<Source> m_source;
+    size_t m_size;
+    mutable std::atomic<size_t> m_next_sequential_offset;
+    mutable std::atomic<size_t> m_read_ahead_end_block;
+};
+
+} // namespace FileSys
@@ -5,6 +5,7 @@
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
 #include "core/file_sys/fssystem/fssystem_alignment_matching_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
 #include "core/file_sys/fssystem/fssystem_compressed_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_integrity_verification_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
@@ -320,6 +321,14 @@ Result NcaFileSystemDriver::CreateStorageByRawStorage(VirtualFile* out,
             std::move(storage), header_reader->GetCompressionInfo()));
     }
 
+    // Cache the plaintext, so repeated reads skip decryption, verification and decompression.
+    if (BlockCacheStorage::IsEnabled()) {
+        auto cache_storage = std::make_shared<BlockCacheStorage>(std::move(storage));
+        R_UNLESS(cache_storage != nullptr, ResultAllocationMemoryFailedAllocateShared);
+
+        storage = std::move(cache_storage);
+    }
+
     // Set output storage.
     *out = std::move(storage);
     R_SUCCEED();
@@ -2,14 +2,25 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <random>
 #include <regex>
+#include <span>
+#include <thread>
 #include <mbedtls/sha256.h>
 #include "common/assert.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "common/fs/path_util.h"
 #include "common/hex_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/common_funcs.h"
@@ -563,9 +574,9 @@ InstallResult RegisteredCache::InstallEntry(const XCI& xci, bool overwrite_if_ex
     return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, copy);
 }
 
-InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
-                                            const VfsCopyFunction& copy) {
-    const auto ncas = nsp.GetNCAsCollapsed();
+// Finds the meta NCA of an NSP and the CNMT inside of it.
+static InstallResult GetInstallMeta(const std::vector<std::shared_ptr<NCA>>& ncas,
+                                    std::shared_ptr<NCA>& out_meta, VirtualFile& out_cnmt) {
     const auto meta_iter = std::find_if(ncas.begin(), ncas.end(), [](const auto& nca) {
         return nca->GetType() == NCAContentType::Meta;
     });
@@ -576,9 +587,6 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         return InstallResult::ErrorMetaFailed;
     }
 
-    const auto meta_id_raw = (*meta_iter)->GetName().substr(0, 32);
-    const auto meta_id_data = Common::HexStringToArray<16>(meta_id_raw);
-
     if ((*meta_iter)->GetSubdirectories().empty()) {
         LOG_ERROR(Loader,
                   "The file you are attempting to install does not contain a section0 within the "
@@ -595,7 +603,24 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         return InstallResult::ErrorMetaFailed;
     }
 
-    const auto cnmt_file = section0->GetFiles()[0];
+    out_meta = *meta_iter;
+    out_cnmt = section0->GetFiles()[0];
+    return InstallResult::Success;
+}
+
+InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
+                                            const VfsCopyFunction& copy) {
+    const auto ncas = nsp.GetNCAsCollapsed();
+    std::shared_ptr<NCA> meta_nca;
+    VirtualFile cnmt_file;
+    if (const auto meta_status = GetInstallMeta(ncas, meta_nca, cnmt_file);
+        meta_status != InstallResult::Success) {
+        return meta_status;
+    }
+
+    const auto meta_id_raw = meta_nca->GetName().substr(0, 32);
+    const auto meta_id_data = Common::HexStringToArray<16>(meta_id_raw);
+
     const CNMT cnmt(cnmt_file);
 
     const auto title_id = cnmt.GetTitleID();
@@ -608,7 +633,7 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
     const auto result = RemoveExistingEntry(title_id);
 
     // Install Metadata File
-    const auto meta_result = RawInstallNCA(**meta_iter, copy, overwrite_if_exists, meta_id_data);
+    const auto meta_result = RawInstallNCA(*meta_nca, copy, overwrite_if_exists, meta_id_data);
     if (meta_result != InstallResult::Success) {
         return meta_result;
     }
@@ -646,6 +671,292 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
     return InstallResult::Success;
 }
 
+namespace {
+
+using namespace Common::Literals;
+
+// Chunks moving through the install pipeline, each NCA has a few of them in flight.
+constexpr size_t INSTALL_CHUNK_SIZE = VFS_RC_LARGE_COPY_BLOCK;
+constexpr size_t INSTALL_CHUNKS_PER_NCA = 4;
+
+// State shared by the NCAs of an installation, the first error stops every one of them.
+struct InstallState {
+    void Fail(InstallResult error) {
+        std::scoped_lock lk{mutex};
+        if (result == InstallResult::Success) {
+            result = error;
+        }
+        failed = true;
+    }
+
+    std::atomic<u64> processed_size{};
+    std::atomic<bool> failed{};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t jobs_done{};
+    InstallResult result{InstallResult::Success};
+};
+
+struct InstallChunk {
+    std::vector<u8> data; ///< Empty data ends the stream
+    size_t offset{};
+};
+
+// Room for every chunk and the end of the stream.
+using InstallChunkQueue =
+    Common::SPSCQueue<InstallChunk, std::bit_ceil(INSTALL_CHUNKS_PER_NCA + 1)>;
+
+// Copies an NCA, reading on this thread while a hasher and a writer thread process the previous
+// chunks. Chunks go back to the reader once written, bounding the memory used per NCA.
+void RunInstallJob(const InstallJob& job, InstallState& state) {
+    const size_t size = job.source->GetSize();
+    if (!job.dest->Resize(size)) {
+        LOG_ERROR(Loader, "Failed to allocate {} bytes for {}", size, job.dest->GetName());
+        state.Fail(InstallResult::ErrorCopyFailed);
+        return;
+    }
+
+    InstallChunkQueue to_hasher;
+    InstallChunkQueue to_writer;
+    InstallChunkQueue written;
+    bool read_complete = false;
+
+    std::jthread hasher([&] {
+        Common::SetCurrentThreadName("NcaInstallHash");
+        mbedtls_sha256_context context;
+        mbedtls_sha256_init(&context);
+        mbedtls_sha256_starts_ret(&context, 0);
+        SCOPE_EXIT {
+            mbedtls_sha256_free(&context);
+        };
+
+        InstallChunk chunk;
+        bool end = false;
+        while (!end) {
+            to_hasher.PopWait(chunk);
+            end = chunk.data.empty();
+            if (job.expected_hash) {
+                mbedtls_sha256_update_ret(&context, chunk.data.data(), chunk.data.size());
+            }
+            to_writer.EmplaceWait(std::move(chunk));
+        }
+
+        if (!job.expected_hash || !read_complete) {
+            return;
+        }
+        Core::Crypto::SHA256Hash hash;
+        mbedtls_sha256_finish_ret(&context, hash.data());
+        if (hash != *job.expected_hash) {
+            LOG_ERROR(Loader, "Hash mismatch for {}, expected {} but got {}",
+                      job.dest->GetName(), Common::HexToString(*job.expected_hash),
+                      Common::HexToString(hash));
+            state.Fail(InstallResult::ErrorHashMismatch);
+        }
+    });
+
+    std::jthread writer([&] {
+        Common::SetCurrentThreadName("NcaInstallWrite");
+        InstallChunk chunk;
+        while (true) {
+            to_writer.PopWait(chunk);
+            if (chunk.data.empty()) {
+                break;
+            }
+            // Keep draining after a failure, the other stages wait on this one.
+            if (!state.failed) {
+                if (job.dest->Write(chunk.data.data(), chunk.data.size(), chunk.offset) ==
+                    chunk.data.size()) {
+                    state.processed_size += chunk.data.size();
+                } else {
+                    LOG_ERROR(Loader, "Failed to write {} at offset {:X}", job.dest->GetName(),
+                              chunk.offset);
+                    state.Fail(InstallResult::ErrorCopyFailed);
+                }
+            }
+            written.EmplaceWait(std::move(chunk));
+        }
+    });
+
+    size_t num_chunks = 0;
+    size_t offset = 0;
+    while (offset < size && !state.failed) {
+        InstallChunk chunk;
+        if (num_chunks < INSTALL_CHUNKS_PER_NCA) {
+            ++num_chunks;
+        } else {
+            written.PopWait(chunk);
+        }
+        const size_t read_size = std::min(INSTALL_CHUNK_SIZE, size - offset);
+        chunk.data.resize(read_size);
+        chunk.offset = offset;
+        if (job.source->Read(chunk.data.data(), read_size, offset) != read_size) {
+            LOG_ERROR(Loader, "Failed to read {} at offset {:X}", job.source->GetName(), offset);
+            state.Fail(InstallResult::ErrorCopyFailed);
+            break;
+        }
+        to_hasher.EmplaceWait(std::move(chunk));
+        offset += read_size;
+    }
+    read_complete = offset == size;
+    to_hasher.EmplaceWait(InstallChunk{});
+}
+
+} // Anonymous namespace
+
+InstallResult RunInstallJobs(std::span<const InstallJob> jobs, const InstallOptions& options) {
+    u64 total_size = 0;
+    for (const auto& job : jobs) {
+        total_size += job.source->GetSize();
+    }
+
+    size_t ncas_in_flight = options.max_ncas_in_flight;
+    if (ncas_in_flight == 0) {
+        // Every NCA uses three threads, the host does not need to be saturated by the readers.
+        ncas_in_flight = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+    }
+    ncas_in_flight = std::min(ncas_in_flight, jobs.size());
+
+    InstallState state;
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto get_progress = [&] {
+        const u64 processed_size = state.processed_size;
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        return InstallProgress{
+            .total_size = total_size,
+            .processed_size = processed_size,
+            .bytes_per_second = elapsed.count() > 0
+                                    ? processed_size * 1000 / static_cast<u64>(elapsed.count())
+                                    : 0,
+        };
+    };
+
+    {
+        Common::ThreadWorker workers(ncas_in_flight, "NcaInstall");
+        for (const auto& job : jobs) {
+            workers.QueueWork([&job, &state] {
+                if (!state.failed) {
+                    RunInstallJob(job, state);
+                }
+                {
+                    std::scoped_lock lk{state.mutex};
+                    ++state.jobs_done;
+                }
+                state.cv.notify_all();
+            });
+        }
+
+        // Progress is reported from this thread, the callback does not have to be thread safe.
+        std::unique_lock lk{state.mutex};
+        while (!state.cv.wait_for(lk, std::chrono::milliseconds{100},
+                                  [&] { return state.jobs_done == jobs.size(); })) {
+            if (!options.progress_callback) {
+                continue;
+            }
+            lk.unlock();
+            if (options.progress_callback(get_progress())) {
+                state.Fail(InstallResult::ErrorCancelled);
+            }
+            lk.lock();
+        }
+    }
+
+    const InstallProgress progress = get_progress();
+    if (options.progress_callback) {
+        options.progress_callback(progress);
+    }
+    LOG_INFO(Loader, "Copied {} of {} bytes of {} NCAs, {} at once, at {} MiB/s",
+             progress.processed_size, progress.total_size, jobs.size(), ncas_in_flight,
+             progress.bytes_per_second / 1_MiB);
+
+    if (state.result != InstallResult::Success) {
+        for (const auto& job : jobs) {
+            job.dest->GetContainingDirectory()->DeleteFile(job.dest->GetName());
+        }
+    }
+    return state.result;
+}
+
+InstallResult RegisteredCache::InstallEntry(const NSP& nsp, const InstallOptions& options) {
+    const auto ncas = nsp.GetNCAsCollapsed();
+    std::shared_ptr<NCA> meta_nca;
+    VirtualFile cnmt_file;
+    if (const auto meta_status = GetInstallMeta(ncas, meta_nca, cnmt_file);
+        meta_status != InstallResult::Success) {
+        return meta_status;
+    }
+
+    const CNMT cnmt(cnmt_file);
+    const auto title_id = cnmt.GetTitleID();
+    if (title_id == GetBaseTitleID(title_id) && cnmt.GetTitleVersion() == 0) {
+        return InstallResult::ErrorBaseInstall;
+    }
+
+    const auto removed_existing = RemoveExistingEntry(title_id);
+
+    // Files and metadata are created up front on this thread, only the copies run in parallel.
+    std::vector<InstallJob> jobs;
+    const auto add_job = [&](const NCA& nca, const NcaID& id,
+                             std::optional<Core::Crypto::SHA256Hash> expected_hash) {
+        VirtualFile out;
+        const auto res = CreateNCAFile(nca, options.overwrite_if_exists, id, out);
+        if (res == InstallResult::Success) {
+            jobs.push_back(InstallJob{nca.GetBaseFile(), std::move(out), expected_hash});
+        }
+        return res;
+    };
+
+    // Do not leave the NCAs created so far behind when a step before the copy fails.
+    auto remove_created_ncas = SCOPE_GUARD {
+        for (const auto& job : jobs) {
+            job.dest->GetContainingDirectory()->DeleteFile(job.dest->GetName());
+        }
+        Refresh();
+    };
+
+    const auto meta_id = Common::HexStringToArray<16>(meta_nca->GetName().substr(0, 32));
+    if (const auto res = add_job(*meta_nca, meta_id, std::nullopt); res != InstallResult::Success) {
+        return res;
+    }
+
+    for (const auto& record : cnmt.GetContentRecords()) {
+        // Ignore DeltaFragments, they are not useful to us
+        if (record.type == ContentRecordType::DeltaFragment) {
+            continue;
+        }
+        const auto nca = GetNCAFromNSPForID(nsp, record.nca_id);
+        if (nca == nullptr) {
+            return InstallResult::ErrorCopyFailed;
+        }
+        if (nca->GetStatus() == Loader::ResultStatus::ErrorMissingBKTRBaseRomFS &&
+            nca->GetTitleId() != title_id) {
+            // Create fake cnmt for patch to multiprogram application
+            if (!InstallSubProgramMeta(*nca, cnmt.GetHeader(), record)) {
+                return InstallResult::ErrorMetaFailed;
+            }
+        }
+        const auto expected_hash =
+            options.verify_hashes ? std::make_optional(record.hash) : std::nullopt;
+        if (const auto res = add_job(*nca, record.nca_id, expected_hash);
+            res != InstallResult::Success) {
+            return res;
+        }
+    }
+
+    // The copy deletes the NCAs itself when it fails.
+    remove_created_ncas.Cancel();
+    const auto copy_result = RunInstallJobs(jobs, options);
+    Refresh();
+    if (copy_result != InstallResult::Success) {
+        return copy_result;
+    }
+    if (removed_existing) {
+        return InstallResult::OverwriteExisting;
+    }
+    return InstallResult::Success;
+}
+
 InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
                                             bool overwrite_if_exists, const VfsCopyFunction& copy) {
     const CNMTHeader header{
@@ -677,6 +988,14 @@ InstallResult RegisteredCache::InstallEntry(const NCA& nca, TitleType type,
 InstallResult RegisteredCache::InstallEntry(const NCA& nca, const CNMTHeader& base_header,
                                             const ContentRecord& base_record,
                                             bool overwrite_if_exists, const VfsCopyFunction& copy) {
+    if (!InstallSubProgramMeta(nca, base_header, base_record)) {
+        return InstallResult::ErrorMetaFailed;
+    }
+    return RawInstallNCA(nca, copy, overwrite_if_exists, base_record.nca_id);
+}
+
+bool RegisteredCache::InstallSubProgramMeta(const NCA& nca, const CNMTHeader& base_header,
+                                            const ContentRecord& base_record) {
     const CNMTHeader header{
         .title_id = nca.GetTitleId(),
         .title_version = base_header.title_version,
@@ -693,10 +1012,7 @@ InstallResult RegisteredCache::InstallEntry(const NCA& nca, const CNMTHeader& ba
     };
     const OptionalHeader opt_header{0, 0};
     const CNMT new_cnmt(header, opt_header, {base_record}, {});
-    if (!RawInstallYuzuMeta(new_cnmt)) {
-        return InstallResult::ErrorMetaFailed;
-    }
-    return RawInstallNCA(nca, copy, overwrite_if_exists, base_record.nca_id);
+    return RawInstallYuzuMeta(new_cnmt);
 }
 
 bool RegisteredCache::RemoveExistingEntry(u64 title_id) const {
@@ -764,6 +1080,17 @@ bool RegisteredCache::RemoveExistingEntry(u64 title_id) const {
 InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                              bool overwrite_if_exists,
                                              std::optional<NcaID> override_id) {
+    VirtualFile out;
+    if (const auto res = CreateNCAFile(nca, overwrite_if_exists, override_id, out);
+        res != InstallResult::Success) {
+        return res;
+    }
+    return copy(nca.GetBaseFile(), out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
+                                                                 : InstallResult::ErrorCopyFailed;
+}
+
+InstallResult RegisteredCache::CreateNCAFile(const NCA& nca, bool overwrite_if_exists,
+                                             std::optional<NcaID> override_id, VirtualFile& out) {
     const auto in = nca.GetBaseFile();
     Core::Crypto::SHA256Hash hash{};
 
@@ -794,12 +1121,11 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
         c_dir->DeleteFile(Common::FS::GetFilename(path));
     }
 
-    auto out = dir->CreateFileRelative(path);
+    out = dir->CreateFileRelative(path);
     if (out == nullptr) {
         return InstallResult::ErrorCopyFailed;
     }
-    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
-                                                  : InstallResult::ErrorCopyFailed;
+    return InstallResult::Success;
 }
 
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
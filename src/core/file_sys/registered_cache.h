@@ -6,6 +6,8 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 #include <boost/container/flat_map.hpp>
@@ -39,8 +41,40 @@ enum class InstallResult {
     ErrorCopyFailed,
     ErrorMetaFailed,
     ErrorBaseInstall,
+    ErrorHashMismatch,
+    ErrorCancelled,
 };
 
+struct InstallProgress {
+    u64 total_size;       ///< Size of all the NCAs being installed
+    u64 processed_size;   ///< Size of the data written so far
+    u64 bytes_per_second; ///< Average throughput since the start of the installation
+};
+
+// Reports the progress of an installation, returning true cancels it.
+using InstallProgressCallback = std::function<bool(const InstallProgress&)>;
+
+struct InstallOptions {
+    bool overwrite_if_exists = false;
+    // Checks every NCA against the hash of its content record while it is copied.
+    bool verify_hashes = true;
+    // Number of NCAs copied at once, 0 picks one from the number of host threads.
+    size_t max_ncas_in_flight = 0;
+    InstallProgressCallback progress_callback;
+};
+
+// Copy of an NCA made by an installation, checked against the hash of its content record if any.
+struct InstallJob {
+    VirtualFile source;
+    VirtualFile dest;
+    std::optional<Core::Crypto::SHA256Hash> expected_hash;
+};
+
+// Copies NCAs into the files created for them, several at once. When a copy fails, a hash does
+// not match or the progress callback cancels the installation, every destination file is
+// deleted, so no partial or corrupted NCA is left behind.
+InstallResult RunInstallJobs(std::span<const InstallJob> jobs, const InstallOptions& options);
+
 struct ContentProviderEntry {
     u64 title_id;
     ContentRecordType type;
@@ -163,6 +197,10 @@ public:
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
                                const VfsCopyFunction& copy = &VfsRawCopy);
 
+    // Same as above, but copies several NCAs at once, each through a reader, hasher and writer
+    // thread, and verifies them against the CNMT in the same pass.
+    InstallResult InstallEntry(const NSP& nsp, const InstallOptions& options);
+
     // Due to the fact that we must use Meta-type NCAs to determine the existence of files, this
     // poses quite a challenge. Instead of creating a new meta NCA for this file, yuzu will create a
     // dir inside the NAND called 'yuzu_meta' and store the raw CNMT there.
@@ -190,6 +228,10 @@ private:
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& open_dir, std::string_view path) const;
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+    InstallResult CreateNCAFile(const NCA& nca, bool overwrite_if_exists,
+                                std::optional<NcaID> override_id, VirtualFile& out);
+    bool InstallSubProgramMeta(const NCA& nca, const CNMTHeader& base_header,
+                               const ContentRecord& base_record);
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
     VirtualDir dir;
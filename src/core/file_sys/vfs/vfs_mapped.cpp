@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/fs/fs_util.h"
+#include "core/file_sys/vfs/vfs_mapped.h"
+
+namespace FileSys {
+
+MappedVfsFile::MappedVfsFile(VirtualFile base_, Common::FS::MappedFile&& mapping_)
+    : base(std::move(base_)), mapping(std::move(mapping_)) {}
+
+MappedVfsFile::~MappedVfsFile() = default;
+
+VirtualFile MappedVfsFile::MakeMappedFile(VirtualFile base, const std::string& path) {
+    if (base == nullptr || base->IsWritable()) {
+        return base;
+    }
+    // Game paths are UTF-8, which Windows would not assume for a narrow string
+    Common::FS::MappedFile mapping{std::filesystem::path{Common::FS::ToU8String(path)}};
+    if (!mapping.IsOpen() || mapping.GetData().size() != base->GetSize()) {
+        return base;
+    }
+    return std::shared_ptr<MappedVfsFile>(new MappedVfsFile(std::move(base), std::move(mapping)));
+}
+
+std::string MappedVfsFile::GetName() const {
+    return base->GetName();
+}
+
+std::size_t MappedVfsFile::GetSize() const {
+    return mapping.GetData().size();
+}
+
+bool MappedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir MappedVfsFile::GetContainingDirectory() const {
+    return base->GetContainingDirectory();
+}
+
+bool MappedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool MappedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t MappedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    const auto contents = mapping.GetData();
+    if (offset >= contents.size()) {
+        return 0;
+    }
+    const auto read_size = std::min(length, contents.size() - offset);
+    std::memcpy(data, contents.data() + offset, read_size);
+    return read_size;
+}
+
+std::size_t MappedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool MappedVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+std::string MappedVfsFile::GetFullPath() const {
+    return base->GetFullPath();
+}
+
+} // namespace FileSys
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include "common/fs/mapped_file.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+// Class that serves the reads of a file on the user's computer from a memory mapping of it, so
+// any number of threads can read at once without locks or system calls. Read-only, the wrapped
+// file provides the name and the containing directory.
+class MappedVfsFile : public VfsFile {
+private:
+    MappedVfsFile(VirtualFile base, Common::FS::MappedFile&& mapping);
+
+public:
+    ~MappedVfsFile() override;
+
+    /// Maps the file at path, which backs base. Returns base if the file cannot be mapped.
+    static VirtualFile MakeMappedFile(VirtualFile base, const std::string& path);
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    VirtualFile base;
+    Common::FS::MappedFile mapping;
+};
+
+} // namespace FileSys
@@ -90,6 +90,10 @@ std::size_t OffsetVfsFile::GetOffset() const {
     return offset;
 }
 
+VirtualFile OffsetVfsFile::GetBaseFile() const {
+    return file;
+}
+
 std::size_t OffsetVfsFile::TrimToFit(std::size_t r_size, std::size_t r_offset) const {
     return std::clamp(r_size, std::size_t{0}, size - r_offset);
 }
@@ -316,7 +316,17 @@ bool RealVfsFile::IsReadable() const {
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
     auto lk = base.RefreshReference(path, perms, *reference);
-    if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
+    if (!reference->file) {
+        return 0;
+    }
+    if (False(perms & OpenMode::Write)) {
+        // Positional reads leave the file pointer alone, so the list lock is not needed to read.
+        // Holding a reference keeps the file open if it gets evicted in the meantime.
+        const auto file = reference->file;
+        lk.unlock();
+        return file->ReadSpanAt(std::span{data, length}, offset);
+    }
+    if (!reference->file->Seek(static_cast<s64>(offset))) {
         return 0;
     }
     return reference->file->ReadSpan(std::span{data, length});
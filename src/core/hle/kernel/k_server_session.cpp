@@ -1146,10 +1146,19 @@ Result KServerSession::ReceiveRequest(uintptr_t server_message, uintptr_t server
         }
         Core::Memory::Memory& memory{client_thread->GetOwnerProcess()->GetMemory()};
         u32* cmd_buf{reinterpret_cast<u32*>(memory.GetPointer(client_message))};
-        *out_context =
-            std::make_shared<Service::HLERequestContext>(m_kernel, memory, this, client_thread);
-        (*out_context)->SetSessionRequestManager(manager);
-        (*out_context)->PopulateFromIncomingCommandBuffer(cmd_buf);
+
+        // Reuse the context of the previous request when nothing else holds it, which keeps
+        // its buffers allocated.
+        auto& context = *out_context;
+        if (context != nullptr && context.use_count() == 1 &&
+            std::addressof(context->GetMemory()) == std::addressof(memory)) {
+            context->Reset(this, client_thread);
+        } else {
+            context =
+                std::make_shared<Service::HLERequestContext>(m_kernel, memory, this, client_thread);
+        }
+        context->SetSessionRequestManager(manager);
+        context->PopulateFromIncomingCommandBuffer(cmd_buf);
         // We succeeded.
         R_SUCCEED();
     } else {
@@ -1225,6 +1234,8 @@ Result KServerSession::SendReply(uintptr_t server_message, uintptr_t server_buff
 
     // Get the request.
     KSessionRequest* request;
+    bool hle_reply_sent = false;
+    Result hle_result = ResultSuccess;
     {
         KScopedSchedulerLock sl{m_kernel};
 
@@ -1237,6 +1248,19 @@ Result KServerSession::SendReply(uintptr_t server_message, uintptr_t server_buff
         if (!m_request_list.empty()) {
             this->NotifyAvailable();
         }
+
+        // HLE servers have already written the reply to the client command buffer, and have
+        // nothing to clean up. End the wait of a synchronous client now rather than taking the
+        // scheduler lock again.
+        if (is_hle && request->GetEvent() == nullptr) {
+            KThread* client_thread = request->GetThread();
+            const bool closed = client_thread == nullptr || m_parent->IsClientClosed();
+            hle_result = closed ? ResultSessionClosed : ResultSuccess;
+            if (client_thread != nullptr && !client_thread->IsTerminationRequested()) {
+                client_thread->EndWait(hle_result);
+            }
+            hle_reply_sent = true;
+        }
     }
 
     // Close reference to the request once we're done processing it.
@@ -1244,6 +1268,11 @@ Result KServerSession::SendReply(uintptr_t server_message, uintptr_t server_buff
         request->Close();
     };
 
+    // The reply to a synchronous HLE request was sent above.
+    if (hle_reply_sent) {
+        R_RETURN(hle_result);
+    }
+
     // Extract relevant information from the request.
     const uint64_t client_message = request->GetAddress();
     const size_t client_buffer_size = request->GetSize();
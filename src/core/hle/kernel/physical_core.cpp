@@ -3,6 +3,7 @@
 
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "core/arm/guest_profiler.h"
 #include "core/core.h"
 #include "core/debugger/debugger.h"
 #include "core/hle/kernel/k_process.h"
@@ -97,6 +98,15 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
             ExitContext();
         }
 
+        // Take a sample of the guest code if the profiler asked for one.
+        if (m_is_sample_requested.exchange(false, std::memory_order_relaxed)) {
+            if (auto* const profiler = system.GetGuestProfiler()) {
+                Svc::ThreadContext ctx{};
+                interface->GetContext(ctx);
+                profiler->Record(m_core_index, *process, ctx);
+            }
+        }
+
         // Determine why we stopped.
         const bool supervisor_call = True(hr & Core::HaltReason::SupervisorCall);
         const bool prefetch_abort = True(hr & Core::HaltReason::PrefetchAbort);
@@ -138,8 +148,8 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
             return;
         }
 
-        // Handle external interrupt sources.
-        if (interrupt || m_is_single_core) {
+        // Handle external interrupt sources. A halt requested only for a sample resumes the thread.
+        if ((interrupt && this->IsInterrupted()) || m_is_single_core) {
             return;
         }
     }
@@ -235,6 +245,20 @@ void PhysicalCore::Interrupt() {
     arm_interface->SignalInterrupt(thread);
 }
 
+void PhysicalCore::RequestSample() {
+    // Lock core context.
+    std::scoped_lock lk{m_guard};
+
+    // If there is no thread running, there is nothing to sample.
+    if (m_arm_interface == nullptr) {
+        return;
+    }
+
+    // Stop the CPU, it records the sample before running again.
+    m_is_sample_requested.store(true, std::memory_order_relaxed);
+    m_arm_interface->SignalInterrupt(m_current_thread);
+}
+
 void PhysicalCore::ClearInterrupt() {
     std::scoped_lock lk{m_guard};
     m_is_interrupted = false;
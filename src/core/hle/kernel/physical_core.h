@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -58,6 +59,9 @@ public:
     // Check if this core is interrupted.
     bool IsInterrupted() const;
 
+    // Ask the core for a sample of the guest profiler, taken the next time it stops.
+    void RequestSample();
+
     std::size_t CoreIndex() const {
         return m_core_index;
     }
@@ -72,6 +76,7 @@ private:
     KThread* m_current_thread{};
     bool m_is_interrupted{};
     bool m_is_single_core{};
+    std::atomic<bool> m_is_sample_requested{};
 };
 
 } // namespace Kernel
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "common/alignment.h"
 #include "common/div_ceil.h"
 
 #include "core/hle/service/cmif_types.h"
@@ -239,7 +240,11 @@ constexpr RequestLayout GetReplyOutLayout(bool is_domain) {
     return is_domain ? GetDomainReplyOutLayout<MethodArguments>() : GetNonDomainReplyOutLayout<MethodArguments>();
 }
 
-using OutTemporaryBuffers = std::array<Common::ScratchBuffer<u8>, 3>;
+struct OutTemporaryBuffers {
+    std::array<Common::ScratchBuffer<u8>, 3> buffers;
+    // Out buffers the handler writes directly into guest memory, which need no copy afterwards.
+    std::array<bool, 3> in_place;
+};
 
 template <typename MethodArguments, typename CallArguments, size_t PrevAlign = 1, size_t DataOffset = 0, size_t HandleIndex = 0, size_t InBufferIndex = 0, size_t OutBufferIndex = 0, bool RawDataFinished = false, size_t ArgIndex = 0>
 void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLERequestContext& ctx, OutTemporaryBuffers& temp) {
@@ -338,16 +343,34 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
-            auto& buffer = temp[OutBufferIndex];
+            // Let the handler write into guest memory when the buffer is contiguous in host memory,
+            // and set up a scratch buffer otherwise.
+            std::span<u8> out_span{};
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
-                buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
-            } else {
-                buffer.resize_destructive(0);
+                BufferView<u8> view{};
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    view = ctx.WriteBufferView(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    view = ctx.WriteBufferViewB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    view = ctx.WriteBufferViewC(OutBufferIndex);
+                }
+                out_span = view.Contiguous();
+            }
+            // Guest buffers need not be aligned for the element type, these use the scratch buffer.
+            if (!Common::IsAligned(reinterpret_cast<uintptr_t>(out_span.data()), alignof(ElementType))) {
+                out_span = {};
             }
 
-            ElementType* ptr = (ElementType*) buffer.data();
-            size_t size = buffer.size() / sizeof(ElementType);
+            auto& buffer = temp.buffers[OutBufferIndex];
+            temp.in_place[OutBufferIndex] = !out_span.empty();
+            if (out_span.empty()) {
+                buffer.resize_destructive(ctx.CanWriteBuffer(OutBufferIndex) ? ctx.GetWriteBufferSize(OutBufferIndex) : 0);
+                out_span = buffer;
+            }
+
+            ElementType* ptr = (ElementType*) out_span.data();
+            size_t size = out_span.size() / sizeof(ElementType);
 
             std::get<ArgIndex>(args) = std::span(ptr, size);
 
@@ -412,10 +435,10 @@ void WriteOutArgument(bool is_domain, CallArguments& args, u8* raw_data, HLERequ
 
             return WriteOutArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
-            auto& buffer = temp[OutBufferIndex];
+            auto& buffer = temp.buffers[OutBufferIndex];
             const size_t size = buffer.size();
 
-            if (size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
+            if (!temp.in_place[OutBufferIndex] && size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
                 if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
                     ctx.WriteBuffer(buffer.data(), size, OutBufferIndex);
                 } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
@@ -17,6 +17,7 @@
 #include "core/core.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/errors.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
 #include "core/file_sys/fs_directory.h"
 #include "core/file_sys/fs_filesystem.h"
 #include "core/file_sys/nca_metadata.h"
@@ -181,7 +182,9 @@ FSP_SRV::FSP_SRV(Core::System& system_)
     }
 }
 
-FSP_SRV::~FSP_SRV() = default;
+FSP_SRV::~FSP_SRV() {
+    OutputBlockCacheAccessLog();
+}
 
 Result FSP_SRV::SetCurrentProcess(ClientProcessId pid) {
     current_process_id = *pid;
@@ -519,6 +522,8 @@ Result FSP_SRV::GetProgramIndexForAccessLog(Out<AccessLogVersion> out_access_log
 Result FSP_SRV::FlushAccessLogOnSdCard() {
     LOG_DEBUG(Service_FS, "(STUBBED) called");
 
+    OutputBlockCacheAccessLog();
+
     R_SUCCEED();
 }
 
@@ -541,6 +546,19 @@ Result FSP_SRV::GetCacheStorageSize(s32 index, Out<s64> out_data_size, Out<s64>
     R_SUCCEED();
 }
 
+void FSP_SRV::OutputBlockCacheAccessLog() const {
+    if (access_log_mode != AccessLogMode::SdCard) {
+        return;
+    }
+
+    const auto statistics = FileSys::GetBlockCacheStatistics();
+    reporter.SaveFSAccessLog(fmt::format(
+        "FS_ACCESS: {{ function: \"BlockCache\", hits: {}, misses: {}, read_ahead: {}, "
+        "evictions: {}, cached_size: {} }}\n",
+        statistics.hits, statistics.misses, statistics.read_ahead_blocks, statistics.evictions,
+        statistics.cached_size));
+}
+
 Result FSP_SRV::OpenMultiCommitManager(OutInterface<IMultiCommitManager> out_interface) {
     LOG_DEBUG(Service_FS, "called");
 
@@ -107,6 +107,8 @@ private:
                                     s64 available_size, s64 journal_size);
     Result GetCacheStorageSize(s32 index, Out<s64> out_data_size, Out<s64> out_journal_size);
 
+    void OutputBlockCacheAccessLog() const;
+
     FileSystemController& fsc;
     const FileSys::ContentProvider& content_provider;
     const Core::Reporter& reporter;
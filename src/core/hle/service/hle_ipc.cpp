@@ -134,6 +134,41 @@ HLERequestContext::HLERequestContext(Kernel::KernelCore& kernel_, Core::Memory::
 
 HLERequestContext::~HLERequestContext() = default;
 
+void HLERequestContext::Reset(Kernel::KServerSession* server_session_, Kernel::KThread* thread_) {
+    cmd_buf[0] = 0;
+    server_session = server_session_;
+    client_handle_table = nullptr;
+    thread = thread_;
+
+    incoming_move_handles.clear();
+    incoming_copy_handles.clear();
+    outgoing_move_objects.clear();
+    outgoing_copy_objects.clear();
+    outgoing_domain_objects.clear();
+
+    command_header.reset();
+    handle_descriptor_header.reset();
+    data_payload_header.reset();
+    domain_message_header.reset();
+    buffer_x_descriptors.clear();
+    buffer_a_descriptors.clear();
+    buffer_b_descriptors.clear();
+    buffer_w_descriptors.clear();
+    buffer_c_descriptors.clear();
+
+    command = 0;
+    pid = 0;
+    write_size = 0;
+    data_payload_offset = 0;
+    handles_offset = 0;
+    domain_offset = 0;
+
+    manager.reset();
+    is_deferred = false;
+    profile_entry = nullptr;
+    handler_time = {};
+}
+
 void HLERequestContext::ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming) {
     IPC::RequestParser rp(src_cmdbuf);
     command_header = rp.PopRaw<IPC::CommandHeader>();
@@ -383,6 +418,58 @@ std::span<const u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) cons
     }
 }
 
+BufferView<u8> HLERequestContext::WriteBufferViewB(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorB().size()) {
+        return {};
+    }
+    const auto& descriptor = BufferDescriptorB()[buffer_index];
+    if (OverlapsReadBuffers(descriptor.Address(), descriptor.Size())) {
+        return {};
+    }
+    return MakeWriteBufferView(descriptor.Address(), descriptor.Size());
+}
+
+BufferView<u8> HLERequestContext::WriteBufferViewC(std::size_t buffer_index) const {
+    if (buffer_index >= BufferDescriptorC().size()) {
+        return {};
+    }
+    const auto& descriptor = BufferDescriptorC()[buffer_index];
+    if (OverlapsReadBuffers(descriptor.Address(), descriptor.Size())) {
+        return {};
+    }
+    return MakeWriteBufferView(descriptor.Address(), descriptor.Size());
+}
+
+BufferView<u8> HLERequestContext::WriteBufferView(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    return is_buffer_b ? WriteBufferViewB(buffer_index) : WriteBufferViewC(buffer_index);
+}
+
+BufferView<u8> HLERequestContext::MakeWriteBufferView(u64 address, std::size_t size) const {
+    BufferView<u8>::SpanList spans;
+    for (std::size_t offset = 0; offset < size;) {
+        // Buffers may be mapped but cached by the rasterizer, they are then written through
+        // WriteBuffer, which reports unmapped pages.
+        const auto span = memory.GetHostSpan(address + offset, size - offset, true);
+        if (span.empty()) {
+            return {};
+        }
+        spans.push_back(span);
+        offset += span.size();
+    }
+    return BufferView<u8>{std::move(spans)};
+}
+
+bool HLERequestContext::OverlapsReadBuffers(u64 address, std::size_t size) const {
+    const auto overlaps = [address, size](const auto& descriptor) {
+        return descriptor.Size() != 0 && address < descriptor.Address() + descriptor.Size() &&
+               descriptor.Address() < address + size;
+    };
+    return std::ranges::any_of(BufferDescriptorA(), overlaps) ||
+           std::ranges::any_of(BufferDescriptorX(), overlaps);
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
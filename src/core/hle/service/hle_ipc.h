@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -12,6 +13,8 @@
 #include <type_traits>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/concepts.h"
@@ -19,6 +22,7 @@
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/k_handle_table.h"
 #include "core/hle/kernel/svc_common.h"
+#include "core/hle/service/service_profiler.h"
 
 union Result;
 
@@ -81,6 +85,42 @@ using SessionRequestHandlerWeakPtr = std::weak_ptr<SessionRequestHandler>;
 using SessionRequestHandlerPtr = std::shared_ptr<SessionRequestHandler>;
 using SessionRequestHandlerFactory = std::function<SessionRequestHandlerPtr()>;
 
+/**
+ * View of an IPC output buffer over the host memory backing its guest pages, which lets services
+ * write the buffer in place instead of through a copy. The pages are looked up once, when the
+ * view is made, and the ones which follow each other in host memory are merged, so the view of
+ * most buffers is a single span.
+ */
+template <typename T>
+class BufferView {
+public:
+    using SpanList = boost::container::small_vector<std::span<T>, 2>;
+
+    BufferView() = default;
+    explicit BufferView(SpanList&& spans_) : spans{std::move(spans_)} {
+        for (const auto& span : spans) {
+            total_size += span.size();
+        }
+    }
+
+    /// Gets the whole buffer as a single span, empty if it is not contiguous in host memory.
+    [[nodiscard]] std::span<T> Contiguous() const {
+        return spans.size() == 1 ? spans.front() : std::span<T>{};
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return total_size;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return total_size == 0;
+    }
+
+private:
+    SpanList spans;
+    std::size_t total_size{};
+};
+
 /**
  * Manages the underlying HLE requests for a session, and whether (or not) the session should be
  * treated as a domain. This is managed separately from server sessions, as this state is shared
@@ -185,6 +225,12 @@ public:
                                Kernel::KServerSession* session, Kernel::KThread* thread);
     ~HLERequestContext();
 
+    /**
+     * Prepares the context for the next request received by its session. The vectors and read
+     * buffers keep their allocations.
+     */
+    void Reset(Kernel::KServerSession* server_session_, Kernel::KThread* thread_);
+
     /// Returns a pointer to the IPC command buffer for this request.
     [[nodiscard]] u32* CommandBuffer() {
         return cmd_buf.data();
@@ -269,6 +315,17 @@ public:
     /// Helper function to read a copy of a buffer using the appropriate buffer descriptor
     [[nodiscard]] std::vector<u8> ReadBufferCopy(std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper functions to get a view of a buffer using the buffer descriptor B, C or the
+     * appropriate one, to write it in place. The view is empty when the buffer overlaps one of
+     * the input buffers of the request, as writing it could then change inputs which are yet to
+     * be read, or when some of its pages are cached by the rasterizer, as it must only see them
+     * written once the write is done. Callers then fall back to writing a copy with WriteBuffer.
+     */
+    [[nodiscard]] BufferView<u8> WriteBufferViewB(std::size_t buffer_index = 0) const;
+    [[nodiscard]] BufferView<u8> WriteBufferViewC(std::size_t buffer_index = 0) const;
+    [[nodiscard]] BufferView<u8> WriteBufferView(std::size_t buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size,
                             std::size_t buffer_index = 0) const;
@@ -389,11 +446,30 @@ public:
         is_deferred = is_deferred_;
     }
 
+    /// Returns the service profiler entry the handler time was recorded to, null if none was.
+    ServiceProfiler::Entry* GetProfileEntry() const {
+        return profile_entry;
+    }
+
+    /// Returns the time the handler of the request took, when it was profiled.
+    std::chrono::nanoseconds GetHandlerTime() const {
+        return handler_time;
+    }
+
+    void SetProfileEntry(ServiceProfiler::Entry* entry, std::chrono::nanoseconds handler_time_) {
+        profile_entry = entry;
+        handler_time = handler_time_;
+    }
+
 private:
     friend class IPC::ResponseBuilder;
 
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
+    BufferView<u8> MakeWriteBufferView(u64 address, std::size_t size) const;
+
+    bool OverlapsReadBuffers(u64 address, std::size_t size) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     Kernel::KHandleTable* client_handle_table{};
@@ -426,6 +502,9 @@ private:
     std::weak_ptr<SessionRequestManager> manager{};
     bool is_deferred{false};
 
+    ServiceProfiler::Entry* profile_entry{};
+    std::chrono::nanoseconds handler_time{};
+
     Kernel::KernelCore& kernel;
     Core::Memory::Memory& memory;
 
@@ -16,6 +16,26 @@
 
 namespace Service::Nvidia {
 
+namespace {
+
+/**
+ * Gets the span a device writes the output of an ioctl to: the guest buffer itself when it is
+ * contiguous in host memory, or else the scratch buffer, which is then copied to the guest buffer.
+ */
+std::span<u8> GetIoctlOutput(HLERequestContext& ctx, Ioctl command, std::size_t buffer_index,
+                             Common::ScratchBuffer<u8>& scratch) {
+    if (command.is_out != 0) {
+        if (const auto output = ctx.WriteBufferView(buffer_index).Contiguous(); !output.empty()) {
+            scratch.resize_destructive(0);
+            return output;
+        }
+    }
+    scratch.resize_destructive(ctx.GetWriteBufferSize(buffer_index));
+    return scratch;
+}
+
+} // Anonymous namespace
+
 void NVDRV::Open(HLERequestContext& ctx) {
     LOG_DEBUG(Service_NVDRV, "called");
     IPC::ResponseBuilder rb{ctx, 4};
@@ -65,11 +85,11 @@ void NVDRV::Ioctl1(HLERequestContext& ctx) {
     }
 
     // Check device
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    const auto output = GetIoctlOutput(ctx, command, 0, output_buffer);
     const auto input_buffer = ctx.ReadBuffer(0);
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
-    if (command.is_out != 0) {
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output);
+    if (command.is_out != 0 && output_buffer.size() != 0) {
         ctx.WriteBuffer(output_buffer);
     }
 
@@ -92,11 +112,10 @@ void NVDRV::Ioctl2(HLERequestContext& ctx) {
 
     const auto input_buffer = ctx.ReadBuffer(0);
     const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    const auto output = GetIoctlOutput(ctx, command, 0, output_buffer);
 
-    const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
-    if (command.is_out != 0) {
+    const auto nv_result = nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output);
+    if (command.is_out != 0 && output_buffer.size() != 0) {
         ctx.WriteBuffer(output_buffer);
     }
 
@@ -118,14 +137,17 @@ void NVDRV::Ioctl3(HLERequestContext& ctx) {
     }
 
     const auto input_buffer = ctx.ReadBuffer(0);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
-    inline_output_buffer.resize_destructive(ctx.GetWriteBufferSize(1));
+    const auto output = GetIoctlOutput(ctx, command, 0, output_buffer);
+    const auto inline_output = GetIoctlOutput(ctx, command, 1, inline_output_buffer);
 
-    const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, inline_output_buffer);
+    const auto nv_result = nvdrv->Ioctl3(fd, command, input_buffer, output, inline_output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(inline_output_buffer, 1);
+        if (output_buffer.size() != 0) {
+            ctx.WriteBuffer(output_buffer, 0);
+        }
+        if (inline_output_buffer.size() != 0) {
+            ctx.WriteBuffer(inline_output_buffer, 1);
+        }
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -20,6 +20,16 @@
 
 namespace Service {
 
+namespace {
+
+/// Returns the current time when requests are profiled, the clock is not read otherwise.
+std::chrono::steady_clock::time_point ProfileNow(const ServiceProfiler* profiler) {
+    return profiler != nullptr ? std::chrono::steady_clock::now()
+                               : std::chrono::steady_clock::time_point{};
+}
+
+} // Anonymous namespace
+
 enum class UserDataTag {
     Port,
     Session,
@@ -70,7 +80,8 @@ private:
     std::shared_ptr<HLERequestContext> m_context;
 };
 
-ServerManager::ServerManager(Core::System& system) : m_system{system}, m_selection_mutex{system} {
+ServerManager::ServerManager(Core::System& system)
+    : m_system{system}, m_profiler{system.GetServiceProfiler()}, m_selection_mutex{system} {
     // Initialize event.
     m_wakeup_event = Kernel::KEvent::Create(system.Kernel());
     m_wakeup_event->Initialize(nullptr);
@@ -345,6 +356,7 @@ Result ServerManager::OnSessionEvent(Session* session) {
 
     // Try to receive a message.
     auto* server_session = static_cast<Kernel::KServerSession*>(session->GetNativeHandle());
+    const auto receive_start = ProfileNow(m_profiler);
     res = server_session->ReceiveRequestHLE(&session->GetContext(), session->GetManager());
 
     // If the session has been closed, we're done.
@@ -356,10 +368,11 @@ Result ServerManager::OnSessionEvent(Session* session) {
     R_ASSERT(res);
 
     // Complete the sync request with deferral handling.
-    R_RETURN(this->CompleteSyncRequest(session));
+    R_RETURN(this->CompleteSyncRequest(session, ProfileNow(m_profiler) - receive_start));
 }
 
-Result ServerManager::CompleteSyncRequest(Session* session) {
+Result ServerManager::CompleteSyncRequest(Session* session,
+                                          std::chrono::nanoseconds receive_time) {
     Result res = ResultSuccess;
     Result service_res = ResultSuccess;
 
@@ -368,6 +381,7 @@ Result ServerManager::CompleteSyncRequest(Session* session) {
 
     // Complete the request. We have exclusive access to this session.
     auto* server_session = static_cast<Kernel::KServerSession*>(session->GetNativeHandle());
+    const auto dispatch_start = ProfileNow(m_profiler);
     service_res =
         session->GetManager()->CompleteSyncRequest(server_session, *session->GetContext());
 
@@ -384,6 +398,12 @@ Result ServerManager::CompleteSyncRequest(Session* session) {
     // Send the reply.
     res = server_session->SendReplyHLE();
 
+    // The overhead of the session is the time it took apart from the handler of the request.
+    if (auto* const entry = session->GetContext()->GetProfileEntry(); entry != nullptr) {
+        entry->session_overhead.Record(receive_time + (ProfileNow(m_profiler) - dispatch_start) -
+                                       session->GetContext()->GetHandlerTime());
+    }
+
     // If the session has been closed, we're done.
     if (res == Kernel::ResultSessionClosed || service_res == IPC::ResultSessionClosed) {
         this->DestroySession(session);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <list>
 #include <mutex>
 #include <optional>
@@ -63,13 +64,14 @@ private:
     Result OnPortEvent(Port* port);
     Result OnSessionEvent(Session* session);
     Result OnDeferralEvent();
-    Result CompleteSyncRequest(Session* session);
+    Result CompleteSyncRequest(Session* session, std::chrono::nanoseconds receive_time = {});
 
 private:
     void DestroySession(Session* session);
 
 private:
     Core::System& m_system;
+    ServiceProfiler* m_profiler;
     Mutex m_selection_mutex;
 
     // Events
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include <fmt/format.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -35,7 +37,8 @@ namespace Service {
 ServiceFrameworkBase::ServiceFrameworkBase(Core::System& system_, const char* service_name_,
                                            u32 max_sessions_, InvokerFn* handler_invoker_)
     : SessionRequestHandler(system_.Kernel(), service_name_), system{system_},
-      service_name{service_name_}, max_sessions{max_sessions_}, handler_invoker{handler_invoker_} {}
+      service_name{service_name_}, max_sessions{max_sessions_},
+      profiler{system_.GetServiceProfiler()}, handler_invoker{handler_invoker_} {}
 
 ServiceFrameworkBase::~ServiceFrameworkBase() {
     // Wait for other threads to release access before destroying
@@ -46,7 +49,12 @@ void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* function
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
         // Usually this array is sorted by id already, so hint to insert at the end
-        handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
+        const auto it =
+            handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
+        if (profiler != nullptr) {
+            it->second.profile_entry =
+                &profiler->GetEntry(service_name, it->first, false, it->second.name);
+        }
     }
 }
 
@@ -55,8 +63,12 @@ void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* func
     handlers_tipc.reserve(handlers_tipc.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
         // Usually this array is sorted by id already, so hint to insert at the end
-        handlers_tipc.emplace_hint(handlers_tipc.cend(), functions[i].expected_header,
-                                   functions[i]);
+        const auto it = handlers_tipc.emplace_hint(handlers_tipc.cend(),
+                                                   functions[i].expected_header, functions[i]);
+        if (profiler != nullptr) {
+            it->second.profile_entry =
+                &profiler->GetEntry(service_name, it->first, true, it->second.name);
+        }
     }
 }
 
@@ -83,6 +95,20 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
     }
 }
 
+void ServiceFrameworkBase::InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info) {
+    if (info.profile_entry == nullptr) {
+        handler_invoker(this, info.handler_callback, ctx);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    handler_invoker(this, info.handler_callback, ctx);
+    const auto handler_time = std::chrono::steady_clock::now() - start;
+
+    info.profile_entry->handler_time.Record(handler_time);
+    ctx.SetProfileEntry(info.profile_entry, handler_time);
+}
+
 void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     auto itr = handlers.find(ctx.GetCommand());
     const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
@@ -91,7 +117,7 @@ void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
@@ -105,7 +131,7 @@ void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info);
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
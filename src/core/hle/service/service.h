@@ -92,6 +92,8 @@ private:
         u32 expected_header;
         HandlerFnP<ServiceFrameworkBase> handler_callback;
         const char* name;
+        /// Entry the calls are recorded to, null when the service profiler is disabled.
+        ServiceProfiler::Entry* profile_entry;
     };
 
     using InvokerFn = void(ServiceFrameworkBase* object, HandlerFnP<ServiceFrameworkBase> member,
@@ -104,6 +106,7 @@ private:
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
     void RegisterHandlersBaseTipc(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(HLERequestContext& ctx, const FunctionInfoBase* info);
+    void InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info);
 
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
@@ -112,6 +115,9 @@ private:
     /// which is not supported.
     bool service_registered = false;
 
+    /// Profiler the requests are recorded to, null when it is disabled.
+    ServiceProfiler* profiler;
+
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
     boost::container::flat_map<u32, FunctionInfoBase> handlers;
@@ -155,7 +161,8 @@ protected:
             : FunctionInfoBase{
                   expected_header_,
                   // Type-erase member function pointer by casting it down to the base class.
-                  static_cast<HandlerFnP<ServiceFrameworkBase>>(handler_callback_), name_} {}
+                  static_cast<HandlerFnP<ServiceFrameworkBase>>(handler_callback_), name_,
+                  nullptr} {}
     };
     using FunctionInfo = FunctionInfoTyped<Self>;
 
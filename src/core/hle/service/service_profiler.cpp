@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/hle/service/service_profiler.h"
+
+namespace Service {
+
+namespace {
+
+nlohmann::json HistogramToJson(const ServiceProfiler::HistogramSnapshot& histogram) {
+    // Trailing empty buckets are left out.
+    size_t num_buckets = histogram.buckets.size();
+    while (num_buckets > 0 && histogram.buckets[num_buckets - 1] == 0) {
+        --num_buckets;
+    }
+    return {
+        {"count", histogram.count},
+        {"total_ns", histogram.total_ns},
+        {"mean_ns", histogram.count != 0 ? histogram.total_ns / histogram.count : 0},
+        {"p50_ns", histogram.Percentile(0.50)},
+        {"p99_ns", histogram.Percentile(0.99)},
+        {"max_ns", histogram.max_ns},
+        {"log2_ns_buckets", std::vector<u64>(histogram.buckets.begin(),
+                                             histogram.buckets.begin() + num_buckets)},
+    };
+}
+
+} // Anonymous namespace
+
+void ServiceProfiler::Histogram::Record(std::chrono::nanoseconds time) {
+    const u64 ns = static_cast<u64>(std::max<s64>(time.count(), 0));
+    const size_t bucket =
+        std::min(static_cast<size_t>(std::bit_width(ns | 1)) - 1, NumBuckets - 1);
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    u64 max = max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+ServiceProfiler::HistogramSnapshot ServiceProfiler::Histogram::Read() const {
+    HistogramSnapshot snapshot{};
+    for (size_t i = 0; i < NumBuckets; ++i) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.total_ns = total_ns.load(std::memory_order_relaxed);
+    snapshot.max_ns = max_ns.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+u64 ServiceProfiler::HistogramSnapshot::Percentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const u64 rank = std::max<u64>(static_cast<u64>(std::ceil(percentile * count)), 1);
+    u64 seen = 0;
+    for (size_t i = 0; i < NumBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(u64{2} << i, max_ns);
+        }
+    }
+    return max_ns;
+}
+
+ServiceProfiler::ServiceProfiler() = default;
+
+ServiceProfiler::~ServiceProfiler() = default;
+
+ServiceProfiler::Entry& ServiceProfiler::GetEntry(std::string_view service_name, u32 command_id,
+                                                  bool is_tipc, const char* command_name) {
+    std::scoped_lock lk{mutex};
+    auto [it, inserted] =
+        entries.try_emplace(std::make_tuple(std::string{service_name}, is_tipc, command_id));
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.service_name = service_name;
+        entry.command_id = command_id;
+        entry.is_tipc = is_tipc;
+    }
+    // Services sharing a name may not name all their commands.
+    if (entry.command_name.empty() && command_name != nullptr) {
+        entry.command_name = command_name;
+    }
+    return entry;
+}
+
+std::vector<ServiceProfiler::EntrySnapshot> ServiceProfiler::Snapshot() const {
+    std::vector<EntrySnapshot> snapshot;
+    {
+        std::scoped_lock lk{mutex};
+        for (const auto& [key, entry] : entries) {
+            const auto handler_time = entry.handler_time.Read();
+            if (handler_time.count == 0) {
+                continue;
+            }
+            snapshot.push_back(EntrySnapshot{
+                .service_name = entry.service_name,
+                .command_name = entry.command_name,
+                .command_id = entry.command_id,
+                .is_tipc = entry.is_tipc,
+                .handler_time = handler_time,
+                .session_overhead = entry.session_overhead.Read(),
+            });
+        }
+    }
+    std::ranges::sort(snapshot, std::ranges::greater{},
+                      [](const EntrySnapshot& entry) { return entry.handler_time.total_ns; });
+    return snapshot;
+}
+
+void ServiceProfiler::Export(u64 program_id) const {
+    const auto snapshot = Snapshot();
+    if (snapshot.empty()) {
+        LOG_INFO(Service, "The service profiler recorded no requests");
+        return;
+    }
+
+    auto commands = nlohmann::json::array();
+    u64 num_requests = 0;
+    for (const EntrySnapshot& entry : snapshot) {
+        commands.push_back({
+            {"service", entry.service_name},
+            {"command", entry.command_name},
+            {"command_id", entry.command_id},
+            {"tipc", entry.is_tipc},
+            {"calls", entry.handler_time.count},
+            {"handler_time", HistogramToJson(entry.handler_time)},
+            {"session_overhead", HistogramToJson(entry.session_overhead)},
+        });
+        num_requests += entry.handler_time.count;
+    }
+    const nlohmann::json report{
+        {"program_id", fmt::format("{:016X}", program_id)},
+        {"commands", std::move(commands)},
+    };
+
+    const auto path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) /
+                      fmt::format("service_profile_{:016X}.json", program_id);
+    std::ofstream file;
+    Common::FS::OpenFileStream(file, path, std::ios_base::out | std::ios_base::trunc);
+    file << std::setw(4) << report << std::endl;
+    if (!file) {
+        LOG_ERROR(Service, "Failed to write the service profile to {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    LOG_INFO(Service, "Wrote {} service requests ({} distinct commands) to {}", num_requests,
+             snapshot.size(), Common::FS::PathToUTF8String(path));
+}
+
+} // namespace Service
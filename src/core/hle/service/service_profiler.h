@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Service {
+
+/**
+ * Profiler of the requests handled by the HLE services. For every command of every service, it
+ * counts the calls and records two latency histograms: the time spent in the handler of the
+ * command, and the overhead of the kernel session around it, which is receiving the request,
+ * dispatching it to the service and sending the reply.
+ *
+ * Entries are created when the services register their commands, so recording a request only
+ * updates atomic counters. The report is written as JSON to the log directory when emulation
+ * stops, and can be read live with Snapshot.
+ */
+class ServiceProfiler {
+public:
+    /// Buckets of the histograms, bucket i counts the times in [2^i, 2^(i+1)) ns.
+    static constexpr size_t NumBuckets = 32;
+
+    struct HistogramSnapshot {
+        std::array<u64, NumBuckets> buckets{};
+        u64 count{};
+        u64 total_ns{};
+        u64 max_ns{};
+
+        /// Returns the upper bound of the bucket holding the given percentile, in ns.
+        u64 Percentile(double percentile) const;
+    };
+
+    class Histogram {
+    public:
+        void Record(std::chrono::nanoseconds time);
+
+        HistogramSnapshot Read() const;
+
+    private:
+        std::array<std::atomic<u64>, NumBuckets> buckets{};
+        std::atomic<u64> total_ns{};
+        std::atomic<u64> max_ns{};
+    };
+
+    struct Entry {
+        std::string service_name;
+        std::string command_name;
+        u32 command_id{};
+        bool is_tipc{};
+
+        Histogram handler_time;
+        Histogram session_overhead;
+    };
+
+    struct EntrySnapshot {
+        std::string service_name;
+        std::string command_name;
+        u32 command_id{};
+        bool is_tipc{};
+
+        HistogramSnapshot handler_time;
+        HistogramSnapshot session_overhead;
+    };
+
+    ServiceProfiler();
+    ~ServiceProfiler();
+
+    /**
+     * Returns the entry of a command, creating it the first time. Entries are never destroyed
+     * before the profiler.
+     * @param service_name Name of the service
+     * @param command_id   ID of the command
+     * @param is_tipc      Whether the command is a TIPC one, they are numbered apart
+     * @param command_name Name of the command, may be null when it is unknown
+     */
+    Entry& GetEntry(std::string_view service_name, u32 command_id, bool is_tipc,
+                    const char* command_name);
+
+    /// Returns a copy of the entries which were called, by descending total handler time.
+    std::vector<EntrySnapshot> Snapshot() const;
+
+    /// Writes the report of the called entries to a JSON file in the log directory.
+    void Export(u64 program_id) const;
+
+private:
+    mutable std::mutex mutex;
+    std::map<std::tuple<std::string, bool, u32>, Entry> entries;
+};
+
+} // namespace Service
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
+#include "common/settings.h"
 #include "core/hle/service/server_manager.h"
 #include "core/hle/service/sockets/bsd.h"
 #include "core/hle/service/sockets/nsd.h"
@@ -18,7 +21,9 @@ void LoopProcess(Core::System& system) {
     server_manager->RegisterNamedService("nsd:a", std::make_shared<NSD>(system, "nsd:a"));
     server_manager->RegisterNamedService("nsd:u", std::make_shared<NSD>(system, "nsd:u"));
     server_manager->RegisterNamedService("sfdnsres", std::make_shared<SFDNSRES>(system));
-    server_manager->StartAdditionalHostThreads("bsdsocket", 2);
+    // The thread running the server is one of them.
+    const u16 num_threads = std::max<u16>(Settings::values.bsd_host_threads.GetValue(), 1);
+    server_manager->StartAdditionalHostThreads("bsdsocket", num_threads - 1);
     ServerManager::RunServer(std::move(server_manager));
 }
 
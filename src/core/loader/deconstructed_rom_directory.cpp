@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <cstring>
 #include "common/logging/log.h"
 #include "common/settings.h"
@@ -187,21 +188,35 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
 
     std::size_t code_size{};
 
+    // Decompress every module up front, the images are used by both passes below.
+    std::vector<FileSys::VirtualFile> module_files;
+    for (const auto& module : static_modules) {
+        module_files.push_back(dir->GetFile(module));
+    }
+    const auto read_start = std::chrono::steady_clock::now();
+    const auto module_images = AppLoader_NSO::ReadImages(module_files);
+    LOG_INFO(Loader, "Read the NSO modules in {} ms",
+             std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - read_start)
+                 .count());
+
     // Define an nce patch context for each potential module.
     PatchCollection patch_ctx{is_application};
 
     // Use the NSO module loader to figure out the code layout
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
+        if (!module_files[i]) {
             continue;
         }
+        if (!module_images[i]) {
+            return {ResultStatus::ErrorLoadingNSO, {}};
+        }
 
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, code_size, should_pass_arguments, false, {},
-            patch_ctx.GetPatchers(), patch_ctx.GetLastIndex());
+            process, system, *module_images[i], module_files[i]->GetName(), code_size,
+            should_pass_arguments, false, {}, patch_ctx.GetPatchers(), patch_ctx.GetLastIndex());
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
@@ -236,16 +251,15 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
                                    system.GetContentProvider()};
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
+        if (!module_files[i]) {
             continue;
         }
 
         const VAddr load_addr{next_load_addr};
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, load_addr, should_pass_arguments, true, pm,
-            patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
+            process, system, *module_images[i], module_files[i]->GetName(), load_addr,
+            should_pass_arguments, true, pm, patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
@@ -1,16 +1,22 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
+#include <functional>
+#include <thread>
 #include <vector>
 
+#include <mbedtls/sha256.h>
+
 #include "common/common_funcs.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/lz4_compression.h"
 #include "common/settings.h"
 #include "common/swap.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/hle/kernel/code_set.h"
@@ -37,15 +43,39 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+/**
+ * Decompresses a segment of an NSO image in place and checks its hash if requested. The segment
+ * holds the bytes read from the file, as they are stored in it.
+ */
+bool DecodeSegment(const FileSys::VfsFile& nso_file, NSOImage& image, std::size_t segment) {
+    const NSOHeader& header = image.header;
+    std::vector<u8> data = std::move(image.segments[segment]);
+    if (header.IsSegmentCompressed(segment)) {
+        std::vector<u8> uncompressed_data(header.segments[segment].size);
+        const int result = Common::Compression::DecompressDataLZ4(
+            uncompressed_data.data(), uncompressed_data.size(), data.data(), data.size());
+        if (result < 0 || static_cast<std::size_t>(result) != uncompressed_data.size()) {
+            LOG_ERROR(Loader, "Failed to decompress segment {} of {}", segment,
+                      nso_file.GetName());
+            return false;
+        }
+        data = std::move(uncompressed_data);
+    }
 
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
+    if (header.IsSegmentHashChecked(segment)) {
+        NSOHeader::SHA256Hash hash;
+        mbedtls_sha256_ret(data.data(), data.size(), hash.data(), 0);
+        if (hash != header.segment_hashes[segment]) {
+            LOG_ERROR(Loader, "Hash mismatch for segment {} of {}, expected {} but got {}",
+                      segment, nso_file.GetName(),
+                      Common::HexToString(header.segment_hashes[segment]),
+                      Common::HexToString(hash));
+            return false;
+        }
+    }
 
-    return uncompressed_data;
+    image.segments[segment] = std::move(data);
+    return true;
 }
 
 constexpr u32 PageAlignSize(u32 size) {
@@ -58,6 +88,11 @@ bool NSOHeader::IsSegmentCompressed(size_t segment_num) const {
     return ((flags >> segment_num) & 1) != 0;
 }
 
+bool NSOHeader::IsSegmentHashChecked(size_t segment_num) const {
+    ASSERT_MSG(segment_num < 3, "Invalid segment {}", segment_num);
+    return ((flags >> (segment_num + 3)) & 1) != 0;
+}
+
 AppLoader_NSO::AppLoader_NSO(FileSys::VirtualFile file_) : AppLoader(std::move(file_)) {}
 
 FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& in_file) {
@@ -73,24 +108,70 @@ FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& in_file) {
     return FileType::NSO;
 }
 
-std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
-                                               const FileSys::VfsFile& nso_file, VAddr load_base,
-                                               bool should_pass_arguments, bool load_into_process,
-                                               std::optional<FileSys::PatchManager> pm,
-                                               std::vector<Core::NCE::Patcher>* patches,
-                                               s32 patch_index) {
-    if (nso_file.GetSize() < sizeof(NSOHeader)) {
-        return std::nullopt;
+std::vector<std::optional<NSOImage>> AppLoader_NSO::ReadImages(
+    std::span<const FileSys::VirtualFile> nso_files) {
+    std::vector<std::optional<NSOImage>> images(nso_files.size());
+    std::size_t num_segments = 0;
+    for (std::size_t i = 0; i < nso_files.size(); ++i) {
+        const auto& nso_file = nso_files[i];
+        if (!nso_file || nso_file->GetSize() < sizeof(NSOHeader)) {
+            continue;
+        }
+
+        NSOImage image{};
+        if (sizeof(NSOHeader) != nso_file->ReadObject(&image.header)) {
+            continue;
+        }
+        if (image.header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
+            continue;
+        }
+        // Files of an NCA decrypt through a cipher shared by all their reads, so the stored bytes
+        // are read here, one segment after another.
+        for (std::size_t segment = 0; segment < image.segments.size(); ++segment) {
+            image.segments[segment] =
+                nso_file->ReadBytes(image.header.segments_compressed_size[segment],
+                                    image.header.segments[segment].offset);
+        }
+        num_segments += image.segments.size();
+        images[i] = std::move(image);
     }
 
-    NSOHeader nso_header{};
-    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
-        return std::nullopt;
+    // Decoding every segment of every module is independent, spread it over the workers.
+    std::vector<std::array<bool, 3>> segments_read(nso_files.size());
+    {
+        const std::size_t num_workers =
+            std::min<std::size_t>(num_segments, std::max(std::thread::hardware_concurrency(), 1U));
+        Common::ThreadWorker workers(std::max<std::size_t>(num_workers, 1), "NSOLoader");
+        for (std::size_t i = 0; i < images.size(); ++i) {
+            if (!images[i]) {
+                continue;
+            }
+            for (std::size_t segment = 0; segment < images[i]->segments.size(); ++segment) {
+                workers.QueueWork([&, i, segment] {
+                    segments_read[i][segment] =
+                        DecodeSegment(*nso_files[i], *images[i], segment);
+                });
+            }
+        }
+        workers.WaitForRequests();
     }
 
-    if (nso_header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
-        return std::nullopt;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        if (images[i] && !std::ranges::all_of(segments_read[i], std::identity{})) {
+            images[i].reset();
+        }
     }
+    return images;
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
+                                               const NSOImage& image, const std::string& name,
+                                               VAddr load_base, bool should_pass_arguments,
+                                               bool load_into_process,
+                                               std::optional<FileSys::PatchManager> pm,
+                                               std::vector<Core::NCE::Patcher>* patches,
+                                               s32 patch_index) {
+    const NSOHeader& nso_header = image.header;
 
     // Allocate some space at the beginning if we are patching in PreText mode.
     const size_t module_start = [&]() -> size_t {
@@ -109,11 +190,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
-        }
+        const std::vector<u8>& data = image.segments[i];
         program_image.resize(module_start + nso_header.segments[i].location +
                              static_cast<u32>(data.size()));
         std::memcpy(program_image.data() + module_start + nso_header.segments[i].location,
@@ -147,7 +224,6 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     }
 
     // Apply patches if necessary
-    const auto name = nso_file.GetName();
     if (pm && (pm->HasNSOPatch(nso_header.build_id, name) || Settings::values.dump_nso)) {
         std::span<u8> patchable_section(program_image.data() + module_start,
                                         program_image.size() - module_start);
@@ -215,7 +291,9 @@ AppLoader_NSO::LoadResult AppLoader_NSO::Load(Kernel::KProcess& process, Core::S
 
     // Load module
     const VAddr base_address = GetInteger(process.GetEntryPoint());
-    if (!LoadModule(process, system, *file, base_address, true, true)) {
+    const auto images = ReadImages({&file, 1});
+    if (!images[0] ||
+        !LoadModule(process, system, *images[0], file->GetName(), base_address, true, true)) {
         return {ResultStatus::ErrorLoadingNSO, {}};
     }
 
@@ -5,7 +5,10 @@
 
 #include <array>
 #include <optional>
+#include <span>
+#include <string>
 #include <type_traits>
+#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
@@ -58,6 +61,7 @@ struct NSOHeader {
     std::array<SHA256Hash, 3> segment_hashes;
 
     bool IsSegmentCompressed(size_t segment_num) const;
+    bool IsSegmentHashChecked(size_t segment_num) const;
 };
 static_assert(sizeof(NSOHeader) == 0x100, "NSOHeader has incorrect size.");
 static_assert(std::is_trivially_copyable_v<NSOHeader>, "NSOHeader must be trivially copyable.");
@@ -71,6 +75,12 @@ struct NSOArgumentHeader {
 };
 static_assert(sizeof(NSOArgumentHeader) == 0x20, "NSOArgumentHeader has incorrect size.");
 
+/// An NSO with its segments decompressed, ready to be loaded.
+struct NSOImage {
+    NSOHeader header;
+    std::array<std::vector<u8>, 3> segments;
+};
+
 /// Loads an NSO file
 class AppLoader_NSO final : public AppLoader {
 public:
@@ -89,9 +99,21 @@ public:
         return IdentifyType(file);
     }
 
+    /**
+     * Reads NSO files one after another, then decompresses and verifies the segments of all of
+     * them on a pool of threads.
+     *
+     * @param nso_files The files to read, null entries are skipped.
+     *
+     * @return The image of every file, std::nullopt for the null or invalid ones.
+     */
+    static std::vector<std::optional<NSOImage>> ReadImages(
+        std::span<const FileSys::VirtualFile> nso_files);
+
     static std::optional<VAddr> LoadModule(Kernel::KProcess& process, Core::System& system,
-                                           const FileSys::VfsFile& nso_file, VAddr load_base,
-                                           bool should_pass_arguments, bool load_into_process,
+                                           const NSOImage& image, const std::string& name,
+                                           VAddr load_base, bool should_pass_arguments,
+                                           bool load_into_process,
                                            std::optional<FileSys::PatchManager> pm = {},
                                            std::vector<Core::NCE::Patcher>* patches = nullptr,
                                            s32 patch_index = -1);
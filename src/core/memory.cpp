@@ -351,6 +351,65 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    std::span<u8> GetHostSpan(const Common::ProcessAddress vaddr, const std::size_t size,
+                              bool is_write) {
+        const auto& page_table = *current_page_table;
+        if (size == 0 || !AddressSpaceContains(page_table, vaddr, size)) [[unlikely]] {
+            return {};
+        }
+
+        u8* span_begin{};
+        std::size_t span_size = 0;
+        std::size_t page_index = vaddr >> YUZU_PAGEBITS;
+        std::size_t page_offset = vaddr & YUZU_PAGEMASK;
+        while (span_size < size) {
+            const std::size_t amount =
+                std::min(static_cast<std::size_t>(YUZU_PAGESIZE) - page_offset, size - span_size);
+            const auto current_vaddr =
+                static_cast<u64>((page_index << YUZU_PAGEBITS) + page_offset);
+
+            const auto [pointer, type] = page_table.pointers[page_index].PointerType();
+            u8* mem_ptr{};
+            switch (type) {
+            case Common::PageType::Unmapped:
+                break;
+            case Common::PageType::Memory:
+                mem_ptr =
+                    reinterpret_cast<u8*>(pointer + page_offset + (page_index << YUZU_PAGEBITS));
+                break;
+            case Common::PageType::DebugMemory:
+                mem_ptr = GetPointerFromDebugMemory(current_vaddr);
+                break;
+            case Common::PageType::RasterizerCachedMemory:
+                mem_ptr = GetPointerFromRasterizerCachedMemory(current_vaddr);
+                break;
+            default:
+                UNREACHABLE();
+            }
+            const bool is_contiguous = span_begin == nullptr || mem_ptr == span_begin + span_size;
+            if (mem_ptr == nullptr || !is_contiguous) {
+                break;
+            }
+            // The rasterizer may gather the written range before the span is fully written, so
+            // writes only get plain memory.
+            if (is_write && type != Common::PageType::Memory) {
+                break;
+            }
+
+            if (type == Common::PageType::RasterizerCachedMemory) {
+                HandleRasterizerDownload(current_vaddr, amount);
+            }
+            if (span_begin == nullptr) {
+                span_begin = mem_ptr;
+            }
+            span_size += amount;
+            page_index++;
+            page_offset = 0;
+        }
+
+        return {span_begin, span_size};
+    }
+
     template <bool UNSAFE>
     bool WriteBlockImpl(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
@@ -1033,6 +1092,11 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+std::span<u8> Memory::GetHostSpan(const Common::ProcessAddress vaddr, const std::size_t size,
+                                  bool is_write) {
+    return impl->GetHostSpan(vaddr, size, is_write);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
@@ -371,6 +371,24 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Gets the host memory backing the start of a range of the current process' address space,
+     * so it can be accessed in place. The span stops at the first page which does not follow the
+     * previous ones in host memory, callers get the rest of the range with further calls.
+     *
+     * @param vaddr    The virtual address the range begins at.
+     * @param size     The size of the range, in bytes.
+     * @param is_write Whether the span is about to be written. Written spans stop at the first
+     *                 page which is not plain memory, as the rasterizer could see a page cached by
+     *                 it as written before the write is done. Read spans flush these pages like
+     *                 ReadBlock.
+     *
+     * @returns The host memory backing the start of the range, empty if the range is not
+     *          entirely in the address space or its first page is unmapped, or is not plain
+     *          memory for a write.
+     */
+    std::span<u8> GetHostSpan(Common::ProcessAddress vaddr, std::size_t size, bool is_write);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
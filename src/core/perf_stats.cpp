@@ -13,6 +13,7 @@
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/perf_stats.h"
 
@@ -27,7 +28,8 @@ constexpr std::size_t IgnoreFrames = 5;
 
 namespace Core {
 
-PerfStats::PerfStats(u64 title_id_) : title_id(title_id_) {}
+PerfStats::PerfStats(u64 title_id_, Clock::time_point load_start_)
+    : title_id(title_id_), load_start(load_start_) {}
 
 PerfStats::~PerfStats() {
     if (!Settings::values.record_frame_times || title_id == 0) {
@@ -75,6 +77,12 @@ void PerfStats::EndSystemFrame() {
 
 void PerfStats::EndGameFrame() {
     game_frames.fetch_add(1, std::memory_order_relaxed);
+
+    if (!first_frame_presented.load(std::memory_order_relaxed) &&
+        !first_frame_presented.exchange(true, std::memory_order_relaxed)) {
+        LOG_INFO(Core, "First frame presented {} ms after the game started loading",
+                 duration_cast<std::chrono::milliseconds>(Clock::now() - load_start).count());
+    }
 }
 
 double PerfStats::GetMeanFrametime() const {
@@ -29,11 +29,15 @@ struct PerfStatsResults {
  */
 class PerfStats {
 public:
-    explicit PerfStats(u64 title_id_);
-    ~PerfStats();
-
     using Clock = std::chrono::steady_clock;
 
+    /**
+     * @param title_id_   Title ID of the game that is running
+     * @param load_start_ Point when the game started loading, the time to its first frame is logged
+     */
+    explicit PerfStats(u64 title_id_, Clock::time_point load_start_ = Clock::now());
+    ~PerfStats();
+
     void BeginSystemFrame();
     void EndSystemFrame();
     void EndGameFrame();
@@ -74,6 +78,11 @@ private:
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     std::atomic<u32> game_frames = 0;
 
+    /// Point when the game started loading
+    Clock::time_point load_start;
+    /// Whether the game presented its first frame
+    std::atomic_bool first_frame_presented = false;
+
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
     /// Point when the current system frame began
@@ -25,6 +25,8 @@ enum class InstallResult {
     Overwrite,
     Failure,
     BaseInstallAttempted,
+    HashMismatch,
+    Cancelled,
 };
 
 enum class GameVerificationResult {
@@ -128,36 +130,13 @@ inline bool RemoveMod(const Service::FileSystem::FileSystemController& fs_contro
  * \param vfs Reference to the VfsFilesystem instance in Core::System
  * \param filename Path to the NSP file
  * \param callback Callback to report the progress of the installation. The first size_t
- * parameter is the total size of the virtual file and the second is the current progress. If you
- * return true to the callback, it will cancel the installation as soon as possible.
+ * parameter is the total size of the NCAs being installed and the second is the current progress.
+ * If you return true to the callback, it will cancel the installation as soon as possible.
  * \return [InstallResult] representing how the installation finished
  */
 inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vfs,
                                 const std::string& filename,
                                 const std::function<bool(size_t, size_t)>& callback) {
-    const auto copy = [callback](const FileSys::VirtualFile& src, const FileSys::VirtualFile& dest,
-                                 std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        using namespace Common::Literals;
-        std::vector<u8> buffer(1_MiB);
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
-            if (callback(src->GetSize(), i)) {
-                dest->Resize(0);
-                return false;
-            }
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
-    };
-
     std::shared_ptr<FileSys::NSP> nsp;
     FileSys::VirtualFile file = vfs.OpenFile(filename, FileSys::OpenMode::Read);
     if (boost::to_lower_copy(file->GetName()).ends_with(std::string("nsp"))) {
@@ -172,8 +151,17 @@ inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vf
     if (nsp->GetStatus() != Loader::ResultStatus::Success) {
         return InstallResult::Failure;
     }
+    const FileSys::InstallOptions options{
+        .overwrite_if_exists = true,
+        .verify_hashes = true,
+        .max_ncas_in_flight = 0,
+        .progress_callback =
+            [&callback](const FileSys::InstallProgress& progress) {
+                return callback(progress.total_size, progress.processed_size);
+            },
+    };
     const auto res =
-        system.GetFileSystemController().GetUserNANDContents()->InstallEntry(*nsp, true, copy);
+        system.GetFileSystemController().GetUserNANDContents()->InstallEntry(*nsp, options);
     switch (res) {
     case FileSys::InstallResult::Success:
         return InstallResult::Success;
@@ -181,6 +169,10 @@ inline InstallResult InstallNSP(Core::System& system, FileSys::VfsFilesystem& vf
         return InstallResult::Overwrite;
     case FileSys::InstallResult::ErrorBaseInstall:
         return InstallResult::BaseInstallAttempted;
+    case FileSys::InstallResult::ErrorHashMismatch:
+        return InstallResult::HashMismatch;
+    case FileSys::InstallResult::ErrorCancelled:
+        return InstallResult::Cancelled;
     default:
         return InstallResult::Failure;
     }
@@ -0,0 +1,500 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/fs_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/file_sys/card_image.h"
+#include "core/file_sys/content_archive.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/submission_package.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_offset.h"
+#include "frontend_common/game_list_index.h"
+
+namespace {
+
+constexpr u32 INDEX_MAGIC = Common::MakeMagic('Y', 'G', 'L', 'I');
+constexpr u32 INDEX_VERSION = 1;
+
+class IndexWriter {
+public:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Write(const T& value) {
+        const auto* const bytes = reinterpret_cast<const u8*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void WriteSpan(std::span<const T> values) {
+        Write(static_cast<u64>(values.size()));
+        const auto* const bytes = reinterpret_cast<const u8*>(values.data());
+        data.insert(data.end(), bytes, bytes + values.size_bytes());
+    }
+
+    void WriteString(const std::string& value) {
+        WriteSpan(std::span<const char>{value});
+    }
+
+    const std::vector<u8>& GetData() const {
+        return data;
+    }
+
+private:
+    std::vector<u8> data;
+};
+
+/// Reads back the data of an IndexWriter, failing instead of reading past the end.
+class IndexReader {
+public:
+    explicit IndexReader(std::span<const u8> data_) : data{data_} {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool Read(T& value) {
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename Container>
+    bool ReadSpan(Container& values) {
+        using T = typename Container::value_type;
+        u64 count;
+        if (!Read(count) || count > (data.size() - offset) / sizeof(T)) {
+            return false;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), data.data() + offset, count * sizeof(T));
+        offset += count * sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value) {
+        return ReadSpan(value);
+    }
+
+private:
+    std::span<const u8> data;
+    std::size_t offset{};
+};
+
+bool IsGame(Loader::FileType file_type) {
+    return file_type != Loader::FileType::Unknown && file_type != Loader::FileType::Error;
+}
+
+/// Finds the offset of an NCA in the game file it was read from, through the partitions it is in.
+bool FlattenToRoot(const FileSys::VirtualFile& root, FileSys::VirtualFile file, u64& offset) {
+    offset = 0;
+    while (file != root) {
+        const auto offset_file = std::dynamic_pointer_cast<FileSys::OffsetVfsFile>(file);
+        if (offset_file == nullptr) {
+            return false;
+        }
+        offset += offset_file->GetOffset();
+        file = offset_file->GetBaseFile();
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+GameListIndex::GameListIndex(Core::System& system_) : system{system_} {}
+
+GameListIndex::~GameListIndex() = default;
+
+bool GameListIndex::Load(const std::filesystem::path& path) {
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    std::vector<u8> data(file.GetSize());
+    if (file.ReadSpan(std::span<u8>{data}) != data.size()) {
+        LOG_ERROR(Frontend, "Failed to read the game list index");
+        return false;
+    }
+
+    IndexReader reader{data};
+    u32 magic{};
+    u32 version{};
+    u64 num_entries{};
+    if (!reader.Read(magic) || !reader.Read(version) || magic != INDEX_MAGIC ||
+        version != INDEX_VERSION || !reader.Read(num_entries)) {
+        LOG_WARNING(Frontend, "Ignoring a game list index of another version");
+        return false;
+    }
+
+    std::unordered_map<std::string, Entry> loaded;
+    for (u64 i = 0; i < num_entries; ++i) {
+        std::string entry_path;
+        Entry entry;
+        u64 num_contents{};
+        u64 num_programs{};
+        if (!reader.ReadString(entry_path) || !reader.Read(entry.size) ||
+            !reader.Read(entry.last_write_time) || !reader.Read(entry.file_type) ||
+            !reader.Read(entry.program_id) || !reader.Read(entry.has_contents) ||
+            !reader.Read(num_contents)) {
+            LOG_ERROR(Frontend, "The game list index is truncated");
+            return false;
+        }
+        entry.contents.resize(std::min<u64>(num_contents, data.size()));
+        for (auto& content : entry.contents) {
+            if (!reader.Read(content.title_type) || !reader.Read(content.record_type) ||
+                !reader.Read(content.title_id) || !reader.Read(content.offset) ||
+                !reader.Read(content.size) || !reader.ReadString(content.name)) {
+                LOG_ERROR(Frontend, "The game list index is truncated");
+                return false;
+            }
+        }
+        if (!reader.Read(entry.has_programs) || !reader.Read(entry.programs_fingerprint) ||
+            !reader.Read(num_programs)) {
+            LOG_ERROR(Frontend, "The game list index is truncated");
+            return false;
+        }
+        entry.programs.resize(std::min<u64>(num_programs, data.size()));
+        for (auto& program : entry.programs) {
+            if (!reader.Read(program.program_id) || !reader.ReadString(program.name) ||
+                !reader.ReadSpan(program.icon)) {
+                LOG_ERROR(Frontend, "The game list index is truncated");
+                return false;
+            }
+        }
+        loaded.insert_or_assign(std::move(entry_path), std::move(entry));
+    }
+
+    std::scoped_lock lk{mutex};
+    entries = std::move(loaded);
+    dirty = false;
+    return true;
+}
+
+bool GameListIndex::Save(const std::filesystem::path& path, bool remove_unvisited) {
+    IndexWriter writer;
+    {
+        std::scoped_lock lk{mutex};
+        if (remove_unvisited) {
+            dirty |= std::erase_if(entries, [](const auto& pair) { return !pair.second.visited; }) !=
+                     0;
+        }
+        if (!dirty) {
+            return true;
+        }
+
+        writer.Write(INDEX_MAGIC);
+        writer.Write(INDEX_VERSION);
+        writer.Write(static_cast<u64>(entries.size()));
+        for (const auto& [entry_path, entry] : entries) {
+            writer.WriteString(entry_path);
+            writer.Write(entry.size);
+            writer.Write(entry.last_write_time);
+            writer.Write(entry.file_type);
+            writer.Write(entry.program_id);
+            writer.Write(entry.has_contents);
+            writer.Write(static_cast<u64>(entry.contents.size()));
+            for (const auto& content : entry.contents) {
+                writer.Write(content.title_type);
+                writer.Write(content.record_type);
+                writer.Write(content.title_id);
+                writer.Write(content.offset);
+                writer.Write(content.size);
+                writer.WriteString(content.name);
+            }
+            writer.Write(entry.has_programs);
+            writer.Write(entry.programs_fingerprint);
+            writer.Write(static_cast<u64>(entry.programs.size()));
+            for (const auto& program : entry.programs) {
+                writer.Write(program.program_id);
+                writer.WriteString(program.name);
+                writer.WriteSpan(std::span<const u8>{program.icon});
+            }
+        }
+        dirty = false;
+    }
+
+    // Write to a temporary file first, an interrupted save must not leave a truncated index.
+    auto temp_path = path;
+    temp_path += ".tmp";
+    void(Common::FS::CreateParentDirs(path));
+    {
+        const Common::FS::IOFile file{temp_path, Common::FS::FileAccessMode::Write};
+        const auto& data = writer.GetData();
+        if (!file.IsOpen() || file.WriteSpan(std::span<const u8>{data}) != data.size()) {
+            LOG_ERROR(Frontend, "Failed to write the game list index");
+            void(Common::FS::RemoveFile(temp_path));
+            return false;
+        }
+    }
+    void(Common::FS::RemoveFile(path));
+    if (!Common::FS::RenameFile(temp_path, path)) {
+        LOG_ERROR(Frontend, "Failed to replace the game list index");
+        return false;
+    }
+    return true;
+}
+
+u64 GameListIndex::ComputeContentFingerprint(const FileSys::ContentProvider& provider) {
+    IndexWriter writer;
+    for (const auto& entry : provider.ListEntriesFilter(FileSys::TitleType::Update)) {
+        const auto file = provider.GetEntryRaw(entry);
+        writer.Write(entry.title_id);
+        writer.Write(entry.type);
+        writer.Write(file != nullptr ? static_cast<u64>(file->GetSize()) : u64{0});
+    }
+    for (const auto& [title_id, disabled] : Settings::values.disabled_addons) {
+        writer.Write(title_id);
+        for (const auto& name : disabled) {
+            writer.WriteString(name);
+        }
+    }
+    const auto& data = writer.GetData();
+    return Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+void GameListIndex::SetContentFingerprint(u64 fingerprint) {
+    std::scoped_lock lk{mutex};
+    content_fingerprint = fingerprint;
+}
+
+std::optional<GameListIndex::Contents> GameListIndex::GetContents(const std::string& path) {
+    auto entry = FindEntry(path);
+    if (!entry) {
+        return std::nullopt;
+    }
+    if (entry->has_contents) {
+        if (!IsGame(entry->file_type)) {
+            return std::nullopt;
+        }
+        if (auto contents = OpenContents(path, *entry)) {
+            return contents;
+        }
+    }
+
+    const auto file = system.GetFilesystem()->OpenFile(path, FileSys::OpenMode::Read);
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+
+    Entry parsed{.size = entry->size, .last_write_time = entry->last_write_time};
+    Contents contents{};
+    const auto loader = Loader::GetLoader(system, file);
+    if (loader != nullptr) {
+        parsed.file_type = loader->GetFileType();
+    }
+    if (!IsGame(parsed.file_type)) {
+        parsed.has_contents = true;
+        StoreEntry(path, std::move(parsed));
+        return std::nullopt;
+    }
+
+    const auto result = loader->ReadProgramId(parsed.program_id);
+    if (result == Loader::ResultStatus::Success && parsed.file_type == Loader::FileType::NCA) {
+        contents.contents.push_back({
+            .title_type = FileSys::TitleType::Application,
+            .record_type = FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
+            .title_id = parsed.program_id,
+            .file = file,
+        });
+    } else if (result == Loader::ResultStatus::Success &&
+               (parsed.file_type == Loader::FileType::XCI ||
+                parsed.file_type == Loader::FileType::NSP)) {
+        const auto nsp = parsed.file_type == Loader::FileType::NSP
+                             ? std::make_shared<FileSys::NSP>(file)
+                             : FileSys::XCI{file}.GetSecurePartitionNSP();
+        for (const auto& title : nsp->GetNCAs()) {
+            for (const auto& nca : title.second) {
+                contents.contents.push_back({
+                    .title_type = nca.first.first,
+                    .record_type = nca.first.second,
+                    .title_id = title.first,
+                    .file = nca.second->GetBaseFile(),
+                });
+            }
+        }
+    }
+
+    // Only index the NCAs stored as plain ranges of the game file, compressed ones are parsed on
+    // every scan.
+    parsed.has_contents = true;
+    for (const auto& content : contents.contents) {
+        u64 offset;
+        if (!FlattenToRoot(file, content.file, offset)) {
+            parsed.has_contents = false;
+            parsed.contents.clear();
+            break;
+        }
+        parsed.contents.push_back({
+            .title_type = content.title_type,
+            .record_type = content.record_type,
+            .title_id = content.title_id,
+            .offset = offset,
+            .size = content.file->GetSize(),
+            .name = content.file->GetName(),
+        });
+    }
+
+    contents.file_type = parsed.file_type;
+    contents.program_id = parsed.program_id;
+    StoreEntry(path, std::move(parsed));
+    return contents;
+}
+
+std::optional<GameListIndex::Programs> GameListIndex::GetPrograms(const std::string& path) {
+    auto entry = FindEntry(path);
+    if (!entry) {
+        return std::nullopt;
+    }
+    if (entry->has_programs) {
+        if (!IsGame(entry->file_type)) {
+            return std::nullopt;
+        }
+        std::scoped_lock lk{mutex};
+        if (entry->programs_fingerprint == content_fingerprint) {
+            return Programs{entry->file_type, entry->size, std::move(entry->programs)};
+        }
+    }
+
+    const auto file = system.GetFilesystem()->OpenFile(path, FileSys::OpenMode::Read);
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+
+    Entry parsed{.size = entry->size, .last_write_time = entry->last_write_time};
+    {
+        std::scoped_lock lk{mutex};
+        parsed.programs_fingerprint = content_fingerprint;
+    }
+    parsed.has_programs = true;
+
+    auto loader = Loader::GetLoader(system, file);
+    if (loader != nullptr) {
+        parsed.file_type = loader->GetFileType();
+    }
+    if (!IsGame(parsed.file_type)) {
+        StoreEntry(path, std::move(parsed));
+        return std::nullopt;
+    }
+
+    const auto read_program = [&parsed](Loader::AppLoader& program_loader, u64 program_id) {
+        Program program{.program_id = program_id, .name = " "};
+        [[maybe_unused]] const auto icon_result = program_loader.ReadIcon(program.icon);
+        [[maybe_unused]] const auto title_result = program_loader.ReadTitle(program.name);
+        parsed.programs.push_back(std::move(program));
+    };
+
+    const auto result = loader->ReadProgramId(parsed.program_id);
+    std::vector<u64> program_ids;
+    loader->ReadProgramIds(program_ids);
+
+    if (result == Loader::ResultStatus::Success && program_ids.size() > 1 &&
+        (parsed.file_type == Loader::FileType::XCI || parsed.file_type == Loader::FileType::NSP)) {
+        for (const auto id : program_ids) {
+            loader = Loader::GetLoader(system, file, id);
+            if (loader != nullptr) {
+                read_program(*loader, id);
+            }
+        }
+    } else {
+        read_program(*loader, parsed.program_id);
+    }
+
+    Programs programs{parsed.file_type, parsed.size, parsed.programs};
+    StoreEntry(path, std::move(parsed));
+    return programs;
+}
+
+std::optional<GameListIndex::Entry> GameListIndex::FindEntry(const std::string& path) {
+    std::error_code ec;
+    const std::filesystem::path fs_path{Common::FS::ToU8String(path)};
+    const auto size = std::filesystem::file_size(fs_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto last_write_time = std::filesystem::last_write_time(fs_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+
+    Entry result{
+        .size = size,
+        .last_write_time = static_cast<s64>(last_write_time.time_since_epoch().count()),
+    };
+
+    std::scoped_lock lk{mutex};
+    const auto it = entries.find(path);
+    if (it == entries.end()) {
+        return result;
+    }
+    Entry& entry = it->second;
+    if (entry.size != result.size || entry.last_write_time != result.last_write_time) {
+        return result;
+    }
+    entry.visited = true;
+    return entry;
+}
+
+void GameListIndex::StoreEntry(const std::string& path, Entry entry) {
+    std::scoped_lock lk{mutex};
+    entry.visited = true;
+    dirty = true;
+
+    const auto [it, inserted] = entries.try_emplace(path);
+    Entry& stored = it->second;
+    if (inserted || stored.size != entry.size || stored.last_write_time != entry.last_write_time) {
+        stored = std::move(entry);
+        return;
+    }
+
+    stored.file_type = entry.file_type;
+    stored.program_id = entry.program_id;
+    stored.visited = true;
+    if (entry.has_contents) {
+        stored.has_contents = true;
+        stored.contents = std::move(entry.contents);
+    }
+    if (entry.has_programs) {
+        stored.has_programs = true;
+        stored.programs_fingerprint = entry.programs_fingerprint;
+        stored.programs = std::move(entry.programs);
+    }
+}
+
+std::optional<GameListIndex::Contents> GameListIndex::OpenContents(const std::string& path,
+                                                                   const Entry& entry) const {
+    const auto file = system.GetFilesystem()->OpenFile(path, FileSys::OpenMode::Read);
+    if (file == nullptr) {
+        return std::nullopt;
+    }
+
+    Contents contents{entry.file_type, entry.program_id, {}};
+    contents.contents.reserve(entry.contents.size());
+    for (const auto& content : entry.contents) {
+        if (content.offset + content.size > file->GetSize()) {
+            return std::nullopt;
+        }
+        contents.contents.push_back({
+            .title_type = content.title_type,
+            .record_type = content.record_type,
+            .title_id = content.title_id,
+            .file = std::make_shared<FileSys::OffsetVfsFile>(file, content.size, content.offset,
+                                                             content.name),
+        });
+    }
+    return contents;
+}
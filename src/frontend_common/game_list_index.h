@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs_types.h"
+#include "core/loader/loader.h"
+
+namespace Core {
+class System;
+}
+
+namespace FileSys {
+class ContentProvider;
+enum class ContentRecordType : u8;
+enum class TitleType : u8;
+} // namespace FileSys
+
+/**
+ * Persistent index of the game files found in the game directories. Every file is keyed by its
+ * path, size and last write time, so only the files which changed since the previous scan are
+ * opened and parsed again. Lookups are thread safe and may run in parallel.
+ *
+ * Two things are indexed for every file:
+ * - The NCAs inside of it, registered to the manual content provider. They only depend on the
+ *   file itself.
+ * - The programs inside of it, with their name and icon. Those also depend on the installed
+ *   updates, which provide the control data, so they are parsed again when the content
+ *   fingerprint changes.
+ */
+class GameListIndex {
+public:
+    /// An NCA inside of a game file.
+    struct Content {
+        FileSys::TitleType title_type;
+        FileSys::ContentRecordType record_type;
+        u64 title_id;
+        FileSys::VirtualFile file;
+    };
+
+    struct Contents {
+        Loader::FileType file_type;
+        u64 program_id; ///< Program ID read by the loader, 0 when it could not be read
+        std::vector<Content> contents;
+    };
+
+    /// A program inside of a game file, as shown in the game list.
+    struct Program {
+        u64 program_id;
+        std::string name;
+        std::vector<u8> icon;
+    };
+
+    struct Programs {
+        Loader::FileType file_type;
+        u64 size; ///< Size of the game file
+        std::vector<Program> programs;
+    };
+
+    explicit GameListIndex(Core::System& system_);
+    ~GameListIndex();
+
+    /**
+     * Loads an index saved by a previous scan.
+     * @param path Path of the index file
+     * @return True if the index could be read
+     */
+    bool Load(const std::filesystem::path& path);
+
+    /**
+     * Writes the index back, if any file was parsed since it was loaded.
+     * @param path             Path of the index file
+     * @param remove_unvisited Drops the files which were not looked up since the index was
+     *                         loaded, only pass true after a complete scan
+     * @return True if the index is up to date on disk
+     */
+    bool Save(const std::filesystem::path& path, bool remove_unvisited);
+
+    /// Computes a fingerprint of the updates known to a content provider and of the disabled
+    /// add-ons, which decide the name and icon of the programs.
+    static u64 ComputeContentFingerprint(const FileSys::ContentProvider& provider);
+
+    /// Sets the content fingerprint the indexed programs must match to be reused.
+    void SetContentFingerprint(u64 fingerprint);
+
+    /// Returns the NCAs inside of a game file, or std::nullopt if it is not a game.
+    std::optional<Contents> GetContents(const std::string& path);
+
+    /// Returns the programs inside of a game file, or std::nullopt if it is not a game.
+    std::optional<Programs> GetPrograms(const std::string& path);
+
+private:
+    struct IndexedContent {
+        FileSys::TitleType title_type;
+        FileSys::ContentRecordType record_type;
+        u64 title_id;
+        u64 offset;
+        u64 size;
+        std::string name;
+    };
+
+    struct Entry {
+        u64 size{};
+        s64 last_write_time{};
+        Loader::FileType file_type{Loader::FileType::Unknown};
+        u64 program_id{};
+
+        bool has_contents{};
+        std::vector<IndexedContent> contents;
+
+        bool has_programs{};
+        u64 programs_fingerprint{};
+        std::vector<Program> programs;
+
+        bool visited{};
+    };
+
+    /// Returns the indexed entry of a file, reset if the file changed since it was indexed, or
+    /// std::nullopt if the file can no longer be found.
+    std::optional<Entry> FindEntry(const std::string& path);
+
+    /// Stores the parts of an entry which were parsed, keeping the other ones if still valid.
+    void StoreEntry(const std::string& path, Entry entry);
+
+    /// Reopens the NCAs of an entry from their offsets in the game file.
+    std::optional<Contents> OpenContents(const std::string& path, const Entry& entry) const;
+
+    Core::System& system;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    u64 content_fingerprint{};
+    bool dirty{};
+};
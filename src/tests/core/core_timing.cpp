@@ -4,12 +4,15 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -50,6 +53,13 @@ u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     return end - start;
 }
 
+std::shared_ptr<Core::Timing::EventType> CreateCountingEvent(std::atomic<int>& runs) {
+    return Core::Timing::CreateEvent("counting", [&runs](s64, std::chrono::nanoseconds) {
+        ++runs;
+        return std::optional<std::chrono::nanoseconds>{};
+    });
+}
+
 } // Anonymous namespace
 
 TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
@@ -139,3 +149,137 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[Unschedule]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::atomic<int> unscheduled_runs{};
+    std::atomic<int> marker_runs{};
+    const auto unscheduled = CreateCountingEvent(unscheduled_runs);
+    const auto marker = CreateCountingEvent(marker_runs);
+
+    core_timing.SyncPause(true);
+
+    core_timing.ScheduleEvent(std::chrono::microseconds{1}, unscheduled);
+    core_timing.ScheduleEvent(std::chrono::microseconds{2}, unscheduled);
+    REQUIRE(core_timing.HasPendingEvents());
+
+    // Unscheduling uncounts every queued instance at once.
+    core_timing.UnscheduleEvent(unscheduled, Core::Timing::UnscheduleEventType::NoWait);
+    REQUIRE(!core_timing.HasPendingEvents());
+
+    // The marker is queued after the unscheduled instances, they would have run before it.
+    core_timing.ScheduleEvent(std::chrono::microseconds{10}, marker);
+
+    core_timing.Pause(false);
+    while (core_timing.HasPendingEvents())
+        ;
+
+    REQUIRE(marker_runs == 1);
+    REQUIRE(unscheduled_runs == 0);
+}
+
+TEST_CASE("CoreTiming[Reschedule]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::atomic<int> runs{};
+    std::atomic<s64> run_time{};
+    const auto event = Core::Timing::CreateEvent(
+        "event",
+        [&](s64 time, std::chrono::nanoseconds) -> std::optional<std::chrono::nanoseconds> {
+            ++runs;
+            run_time = time;
+            return std::nullopt;
+        });
+
+    core_timing.SyncPause(true);
+
+    const s64 start = core_timing.GetGlobalTimeNs().count();
+    core_timing.ScheduleEvent(std::chrono::microseconds{1}, event);
+    core_timing.UnscheduleEvent(event, Core::Timing::UnscheduleEventType::NoWait);
+
+    // Scheduling again starts counting the new generation only.
+    core_timing.ScheduleEvent(std::chrono::microseconds{100}, event);
+    REQUIRE(core_timing.HasPendingEvents());
+
+    core_timing.Pause(false);
+    while (core_timing.HasPendingEvents())
+        ;
+
+    // Only the instance scheduled after the unschedule runs.
+    REQUIRE(runs == 1);
+    REQUIRE(run_time >= start + 100'000);
+}
+
+TEST_CASE("CoreTiming[ClearPendingEvents]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::atomic<int> runs{};
+    const auto event = CreateCountingEvent(runs);
+
+    core_timing.SyncPause(true);
+
+    core_timing.ScheduleEvent(std::chrono::microseconds{1}, event);
+    core_timing.ScheduleEvent(std::chrono::microseconds{2}, event);
+    core_timing.ClearPendingEvents();
+    REQUIRE(!core_timing.HasPendingEvents());
+
+    // Events scheduled after clearing are still counted and run.
+    core_timing.ScheduleEvent(std::chrono::microseconds{1}, event);
+    REQUIRE(core_timing.HasPendingEvents());
+
+    core_timing.Pause(false);
+    while (core_timing.HasPendingEvents())
+        ;
+
+    REQUIRE(runs == 1);
+}
+
+TEST_CASE("CoreTiming[Contention]", "[.benchmark]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    core_timing.SyncPause(false);
+
+    constexpr std::size_t num_threads = 4;
+    constexpr std::size_t num_iterations = 100000;
+    constexpr std::size_t fired_interval = 16;
+    const auto callback = [](s64, std::chrono::nanoseconds) {
+        return std::optional<std::chrono::nanoseconds>{};
+    };
+
+    std::vector<std::shared_ptr<Core::Timing::EventType>> timeouts;
+    std::vector<std::shared_ptr<Core::Timing::EventType>> wakeups;
+    for (std::size_t i = 0; i < num_threads; i++) {
+        timeouts.push_back(Core::Timing::CreateEvent("timeout", callback));
+        wakeups.push_back(Core::Timing::CreateEvent("wakeup", callback));
+    }
+
+    const u64 start = core_timing.GetGlobalTimeNs().count();
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t i = 0; i < num_threads; i++) {
+            threads.emplace_back([&, i] {
+                for (std::size_t j = 0; j < num_iterations; j++) {
+                    // Most timeouts are cancelled long before they expire, some events do run.
+                    core_timing.ScheduleEvent(std::chrono::seconds{1}, timeouts[i]);
+                    core_timing.UnscheduleEvent(timeouts[i],
+                                                Core::Timing::UnscheduleEventType::NoWait);
+                    if (j % fired_interval == 0) {
+                        core_timing.ScheduleEvent(std::chrono::microseconds{10}, wakeups[i]);
+                    }
+                }
+            });
+        }
+    }
+    const u64 end = core_timing.GetGlobalTimeNs().count();
+
+    while (core_timing.HasPendingEvents())
+        ;
+
+    const double operations = static_cast<double>(num_threads * num_iterations * 2);
+    printf("HostTimer Contention: %zu threads, %.1f ns per schedule or unschedule\n", num_threads,
+           static_cast<double>(end - start) / operations);
+}
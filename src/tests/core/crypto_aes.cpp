@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <mbedtls/cipher.h>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_kernels.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+namespace {
+using namespace Core::Crypto;
+
+// NIST SP 800-38A, F.5.1 CTR-AES128.Encrypt
+constexpr std::array<u8, 16> CTR_KEY{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                     0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+constexpr std::array<u8, 16> CTR_COUNTER{0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                                         0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+constexpr std::array<u8, 64> CTR_PLAINTEXT{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73,
+    0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7,
+    0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4,
+    0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45,
+    0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+};
+constexpr std::array<u8, 64> CTR_CIPHERTEXT{
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99,
+    0x0d, 0xb6, 0xce, 0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17,
+    0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff, 0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3,
+    0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab, 0x1e, 0x03, 0x1d, 0xda,
+    0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee,
+};
+
+// Counter whose low 64-bit word overflows into the high word after three blocks.
+constexpr std::array<u8, 16> CARRY_COUNTER{0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+                                           0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd};
+
+// IEEE 1619-2007, XTS-AES-128 vector 2
+constexpr std::array<u8, 32> XTS_CIPHERTEXT{
+    0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+    0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0,
+};
+
+std::vector<u8> RandomBytes(std::mt19937& rng, size_t size) {
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+
+// Reference CTR transform of mbedtls, whose counter spans all 128 bits.
+std::vector<u8> MbedtlsCtr(const std::array<u8, 16>& key, const std::array<u8, 16>& counter,
+                           const std::vector<u8>& data) {
+    mbedtls_cipher_context_t context;
+    mbedtls_cipher_init(&context);
+    mbedtls_cipher_setup(&context, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_CTR));
+    mbedtls_cipher_setkey(&context, key.data(), 128, MBEDTLS_ENCRYPT);
+    mbedtls_cipher_set_iv(&context, counter.data(), counter.size());
+    mbedtls_cipher_reset(&context);
+
+    std::vector<u8> result(data.size());
+    size_t written;
+    mbedtls_cipher_update(&context, data.data(), data.size(), result.data(), &written);
+    mbedtls_cipher_free(&context);
+    return result;
+}
+
+template <typename Func>
+double MeasureGBps(size_t size, Func&& func) {
+    constexpr int iterations = 32;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(size) * iterations / elapsed.count() / 1e9;
+}
+} // Anonymous namespace
+
+TEST_CASE("CryptoAes: CTR kernel", "[core]") {
+    const AesKernels* const kernels = GetAesKernels();
+    if (kernels == nullptr) {
+        // Nothing to test, the host has no AES instructions.
+        return;
+    }
+
+    AesRoundKeys keys;
+    ExpandAesKey(keys, CTR_KEY.data(), CTR_KEY.size());
+
+    // Every length up to the reference, partial blocks included.
+    for (size_t size = 1; size <= CTR_PLAINTEXT.size(); ++size) {
+        std::array<u8, 16> counter = CTR_COUNTER;
+        std::array<u8, 64> result{};
+        kernels->ctr(keys, counter.data(), CTR_PLAINTEXT.data(), size, result.data());
+        REQUIRE(std::equal(result.begin(), result.begin() + size, CTR_CIPHERTEXT.begin()));
+    }
+
+    // A long run through the bulk path matches block by block calls.
+    std::mt19937 rng{1234};
+    const std::vector<u8> data = RandomBytes(rng, 16 * 37);
+    std::array<u8, 16> bulk_counter = CTR_COUNTER;
+    std::array<u8, 16> block_counter = CTR_COUNTER;
+    std::vector<u8> bulk(data.size());
+    std::vector<u8> blocks(data.size());
+    kernels->ctr(keys, bulk_counter.data(), data.data(), data.size(), bulk.data());
+    for (size_t offset = 0; offset < data.size(); offset += 16) {
+        kernels->ctr(keys, block_counter.data(), data.data() + offset, 16, blocks.data() + offset);
+    }
+    REQUIRE(bulk == blocks);
+    REQUIRE(bulk_counter == block_counter);
+}
+
+TEST_CASE("CryptoAes: CTR kernel counter carry", "[core]") {
+    const AesKernels* const kernels = GetAesKernels();
+    if (kernels == nullptr) {
+        // Nothing to test, the host has no AES instructions.
+        return;
+    }
+
+    AesRoundKeys keys;
+    ExpandAesKey(keys, CTR_KEY.data(), CTR_KEY.size());
+
+    // The low counter word overflows inside the bulk path.
+    std::mt19937 rng{4321};
+    const std::vector<u8> data = RandomBytes(rng, 16 * 37);
+    std::array<u8, 16> counter = CARRY_COUNTER;
+    std::vector<u8> result(data.size());
+    kernels->ctr(keys, counter.data(), data.data(), data.size(), result.data());
+    REQUIRE(result == MbedtlsCtr(CTR_KEY, CARRY_COUNTER, data));
+
+    // The carry reached the high word, and the low word counted the 37 blocks from the overflow.
+    constexpr std::array<u8, 16> expected_counter{0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+                                                  0xcd, 0xf0, 0x00, 0x00, 0x00, 0x00,
+                                                  0x00, 0x00, 0x00, 0x22};
+    REQUIRE(counter == expected_counter);
+}
+
+TEST_CASE("CryptoAes: AESCipher CTR", "[core]") {
+    // Uses the kernels when the host has AES instructions, mbedtls otherwise.
+    std::mt19937 rng{8765};
+    const std::vector<u8> data = RandomBytes(rng, 16 * 37 + 5);
+    const std::vector<u8> expected = MbedtlsCtr(CTR_KEY, CARRY_COUNTER, data);
+
+    AESCipher<Key128> cipher(CTR_KEY, Mode::CTR);
+    cipher.SetIV(CARRY_COUNTER);
+    std::vector<u8> result(data.size());
+    cipher.Transcode(data.data(), data.size(), result.data(), Op::Decrypt);
+    REQUIRE(result == expected);
+
+    // The counter continues across calls, the first one ends past the overflow.
+    cipher.SetIV(CARRY_COUNTER);
+    std::fill(result.begin(), result.end(), u8{0});
+    constexpr size_t split = 16 * 20;
+    cipher.Transcode(data.data(), split, result.data(), Op::Decrypt);
+    cipher.Transcode(data.data() + split, data.size() - split, result.data() + split, Op::Decrypt);
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("CryptoAes: XTS kernels", "[core]") {
+    const AesKernels* const kernels = GetAesKernels();
+    if (kernels == nullptr) {
+        // Nothing to test, the host has no AES instructions.
+        return;
+    }
+
+    std::array<u8, 16> data_key;
+    std::array<u8, 16> tweak_key;
+    std::array<u8, 16> iv{};
+    data_key.fill(0x11);
+    tweak_key.fill(0x22);
+    std::fill_n(iv.begin(), 5, u8{0x33});
+
+    AesRoundKeys data_keys;
+    AesRoundKeys tweak_keys;
+    ExpandAesKey(data_keys, data_key.data(), data_key.size());
+    ExpandAesKey(tweak_keys, tweak_key.data(), tweak_key.size());
+
+    std::array<u8, 32> plaintext;
+    plaintext.fill(0x44);
+    std::array<u8, 32> result;
+    kernels->xts_encrypt(data_keys, tweak_keys, iv.data(), plaintext.data(), plaintext.size(),
+                         result.data());
+    REQUIRE(result == XTS_CIPHERTEXT);
+    kernels->xts_decrypt(data_keys, tweak_keys, iv.data(), XTS_CIPHERTEXT.data(),
+                         XTS_CIPHERTEXT.size(), result.data());
+    REQUIRE(result == plaintext);
+
+    // A whole NCA sector through the bulk path.
+    std::mt19937 rng{5678};
+    const std::vector<u8> sector = RandomBytes(rng, 0x200);
+    std::vector<u8> encrypted(sector.size());
+    std::vector<u8> decrypted(sector.size());
+    kernels->xts_encrypt(data_keys, tweak_keys, iv.data(), sector.data(), sector.size(),
+                         encrypted.data());
+    kernels->xts_decrypt(data_keys, tweak_keys, iv.data(), encrypted.data(), encrypted.size(),
+                         decrypted.data());
+    REQUIRE(encrypted != sector);
+    REQUIRE(decrypted == sector);
+}
+
+TEST_CASE("CryptoAes: Benchmark", "[.benchmark]") {
+    const AesKernels* const kernels = GetAesKernels();
+    if (kernels == nullptr) {
+        // Nothing to test, the host has no AES instructions.
+        return;
+    }
+
+    constexpr size_t size = 16 * 1024 * 1024;
+    constexpr size_t sector_size = 0x200;
+    std::mt19937 rng{9012};
+    const std::vector<u8> source = RandomBytes(rng, size);
+    std::vector<u8> dest(size);
+
+    AesRoundKeys keys;
+    AesRoundKeys tweak_keys;
+    ExpandAesKey(keys, CTR_KEY.data(), CTR_KEY.size());
+    ExpandAesKey(tweak_keys, CTR_COUNTER.data(), CTR_COUNTER.size());
+
+    const double kernel_ctr = MeasureGBps(size, [&] {
+        std::array<u8, 16> counter = CTR_COUNTER;
+        kernels->ctr(keys, counter.data(), source.data(), size, dest.data());
+    });
+    const double kernel_xts = MeasureGBps(size, [&] {
+        for (size_t offset = 0; offset < size; offset += sector_size) {
+            kernels->xts_decrypt(keys, tweak_keys, CTR_COUNTER.data(), source.data() + offset,
+                                 sector_size, dest.data() + offset);
+        }
+    });
+
+    mbedtls_cipher_context_t ctr_context;
+    mbedtls_cipher_context_t xts_context;
+    mbedtls_cipher_init(&ctr_context);
+    mbedtls_cipher_init(&xts_context);
+    mbedtls_cipher_setup(&ctr_context, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_CTR));
+    mbedtls_cipher_setup(&xts_context, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_XTS));
+    std::array<u8, 32> xts_key;
+    std::copy(CTR_KEY.begin(), CTR_KEY.end(), xts_key.begin());
+    std::copy(CTR_COUNTER.begin(), CTR_COUNTER.end(), xts_key.begin() + 16);
+    mbedtls_cipher_setkey(&ctr_context, CTR_KEY.data(), 128, MBEDTLS_DECRYPT);
+    mbedtls_cipher_setkey(&xts_context, xts_key.data(), 256, MBEDTLS_DECRYPT);
+
+    size_t written;
+    const double mbedtls_ctr = MeasureGBps(size, [&] {
+        mbedtls_cipher_set_iv(&ctr_context, CTR_COUNTER.data(), CTR_COUNTER.size());
+        mbedtls_cipher_reset(&ctr_context);
+        mbedtls_cipher_update(&ctr_context, source.data(), size, dest.data(), &written);
+    });
+    const double mbedtls_xts = MeasureGBps(size, [&] {
+        for (size_t offset = 0; offset < size; offset += sector_size) {
+            mbedtls_cipher_set_iv(&xts_context, CTR_COUNTER.data(), CTR_COUNTER.size());
+            mbedtls_cipher_reset(&xts_context);
+            mbedtls_cipher_update(&xts_context, source.data() + offset, sector_size,
+                                  dest.data() + offset, &written);
+        }
+    });
+
+    mbedtls_cipher_free(&ctr_context);
+    mbedtls_cipher_free(&xts_context);
+
+    std::printf("AES-128-CTR: %s %.2f GB/s, mbedtls %.2f GB/s\n", kernels->name, kernel_ctr,
+                mbedtls_ctr);
+    std::printf("AES-128-XTS: %s %.2f GB/s, mbedtls %.2f GB/s\n", kernels->name, kernel_xts,
+                mbedtls_xts);
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/device_memory_manager.h"
+
+namespace {
+using Core::DEVICE_PAGESIZE;
+
+using Range = std::pair<DAddr, size_t>;
+
+constexpr VAddr CpuBase = 0x10000;
+
+struct Group {
+    DAddr lock_begin;
+    DAddr lock_end;
+    size_t first;
+    size_t last;
+
+    bool operator==(const Group&) const = default;
+};
+
+struct Mark {
+    size_t asid;
+    VAddr address;
+    size_t size;
+    bool cached;
+
+    bool operator==(const Mark&) const = default;
+};
+
+std::vector<Group> GroupsOf(const std::vector<Range>& ranges) {
+    std::vector<Group> groups;
+    Core::ForEachCachedRangeGroup(ranges, [&groups](const Core::CachedRangeGroup& group) {
+        groups.push_back({group.lock_begin, group.lock_end, group.first, group.last});
+    });
+    return groups;
+}
+
+// Device pages backed by consecutive CPU pages, in the process given for each of them.
+class PageCounters {
+public:
+    explicit PageCounters(std::vector<size_t> asids_) : asids{std::move(asids_)} {}
+
+    std::vector<Mark> Update(const std::vector<Range>& ranges, s32 delta) {
+        std::vector<Mark> marks;
+        Core::UpdateCachedPageCounters(
+            ranges, delta, [this](size_t page) -> std::atomic_uint8_t& { return counters[page]; },
+            [this](size_t page) {
+                return std::pair{Core::Asid{asids[page]}, CpuBase + page * DEVICE_PAGESIZE};
+            },
+            [&marks](Core::Asid asid, VAddr address, size_t size, bool cached) {
+                marks.push_back({asid.id, address, size, cached});
+            });
+        return marks;
+    }
+
+    u8 Count(size_t page) const {
+        return counters[page].load();
+    }
+
+private:
+    std::vector<size_t> asids;
+    std::array<std::atomic_uint8_t, 16> counters{};
+};
+
+VAddr CpuAddress(size_t page) {
+    return CpuBase + page * DEVICE_PAGESIZE;
+}
+} // Anonymous namespace
+
+TEST_CASE("DeviceMemoryManager: Groups ranges sharing or touching pages", "[core]") {
+    // Ranges within the same page, and ranges ending where the next one starts.
+    REQUIRE(GroupsOf({{0x1100, 0x10}, {0x1f00, 0x10}}) ==
+            std::vector<Group>{{0x1000, 0x2000, 0, 2}});
+    REQUIRE(GroupsOf({{0x1000, 0x800}, {0x1800, 0x800}, {0x2000, 0x1000}}) ==
+            std::vector<Group>{{0x1000, 0x3000, 0, 3}});
+    // A range starting on the page following the end of the previous one touches it.
+    REQUIRE(GroupsOf({{0x1000, 0x10}, {0x2000, 0x10}}) ==
+            std::vector<Group>{{0x1000, 0x3000, 0, 2}});
+    // A gap of a page splits the groups.
+    REQUIRE(GroupsOf({{0x1000, 0x1000}, {0x3000, 0x10}}) ==
+            std::vector<Group>{{0x1000, 0x2000, 0, 1}, {0x3000, 0x4000, 1, 2}});
+    // A range inside an earlier and larger one does not shrink the group.
+    REQUIRE(GroupsOf({{0x1000, 0x4000}, {0x2000, 0x10}, {0x5000, 0x10}}) ==
+            std::vector<Group>{{0x1000, 0x6000, 0, 3}});
+}
+
+TEST_CASE("DeviceMemoryManager: Overlapping ranges apply their delta twice", "[core]") {
+    const std::vector<Range> ranges{{1 * DEVICE_PAGESIZE, 2 * DEVICE_PAGESIZE},
+                                    {2 * DEVICE_PAGESIZE, 2 * DEVICE_PAGESIZE}};
+    REQUIRE(GroupsOf(ranges).size() == 1);
+
+    PageCounters counters{std::vector<size_t>(16, 0)};
+    REQUIRE(counters.Update(ranges, 1) ==
+            std::vector<Mark>{{0, CpuAddress(1), 2 * DEVICE_PAGESIZE, true},
+                              {0, CpuAddress(3), DEVICE_PAGESIZE, true}});
+    REQUIRE(counters.Count(1) == 1);
+    REQUIRE(counters.Count(2) == 2);
+    REQUIRE(counters.Count(3) == 1);
+
+    // The shared page is only uncached once both ranges released it.
+    REQUIRE(counters.Update(ranges, -1) ==
+            std::vector<Mark>{{0, CpuAddress(1), DEVICE_PAGESIZE, false},
+                              {0, CpuAddress(2), 2 * DEVICE_PAGESIZE, false}});
+    for (size_t page = 1; page <= 3; ++page) {
+        REQUIRE(counters.Count(page) == 0);
+    }
+}
+
+TEST_CASE("DeviceMemoryManager: Runs of touching ranges are marked once", "[core]") {
+    const std::vector<Range> ranges{{1 * DEVICE_PAGESIZE, 2 * DEVICE_PAGESIZE},
+                                    {3 * DEVICE_PAGESIZE, 2 * DEVICE_PAGESIZE}};
+    PageCounters counters{std::vector<size_t>(16, 0)};
+    REQUIRE(counters.Update(ranges, 1) ==
+            std::vector<Mark>{{0, CpuAddress(1), 4 * DEVICE_PAGESIZE, true}});
+    REQUIRE(counters.Update(ranges, -1) ==
+            std::vector<Mark>{{0, CpuAddress(1), 4 * DEVICE_PAGESIZE, false}});
+}
+
+TEST_CASE("DeviceMemoryManager: Process switches within a group split the runs", "[core]") {
+    // Pages 4 and 5 belong to the first process, 6 to the second and 7 to the first again.
+    std::vector<size_t> asids(16, 0);
+    asids[6] = 1;
+    const std::vector<Range> ranges{{4 * DEVICE_PAGESIZE, 2 * DEVICE_PAGESIZE},
+                                    {6 * DEVICE_PAGESIZE, 2 * DEVICE_PAGESIZE}};
+    REQUIRE(GroupsOf(ranges).size() == 1);
+
+    PageCounters counters{asids};
+    REQUIRE(counters.Update(ranges, 1) ==
+            std::vector<Mark>{{0, CpuAddress(4), 2 * DEVICE_PAGESIZE, true},
+                              {1, CpuAddress(6), DEVICE_PAGESIZE, true},
+                              {0, CpuAddress(7), DEVICE_PAGESIZE, true}});
+    REQUIRE(counters.Update(ranges, -1) ==
+            std::vector<Mark>{{0, CpuAddress(4), 2 * DEVICE_PAGESIZE, false},
+                              {1, CpuAddress(6), DEVICE_PAGESIZE, false},
+                              {0, CpuAddress(7), DEVICE_PAGESIZE, false}});
+}
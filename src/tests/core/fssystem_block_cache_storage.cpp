@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+namespace {
+using FileSys::BlockCacheStorage;
+
+constexpr size_t BlockSize = BlockCacheStorage::BlockSize;
+
+// Reads of a block that stop short of its end never continue the previous read, so they don't
+// queue read-aheads.
+constexpr size_t PartialBlockSize = BlockSize - 1;
+
+u8 PatternByte(size_t offset) {
+    return static_cast<u8>(offset * 7 + offset / BlockSize);
+}
+
+std::vector<u8> MakePattern(size_t num_blocks) {
+    std::vector<u8> data(num_blocks * BlockSize);
+    for (size_t offset = 0; offset < data.size(); ++offset) {
+        data[offset] = PatternByte(offset);
+    }
+    return data;
+}
+
+// Counts the reads reaching the base storage, and holds the reads past the first block until
+// the gate is opened.
+class CountingFile final : public FileSys::VectorVfsFile {
+public:
+    explicit CountingFile(std::vector<u8> data, bool gated = false)
+        : FileSys::VectorVfsFile(std::move(data)), is_open{!gated} {}
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        {
+            std::unique_lock lk{mutex};
+            ++num_reads;
+            if (offset >= BlockSize) {
+                ++num_waiting;
+                cv.notify_all();
+                cv.wait(lk, [this] { return is_open; });
+                --num_waiting;
+            }
+        }
+        return FileSys::VectorVfsFile::Read(data, length, offset);
+    }
+
+    size_t NumReads() const {
+        std::scoped_lock lk{mutex};
+        return num_reads;
+    }
+
+    bool WaitForBlockedRead() const {
+        std::unique_lock lk{mutex};
+        return cv.wait_for(lk, std::chrono::seconds{5}, [this] { return num_waiting > 0; });
+    }
+
+    void Open() {
+        {
+            std::scoped_lock lk{mutex};
+            is_open = true;
+        }
+        cv.notify_all();
+    }
+
+private:
+    mutable std::mutex mutex;
+    mutable std::condition_variable cv;
+    mutable size_t num_reads = 0;
+    mutable size_t num_waiting = 0;
+    bool is_open;
+};
+
+// Restores the cache size changed by a test.
+struct CacheSizeScope {
+    explicit CacheSizeScope(u16 size_mib)
+        : previous{Settings::values.fs_block_cache_size.GetValue()} {
+        Settings::values.fs_block_cache_size.SetValue(size_mib);
+    }
+    ~CacheSizeScope() {
+        Settings::values.fs_block_cache_size.SetValue(previous);
+    }
+    u16 previous;
+};
+
+// Reads a block, returns whether the base storage was read.
+bool ReadBlock(const BlockCacheStorage& storage, const CountingFile& file, size_t block_index) {
+    std::vector<u8> buffer(PartialBlockSize);
+    const size_t reads = file.NumReads();
+    REQUIRE(storage.Read(buffer.data(), buffer.size(), block_index * BlockSize) == buffer.size());
+    bool matches = true;
+    for (size_t offset = 0; offset < buffer.size() && matches; ++offset) {
+        matches = buffer[offset] == PatternByte(block_index * BlockSize + offset);
+    }
+    REQUIRE(matches);
+    return file.NumReads() != reads;
+}
+
+bool WaitForReadAheads(u64 count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (FileSys::GetBlockCacheStatistics().read_ahead_blocks < count) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
+} // Anonymous namespace
+
+TEST_CASE("BlockCacheStorage: Evicts the least recently used block", "[core]") {
+    // Enough blocks for two of them to share the shard of the first with near certainty
+    static constexpr size_t NumBlocks = 256;
+    const auto file = std::make_shared<CountingFile>(MakePattern(NumBlocks));
+    const BlockCacheStorage storage(file);
+
+    // With one block per shard, a block read after A evicts it when they share a shard.
+    std::optional<CacheSizeScope> cache_size{std::in_place, u16{1}};
+    constexpr size_t block_a = 1;
+    std::vector<size_t> same_shard;
+    REQUIRE(ReadBlock(storage, *file, block_a));
+    for (size_t block = block_a + 1; block < NumBlocks && same_shard.size() < 2; ++block) {
+        REQUIRE(ReadBlock(storage, *file, block));
+        if (ReadBlock(storage, *file, block_a)) {
+            same_shard.push_back(block);
+        }
+    }
+    REQUIRE(same_shard.size() == 2);
+    const size_t block_b = same_shard[0];
+    const size_t block_c = same_shard[1];
+
+    // Two blocks per shard: A is cached, B joins it, and A is touched so B becomes the oldest.
+    cache_size.reset();
+    cache_size.emplace(u16{2});
+    const u64 evictions = FileSys::GetBlockCacheStatistics().evictions;
+    REQUIRE(ReadBlock(storage, *file, block_b));
+    REQUIRE_FALSE(ReadBlock(storage, *file, block_a));
+    REQUIRE(ReadBlock(storage, *file, block_c));
+    REQUIRE(FileSys::GetBlockCacheStatistics().evictions == evictions + 1);
+
+    REQUIRE_FALSE(ReadBlock(storage, *file, block_a));
+    REQUIRE_FALSE(ReadBlock(storage, *file, block_c));
+    REQUIRE(ReadBlock(storage, *file, block_b));
+}
+
+TEST_CASE("BlockCacheStorage: Sequential reads hit the read-ahead blocks", "[core]") {
+    static constexpr size_t NumBlocks = 16;
+    static constexpr size_t ReadAheadCount = BlockCacheStorage::ReadAheadBlockCount;
+    const CacheSizeScope cache_size{64};
+    const auto file = std::make_shared<CountingFile>(MakePattern(NumBlocks));
+    const BlockCacheStorage storage(file);
+    const auto before = FileSys::GetBlockCacheStatistics();
+
+    // The first read starts where the previous one ended, queueing the following blocks. It
+    // stops short of its block like the reads below, which are then not sequential to it.
+    REQUIRE(ReadBlock(storage, *file, 0));
+    REQUIRE(WaitForReadAheads(before.read_ahead_blocks + ReadAheadCount));
+    REQUIRE(file->NumReads() == 1 + ReadAheadCount);
+
+    const auto warm = FileSys::GetBlockCacheStatistics();
+    for (size_t block = 1; block <= ReadAheadCount; ++block) {
+        REQUIRE_FALSE(ReadBlock(storage, *file, block));
+    }
+    const auto after = FileSys::GetBlockCacheStatistics();
+    REQUIRE(after.hits == warm.hits + ReadAheadCount);
+    REQUIRE(after.misses == warm.misses);
+}
+
+TEST_CASE("BlockCacheStorage: Invalidation drops in-flight read-aheads", "[core]") {
+    static constexpr size_t NumBlocks = 16;
+    const CacheSizeScope cache_size{64};
+    const u64 cached_size = FileSys::GetBlockCacheStatistics().cached_size;
+
+    // The read-aheads of the blocker hold the worker inside its base storage.
+    const auto blocker_file = std::make_shared<CountingFile>(MakePattern(NumBlocks), true);
+    auto blocker = std::make_unique<BlockCacheStorage>(blocker_file);
+    SCOPE_EXIT {
+        blocker_file->Open();
+    };
+    std::vector<u8> buffer(BlockSize);
+    REQUIRE(blocker->Read(buffer.data(), buffer.size(), 0) == buffer.size());
+    REQUIRE(blocker_file->WaitForBlockedRead());
+
+    // Read-aheads queued behind it are dropped once their storage is destroyed.
+    const auto file = std::make_shared<CountingFile>(MakePattern(NumBlocks));
+    auto storage = std::make_unique<BlockCacheStorage>(file);
+    REQUIRE(storage->Read(buffer.data(), buffer.size(), 0) == buffer.size());
+    storage.reset();
+
+    // The read in flight finishes after the blocker is destroyed, its block must not stay.
+    std::thread destroyer{[&blocker] { blocker.reset(); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    blocker_file->Open();
+    destroyer.join();
+    const size_t blocker_reads = blocker_file->NumReads();
+
+    // The worker serves requests in order, so once a later storage got its read-ahead the
+    // requests of the destroyed ones were all handled.
+    {
+        const auto marker_file = std::make_shared<CountingFile>(MakePattern(2));
+        const BlockCacheStorage marker(marker_file);
+        const u64 read_ahead_blocks = FileSys::GetBlockCacheStatistics().read_ahead_blocks;
+        REQUIRE(marker.Read(buffer.data(), buffer.size(), 0) == buffer.size());
+        REQUIRE(WaitForReadAheads(read_ahead_blocks + 1));
+    }
+
+    REQUIRE(file->NumReads() == 1);
+    REQUIRE(blocker_file->NumReads() == blocker_reads);
+    REQUIRE(FileSys::GetBlockCacheStatistics().cached_size == cached_size);
+}
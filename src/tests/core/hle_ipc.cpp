@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/k_client_session.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_scoped_resource_reservation.h"
+#include "core/hle/kernel/k_server_session.h"
+#include "core/hle/kernel/k_session.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/svc_common.h"
+#include "core/hle/service/hle_ipc.h"
+#include "core/hle/service/ipc_helpers.h"
+#include "core/hle/service/server_manager.h"
+#include "core/hle/service/service.h"
+#include "core/memory.h"
+
+namespace {
+
+class PingService final : public Service::ServiceFramework<PingService> {
+public:
+    explicit PingService(Core::System& system_) : ServiceFramework{system_, "ping"} {
+        static const FunctionInfo functions[] = {
+            {0, &PingService::Ping, "Ping"},
+        };
+        RegisterHandlers(functions);
+    }
+
+private:
+    void Ping(Service::HLERequestContext& ctx) {
+        IPC::ResponseBuilder rb{ctx, 2};
+        rb.Push(ResultSuccess);
+    }
+};
+
+// CMIF request of the Ping command, without arguments.
+std::array<u32, 8> MakePingRequest() {
+    std::array<u32, 8> request{};
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    header.data_size.Assign(8);
+    request[0] = header.raw_low;
+    request[1] = header.raw_high;
+    request[4] = Common::MakeMagic('S', 'F', 'C', 'I');
+    return request;
+}
+
+// Process of the client thread, with a heap holding its message buffer.
+struct ClientProcess {
+    explicit ClientProcess(Kernel::KernelCore& kernel) {
+        process = Kernel::KProcess::Create(kernel);
+        Kernel::KProcess::Register(kernel, process);
+        REQUIRE(process
+                    ->LoadFromMetadata(FileSys::ProgramMetadata::GetDefault(), Kernel::PageSize,
+                                       0, false)
+                    .IsSuccess());
+        auto& page_table = process->GetPageTable();
+        Kernel::KProcessAddress heap_address{};
+        REQUIRE(page_table.SetMaxHeapSize(Kernel::Svc::HeapSizeAlignment).IsSuccess());
+        REQUIRE(page_table.SetHeapSize(&heap_address, Kernel::Svc::HeapSizeAlignment).IsSuccess());
+        message = GetInteger(heap_address);
+    }
+
+    ~ClientProcess() {
+        process->Close();
+    }
+
+    Kernel::KProcess* process;
+    u64 message;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("HLE IPC: Sync request round trip", "[.benchmark]") {
+    constexpr size_t NumWarmup = 1000;
+    constexpr size_t NumRequests = 100000;
+    constexpr size_t MessageSize = 0x100;
+
+    Core::System system;
+    system.Initialize();
+    system.InitializeKernel();
+    SCOPE_EXIT {
+        system.ShutdownMainProcess();
+    };
+    auto& kernel = system.Kernel();
+
+    // The server side is served like any HLE service, by a server manager in its own process.
+    auto* session = Kernel::KSession::Create(kernel);
+    session->Initialize(nullptr, 0);
+    Kernel::KSession::Register(kernel, session);
+    {
+        auto server_manager = std::make_unique<Service::ServerManager>(system);
+        auto manager = std::make_shared<Service::SessionRequestManager>(kernel, *server_manager);
+        manager->SetSessionHandler(std::make_shared<PingService>(system));
+        REQUIRE(server_manager->RegisterSession(&session->GetServerSession(), std::move(manager))
+                    .IsSuccess());
+        kernel
+            .RunOnHostCoreProcess("PingServer",
+                                  [server = server_manager.release()] {
+                                      Service::ServerManager::RunServer(
+                                          std::unique_ptr<Service::ServerManager>{server});
+                                  })
+            .detach();
+    }
+
+    // The client is a host thread of a process, sending its requests from a heap buffer.
+    ClientProcess client{kernel};
+    Kernel::KScopedResourceReservation thread_reservation(
+        client.process, Kernel::LimitableResource::ThreadCountMax);
+    REQUIRE(thread_reservation.Succeeded());
+    auto* thread = Kernel::KThread::Create(kernel);
+    REQUIRE(Kernel::KThread::InitializeDummyThread(thread, client.process).IsSuccess());
+    thread_reservation.Commit();
+    Kernel::KThread::Register(kernel, thread);
+
+    const auto request = MakePingRequest();
+    auto& memory = client.process->GetMemory();
+    auto& client_session = session->GetClientSession();
+    std::vector<s64> latencies(NumRequests);
+    bool succeeded = true;
+    std::thread{[&] {
+        kernel.RegisterHostThread(thread);
+        for (size_t i = 0; i < NumWarmup + NumRequests && succeeded; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            memory.WriteBlock(client.message, request.data(), sizeof(request));
+            succeeded = client_session.SendSyncRequest(client.message, MessageSize).IsSuccess();
+            const auto end = std::chrono::steady_clock::now();
+            if (i >= NumWarmup) {
+                latencies[i - NumWarmup] =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            }
+        }
+        // The server destroys the session once the client is closed.
+        client_session.Close();
+        thread->Close();
+    }}.join();
+    REQUIRE(succeeded);
+
+    std::ranges::sort(latencies);
+    s64 total = 0;
+    for (const s64 latency : latencies) {
+        total += latency;
+    }
+    printf("HLE IPC round trip: mean %lld ns, median %lld ns, 99th percentile %lld ns\n",
+           static_cast<long long>(total / static_cast<s64>(NumRequests)),
+           static_cast<long long>(latencies[NumRequests / 2]),
+           static_cast<long long>(latencies[NumRequests * 99 / 100]));
+}
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <mbedtls/sha256.h>
+
+#include "common/common_types.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+namespace {
+using FileSys::InstallJob;
+using FileSys::InstallOptions;
+using FileSys::InstallResult;
+
+// Larger than a few chunks of the install pipeline, and not a multiple of them.
+constexpr size_t NcaSize = 10 * 1024 * 1024 + 123;
+
+std::vector<u8> MakeNca(u8 seed) {
+    std::vector<u8> data(NcaSize);
+    for (size_t offset = 0; offset < data.size(); ++offset) {
+        data[offset] = static_cast<u8>(offset * 13 + offset / 4096 + seed);
+    }
+    return data;
+}
+
+Core::Crypto::SHA256Hash HashOf(const std::vector<u8>& data) {
+    Core::Crypto::SHA256Hash hash;
+    mbedtls_sha256_ret(data.data(), data.size(), hash.data(), 0);
+    return hash;
+}
+
+// Holds the reads past the start of the file until the gate is opened.
+class GatedFile final : public FileSys::VectorVfsFile {
+public:
+    explicit GatedFile(std::vector<u8> data) : FileSys::VectorVfsFile(std::move(data)) {}
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        if (offset > 0) {
+            std::unique_lock lk{mutex};
+            cv.wait(lk, [this] { return is_open; });
+        }
+        return FileSys::VectorVfsFile::Read(data, length, offset);
+    }
+
+    void Open() {
+        {
+            std::scoped_lock lk{mutex};
+            is_open = true;
+        }
+        cv.notify_all();
+    }
+
+private:
+    mutable std::mutex mutex;
+    mutable std::condition_variable cv;
+    bool is_open = false;
+};
+
+// Destination directory of the NCAs, with one empty file per job.
+struct InstallFixture {
+    void AddJob(FileSys::VirtualFile source, std::optional<Core::Crypto::SHA256Hash> hash) {
+        auto dest = std::make_shared<FileSys::VectorVfsFile>(
+            std::vector<u8>{}, fmt::format("{}.nca", jobs.size()), dir);
+        dir->AddFile(dest);
+        dests.push_back(dest);
+        jobs.push_back(InstallJob{
+            .source = std::move(source),
+            .dest = std::move(dest),
+            .expected_hash = hash,
+        });
+    }
+
+    std::shared_ptr<FileSys::VectorVfsDirectory> dir =
+        std::make_shared<FileSys::VectorVfsDirectory>();
+    std::vector<std::shared_ptr<FileSys::VectorVfsFile>> dests;
+    std::vector<InstallJob> jobs;
+};
+} // Anonymous namespace
+
+TEST_CASE("RunInstallJobs: Copies and verifies every NCA", "[core]") {
+    InstallFixture fixture;
+    std::vector<std::vector<u8>> ncas;
+    for (u8 seed = 0; seed < 3; ++seed) {
+        ncas.push_back(MakeNca(seed));
+        fixture.AddJob(std::make_shared<FileSys::VectorVfsFile>(ncas.back()),
+                       seed == 0 ? std::nullopt : std::optional{HashOf(ncas.back())});
+    }
+
+    FileSys::InstallProgress last_progress{};
+    const InstallOptions options{
+        .max_ncas_in_flight = 2,
+        .progress_callback =
+            [&last_progress](const FileSys::InstallProgress& progress) {
+                last_progress = progress;
+                return false;
+            },
+    };
+    REQUIRE(FileSys::RunInstallJobs(fixture.jobs, options) == InstallResult::Success);
+
+    REQUIRE(fixture.dir->GetFiles().size() == ncas.size());
+    for (size_t i = 0; i < ncas.size(); ++i) {
+        REQUIRE(fixture.dests[i]->ReadAllBytes() == ncas[i]);
+    }
+    REQUIRE(last_progress.total_size == ncas.size() * NcaSize);
+    REQUIRE(last_progress.processed_size == last_progress.total_size);
+}
+
+TEST_CASE("RunInstallJobs: A hash mismatch removes every NCA", "[core]") {
+    InstallFixture fixture;
+    const auto good = MakeNca(0);
+    auto corrupted = MakeNca(1);
+    const auto expected_hash = HashOf(corrupted);
+    corrupted[NcaSize / 2] ^= 1;
+    fixture.AddJob(std::make_shared<FileSys::VectorVfsFile>(good), HashOf(good));
+    fixture.AddJob(std::make_shared<FileSys::VectorVfsFile>(corrupted), expected_hash);
+
+    const InstallOptions options{.max_ncas_in_flight = 1};
+    REQUIRE(FileSys::RunInstallJobs(fixture.jobs, options) == InstallResult::ErrorHashMismatch);
+
+    // The NCA copied before the corrupted one goes too, the content would be incomplete.
+    REQUIRE(fixture.dir->GetFiles().empty());
+}
+
+TEST_CASE("RunInstallJobs: A failed read removes every NCA", "[core]") {
+    InstallFixture fixture;
+    // Fails the reads reaching past the middle of the file, like a damaged dump.
+    class DamagedFile final : public FileSys::VectorVfsFile {
+    public:
+        using FileSys::VectorVfsFile::VectorVfsFile;
+        std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+            if (offset + length > NcaSize / 2) {
+                return 0;
+            }
+            return FileSys::VectorVfsFile::Read(data, length, offset);
+        }
+    };
+    fixture.AddJob(std::make_shared<FileSys::VectorVfsFile>(MakeNca(0)), std::nullopt);
+    fixture.AddJob(std::make_shared<DamagedFile>(MakeNca(1)), std::nullopt);
+
+    const InstallOptions options{.max_ncas_in_flight = 2};
+    REQUIRE(FileSys::RunInstallJobs(fixture.jobs, options) == InstallResult::ErrorCopyFailed);
+    REQUIRE(fixture.dir->GetFiles().empty());
+}
+
+TEST_CASE("RunInstallJobs: Cancellation stops the copy mid-way", "[core]") {
+    InstallFixture fixture;
+    const auto source = std::make_shared<GatedFile>(MakeNca(0));
+    fixture.AddJob(source, std::nullopt);
+
+    // The first chunk is written while the next read waits on the gate. The cancellation is
+    // requested then, and the gate only opens on the following call, once it took effect.
+    bool cancel_requested = false;
+    FileSys::InstallProgress last_progress{};
+    const InstallOptions options{
+        .max_ncas_in_flight = 1,
+        .progress_callback =
+            [&](const FileSys::InstallProgress& progress) {
+                last_progress = progress;
+                if (cancel_requested) {
+                    source->Open();
+                } else {
+                    cancel_requested = progress.processed_size > 0;
+                }
+                return cancel_requested;
+            },
+    };
+    REQUIRE(FileSys::RunInstallJobs(fixture.jobs, options) == InstallResult::ErrorCancelled);
+
+    REQUIRE(last_progress.processed_size > 0);
+    REQUIRE(last_progress.processed_size < last_progress.total_size);
+    REQUIRE(fixture.dir->GetFiles().empty());
+}
@@ -1,9 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <chrono>
+#include <cstdio>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -38,6 +42,22 @@ public:
         }
     }
 
+    void UpdatePagesCachedBatch(std::span<const std::pair<DAddr, size_t>> ranges, int delta) {
+        ++num_batches;
+        num_ranges += ranges.size();
+        for (const auto& [addr, size] : ranges) {
+            UpdatePagesCachedCount(addr, size, delta);
+        }
+    }
+
+    [[nodiscard]] size_t NumBatches() const noexcept {
+        return num_batches;
+    }
+
+    [[nodiscard]] size_t NumRanges() const noexcept {
+        return num_ranges;
+    }
+
     [[nodiscard]] int Count(VAddr addr) const noexcept {
         const auto it = page_table.find(addr >> Core::DEVICE_PAGEBITS);
         return it == page_table.end() ? 0 : it->second;
@@ -53,6 +73,8 @@ public:
 
 private:
     std::unordered_map<u64, int> page_table;
+    size_t num_batches = 0;
+    size_t num_ranges = 0;
 };
 } // Anonymous namespace
 
@@ -546,3 +568,59 @@ TEST_CASE("MemoryTracker: Cached write downloads") {
     memory_track->MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("MemoryTracker: Batched tracker updates") {
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, WORD * 16);
+    REQUIRE(rasterizer.Count() == WORD * 16 / PAGE);
+    REQUIRE(rasterizer.NumBatches() == 1);
+    REQUIRE(rasterizer.NumRanges() == 1);
+
+    for (u64 page = 1; page < WORD * 2 / PAGE; page += 2) {
+        memory_track->MarkRegionAsCpuModified(c + page * PAGE, PAGE);
+    }
+    REQUIRE(rasterizer.Count() == WORD * 15 / PAGE);
+    const size_t num_batches = rasterizer.NumBatches();
+    const size_t num_ranges = rasterizer.NumRanges();
+    memory_track->UnmarkRegionAsCpuModified(c, WORD * 2);
+    REQUIRE(rasterizer.Count() == WORD * 16 / PAGE);
+    REQUIRE(rasterizer.NumBatches() == num_batches + 1);
+    REQUIRE(rasterizer.NumRanges() == num_ranges + WORD / PAGE);
+
+    memory_track->MarkRegionAsCpuModified(c, WORD * 16);
+    REQUIRE(rasterizer.Count() == 0);
+    REQUIRE(rasterizer.NumBatches() == num_batches + 2);
+    REQUIRE(rasterizer.NumRanges() == num_ranges + WORD / PAGE + 1);
+}
+
+TEST_CASE("MemoryTracker: Benchmark", "[.benchmark]") {
+    constexpr u64 size = WORD * 16;
+    constexpr int iterations = 64;
+    // Pages modified by the CPU between two uploads: whole, one in four, one in sixty-four
+    for (const u64 stride : {u64{1}, u64{4}, u64{64}}) {
+        RasterizerInterface rasterizer;
+        std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+        memory_track->UnmarkRegionAsCpuModified(c, size);
+
+        std::chrono::nanoseconds elapsed{};
+        size_t num_batches = 0;
+        size_t num_ranges = 0;
+        for (int i = 0; i < iterations; ++i) {
+            for (u64 page = 0; page < size / PAGE; page += stride) {
+                memory_track->MarkRegionAsCpuModified(c + page * PAGE, PAGE);
+            }
+            num_batches = rasterizer.NumBatches();
+            num_ranges = rasterizer.NumRanges();
+            const auto start = std::chrono::steady_clock::now();
+            memory_track->ForEachUploadRange(c, size, [](u64, u64) {});
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+        REQUIRE(rasterizer.Count() == size / PAGE);
+
+        std::printf("MemoryTracker: 1 in %llu pages, %zu batch, %zu ranges, %.1f us per upload\n",
+                    static_cast<unsigned long long>(stride), rasterizer.NumBatches() - num_batches,
+                    rasterizer.NumRanges() - num_ranges,
+                    static_cast<double>(elapsed.count()) / iterations / 1000.0);
+    }
+}
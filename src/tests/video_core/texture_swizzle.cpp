@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/decoders.h"
+#include "video_core/textures/swizzle_kernels.h"
+
+namespace {
+using namespace Tegra::Texture;
+
+constexpr SwizzleTable SWIZZLE_TABLE = MakeSwizzleTable();
+
+/// Straightforward block linear addressing, used as a reference for the optimized paths
+struct Layout {
+    u32 bytes_per_pixel;
+    u32 width;
+    u32 height;
+    u32 depth;
+    u32 block_height;
+    u32 block_depth;
+
+    [[nodiscard]] u32 GobsInX() const {
+        return Common::DivCeil(width * bytes_per_pixel, GOB_SIZE_X);
+    }
+
+    [[nodiscard]] u32 BlocksInY() const {
+        return Common::DivCeil(height, GOB_SIZE_Y << block_height);
+    }
+
+    [[nodiscard]] size_t SwizzledSize() const {
+        return CalculateSize(true, bytes_per_pixel, width, height, depth, block_height,
+                             block_depth);
+    }
+
+    [[nodiscard]] size_t Offset(u32 x_byte, u32 y, u32 z) const {
+        const u32 block_size = GOB_SIZE << (block_height + block_depth);
+        const u32 gob_x = x_byte / GOB_SIZE_X;
+        const u32 gob_y = y / GOB_SIZE_Y;
+        const u32 block_y = gob_y >> block_height;
+        const u32 block_z = z >> block_depth;
+        const u32 gob_in_block = ((z & ((1U << block_depth) - 1)) << block_height) |
+                                 (gob_y & ((1U << block_height) - 1));
+        const size_t block = (static_cast<size_t>(block_z) * BlocksInY() + block_y) * GobsInX() +
+                             gob_x;
+        return block * block_size + gob_in_block * GOB_SIZE +
+               SWIZZLE_TABLE[y % GOB_SIZE_Y][x_byte % GOB_SIZE_X];
+    }
+};
+
+std::vector<u8> RandomBytes(std::mt19937& rng, size_t size) {
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+
+constexpr std::array<u32, 5> BYTES_PER_PIXEL{1, 2, 4, 8, 16};
+constexpr std::array<u32, 7> WIDTHS{1, 7, 16, 63, 64, 100, 257};
+constexpr std::array<u32, 5> HEIGHTS{1, 5, 8, 33, 70};
+} // Anonymous namespace
+
+TEST_CASE("TextureSwizzle: Kernels match generic implementation", "[video_core]") {
+    std::mt19937 rng{1234};
+    const SwizzleKernels& generic = GetGenericSwizzleKernels();
+    const SwizzleKernels& host = GetSwizzleKernels();
+
+    constexpr u32 num_gobs = 5;
+    constexpr u32 gob_stride = GOB_SIZE << 2;
+    constexpr u32 pitch = GOB_SIZE_X * num_gobs + 48;
+    const std::vector<u8> swizzled = RandomBytes(rng, gob_stride * num_gobs);
+    const std::vector<u8> linear = RandomBytes(rng, pitch * GOB_SIZE_Y);
+
+    std::vector<u8> expected(linear.size());
+    std::vector<u8> result(linear.size());
+    generic.unswizzle_gobs(expected.data(), swizzled.data(), pitch, num_gobs, gob_stride);
+    host.unswizzle_gobs(result.data(), swizzled.data(), pitch, num_gobs, gob_stride);
+    REQUIRE(result == expected);
+
+    expected.assign(swizzled.size(), 0);
+    result.assign(swizzled.size(), 0);
+    generic.swizzle_gobs(expected.data(), linear.data(), pitch, num_gobs, gob_stride);
+    host.swizzle_gobs(result.data(), linear.data(), pitch, num_gobs, gob_stride);
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("TextureSwizzle: Whole texture", "[video_core]") {
+    std::mt19937 rng{5678};
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (const u32 width : WIDTHS) {
+            for (const u32 height : HEIGHTS) {
+                for (u32 block_height = 0; block_height < 4; ++block_height) {
+                    const u32 depth = height < 8 ? 3 : 1;
+                    const u32 block_depth = depth > 1 ? 1 : 0;
+                    const Layout layout{bytes_per_pixel, width,        height,
+                                        depth,           block_height, block_depth};
+                    const u32 pitch = width * bytes_per_pixel;
+                    const std::vector<u8> swizzled = RandomBytes(rng, layout.SwizzledSize());
+
+                    std::vector<u8> linear(static_cast<size_t>(pitch) * height * depth);
+                    UnswizzleTexture(linear, swizzled, bytes_per_pixel, width, height, depth,
+                                     block_height, block_depth);
+                    for (u32 z = 0; z < depth; ++z) {
+                        for (u32 y = 0; y < height; ++y) {
+                            for (u32 x = 0; x < pitch; ++x) {
+                                const size_t linear_offset = (z * height + y) * pitch + x;
+                                REQUIRE(linear[linear_offset] == swizzled[layout.Offset(x, y, z)]);
+                            }
+                        }
+                    }
+
+                    std::vector<u8> reswizzled(swizzled.size());
+                    SwizzleTexture(reswizzled, linear, bytes_per_pixel, width, height, depth,
+                                   block_height, block_depth);
+                    for (u32 z = 0; z < depth; ++z) {
+                        for (u32 y = 0; y < height; ++y) {
+                            for (u32 x = 0; x < pitch; ++x) {
+                                const size_t offset = layout.Offset(x, y, z);
+                                REQUIRE(reswizzled[offset] == swizzled[offset]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("TextureSwizzle: Subrect", "[video_core]") {
+    std::mt19937 rng{9012};
+    constexpr u32 width = 300;
+    constexpr u32 height = 90;
+    constexpr u32 block_height = 2;
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (const u32 origin_x : {0U, 3U, 64U, 70U}) {
+            for (const u32 origin_y : {0U, 5U, 16U}) {
+                const u32 extent_x = width - origin_x - 11;
+                const u32 extent_y = height - origin_y - 3;
+                const u32 pitch_linear = extent_x * bytes_per_pixel + 4;
+                const Layout layout{bytes_per_pixel, width, height, 1, block_height, 0};
+                const std::vector<u8> swizzled = RandomBytes(rng, layout.SwizzledSize());
+
+                std::vector<u8> linear(static_cast<size_t>(pitch_linear) * height);
+                UnswizzleSubrect(linear, swizzled, bytes_per_pixel, width, height, 1, origin_x,
+                                 origin_y, extent_x, extent_y, block_height, 0, pitch_linear);
+                for (u32 y = 0; y < extent_y; ++y) {
+                    for (u32 x = 0; x < extent_x * bytes_per_pixel; ++x) {
+                        const size_t offset =
+                            layout.Offset(origin_x * bytes_per_pixel + x, origin_y + y, 0);
+                        REQUIRE(linear[y * pitch_linear + x] == swizzled[offset]);
+                    }
+                }
+
+                std::vector<u8> reswizzled(swizzled.size());
+                SwizzleSubrect(reswizzled, linear, bytes_per_pixel, width, height, 1, origin_x,
+                               origin_y, extent_x, extent_y, block_height, 0, pitch_linear);
+                for (u32 y = 0; y < extent_y; ++y) {
+                    for (u32 x = 0; x < extent_x * bytes_per_pixel; ++x) {
+                        const size_t offset =
+                            layout.Offset(origin_x * bytes_per_pixel + x, origin_y + y, 0);
+                        REQUIRE(reswizzled[offset] == swizzled[offset]);
+                    }
+                }
+            }
+        }
+    }
+}
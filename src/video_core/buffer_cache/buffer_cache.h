@@ -1276,12 +1276,15 @@ BufferId BufferCache<P>::FindBuffer(DAddr device_addr, u32 size) {
     const u64 page = device_addr >> CACHING_PAGEBITS;
     const BufferId buffer_id = page_table[page];
     if (!buffer_id) {
+        ++buffer_counters.misses;
         return CreateBuffer(device_addr, size);
     }
     const Buffer& buffer = slot_buffers[buffer_id];
     if (buffer.IsInBounds(device_addr, size)) {
+        ++buffer_counters.hits;
         return buffer_id;
     }
+    ++buffer_counters.misses;
     return CreateBuffer(device_addr, size);
 }
 
@@ -305,6 +305,11 @@ public:
         } while (channel_state->has_deleted_buffers);
     }
 
+    /// Return the lookup counters of the buffers bound by the guest
+    [[nodiscard]] const CacheCounters& BufferCounters() const noexcept {
+        return buffer_counters;
+    }
+
     std::recursive_mutex mutex;
     Runtime& runtime;
 
@@ -476,6 +481,7 @@ private:
     };
     Common::LeastRecentlyUsedCache<LRUItemParams> lru_cache;
     u64 frame_tick = 0;
+    CacheCounters buffer_counters;
     u64 total_used_memory = 0;
     u64 minimum_memory = 0;
     u64 critical_memory = 0;
@@ -9,6 +9,8 @@
 #include <span>
 #include <utility>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/alignment.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -253,9 +255,10 @@ public:
         std::span<u64> state_words = words.template Span<type>();
         [[maybe_unused]] std::span<u64> untracked_words = words.template Span<Type::Untracked>();
         [[maybe_unused]] std::span<u64> cached_words = words.template Span<Type::CachedCPU>();
+        TrackerBatch<!enable> tracker_batch{tracker};
         IterateWords(dirty_addr - cpu_addr, size, [&](size_t index, u64 mask) {
             if constexpr (type == Type::CPU || type == Type::CachedCPU) {
-                NotifyRasterizer<!enable>(index, untracked_words[index], mask);
+                NotifyRasterizer(index, untracked_words[index], mask, tracker_batch);
             }
             if constexpr (enable) {
                 state_words[index] |= mask;
@@ -280,7 +283,8 @@ public:
 
     /**
      * Loop over each page in the given range, turn off those bits and notify the tracker if
-     * needed. Call the given function on each turned off range.
+     * needed. Call the given function on each turned off range. The tracker is notified once
+     * the loop ends, so the turned off ranges must only be read after this returns.
      *
      * @param query_cpu_range Base CPU address to loop over
      * @param size            Size in bytes of the CPU range to loop over
@@ -297,6 +301,7 @@ public:
         bool pending = false;
         size_t pending_offset{};
         size_t pending_pointer{};
+        TrackerBatch<true> tracker_batch{tracker};
         const auto release = [&]() {
             func(cpu_addr + pending_offset * BYTES_PER_PAGE,
                  (pending_pointer - pending_offset) * BYTES_PER_PAGE);
@@ -308,7 +313,7 @@ public:
             const u64 word = state_words[index] & mask;
             if constexpr (clear) {
                 if constexpr (type == Type::CPU || type == Type::CachedCPU) {
-                    NotifyRasterizer<true>(index, untracked_words[index], mask);
+                    NotifyRasterizer(index, untracked_words[index], mask, tracker_batch);
                 }
                 state_words[index] &= ~mask;
                 if constexpr (type == Type::CPU || type == Type::CachedCPU) {
@@ -422,9 +427,10 @@ public:
         u64* const cached_words = Array<Type::CachedCPU>();
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const cpu_words = Array<Type::CPU>();
+        TrackerBatch<false> tracker_batch{tracker};
         for (u64 word_index = 0; word_index < num_words; ++word_index) {
             const u64 cached_bits = cached_words[word_index];
-            NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits);
+            NotifyRasterizer(word_index, untracked_words[word_index], cached_bits, tracker_batch);
             untracked_words[word_index] |= cached_bits;
             cpu_words[word_index] |= cached_bits;
             cached_words[word_index] = 0;
@@ -458,22 +464,60 @@ private:
         }
     }
 
+    /**
+     * Pages whose CPU tracking state changes, gathered to notify the tracker of them at once.
+     * Contiguous pages of consecutive words are merged in a single range.
+     *
+     * @tparam add_to_tracker True when the tracker should start tracking the pages
+     */
+    template <bool add_to_tracker>
+    class TrackerBatch {
+    public:
+        explicit TrackerBatch(DeviceTracker* tracker_) : tracker{tracker_} {}
+
+        ~TrackerBatch() {
+            Flush();
+        }
+
+        void Add(VAddr addr, u64 size) {
+            if (!ranges.empty() && ranges.back().first + ranges.back().second == addr) {
+                ranges.back().second += size;
+                return;
+            }
+            ranges.emplace_back(addr, size);
+        }
+
+        void Flush() {
+            if (ranges.empty()) {
+                return;
+            }
+            tracker->UpdatePagesCachedBatch({ranges.data(), ranges.size()},
+                                            add_to_tracker ? 1 : -1);
+            ranges.clear();
+        }
+
+    private:
+        DeviceTracker* tracker;
+        boost::container::small_vector<std::pair<DAddr, size_t>, 16> ranges;
+    };
+
     /**
      * Notify tracker about changes in the CPU tracking state of a word in the buffer
      *
      * @param word_index   Index to the word to notify to the tracker
      * @param current_bits Current state of the word
      * @param new_bits     New state of the word
+     * @param batch        Batch the changed pages are added to
      *
      * @tparam add_to_tracker True when the tracker should start tracking the new pages
      */
     template <bool add_to_tracker>
-    void NotifyRasterizer(u64 word_index, u64 current_bits, u64 new_bits) const {
+    void NotifyRasterizer(u64 word_index, u64 current_bits, u64 new_bits,
+                          TrackerBatch<add_to_tracker>& batch) const {
         u64 changed_bits = (add_to_tracker ? current_bits : ~current_bits) & new_bits;
         VAddr addr = cpu_addr + word_index * BYTES_PER_WORD;
         IteratePages(changed_bits, [&](size_t offset, size_t size) {
-            tracker->UpdatePagesCachedCount(addr + offset * BYTES_PER_PAGE, size * BYTES_PER_PAGE,
-                                            add_to_tracker ? 1 : -1);
+            batch.Add(addr + offset * BYTES_PER_PAGE, size * BYTES_PER_PAGE);
         });
     }
 
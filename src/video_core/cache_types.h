@@ -21,4 +21,10 @@ enum class CacheType : u32 {
 };
 DECLARE_ENUM_FLAG_OPERATORS(CacheType)
 
+/// Lookup counters of a renderer cache
+struct CacheCounters {
+    u64 hits{};
+    u64 misses{};
+};
+
 } // namespace VideoCommon
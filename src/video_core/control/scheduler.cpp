@@ -7,6 +7,7 @@
 #include "video_core/control/channel_state.h"
 #include "video_core/control/scheduler.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 
 namespace Tegra::Control {
 Scheduler::Scheduler(GPU& gpu_) : gpu{gpu_} {}
@@ -19,8 +20,14 @@ void Scheduler::Push(s32 channel, CommandList&& entries) {
     ASSERT(it != channels.end());
     auto channel_state = it->second;
     gpu.BindChannel(channel_state->bind_id);
+    if (capture) [[unlikely]] {
+        capture->BeginSubmission(channel, entries, *channel_state->memory_manager);
+    }
     channel_state->dma_pusher->Push(std::move(entries));
     channel_state->dma_pusher->DispatchCalls();
+    if (capture) [[unlikely]] {
+        capture->EndSubmission();
+    }
 }
 
 void Scheduler::DeclareChannel(std::shared_ptr<ChannelState> new_channel) {
@@ -29,4 +36,9 @@ void Scheduler::DeclareChannel(std::shared_ptr<ChannelState> new_channel) {
     channels.emplace(channel, new_channel);
 }
 
+void Scheduler::BindCapture(GpuCaptureWriter* capture_) {
+    std::unique_lock lk(scheduling_guard);
+    capture = capture_;
+}
+
 } // namespace Tegra::Control
@@ -12,6 +12,7 @@
 namespace Tegra {
 
 class GPU;
+class GpuCaptureWriter;
 
 namespace Control {
 
@@ -26,10 +27,14 @@ public:
 
     void DeclareChannel(std::shared_ptr<ChannelState> new_channel);
 
+    /// Records the pushed command lists and the memory they access into a capture
+    void BindCapture(GpuCaptureWriter* capture_);
+
 private:
     std::unordered_map<s32, std::shared_ptr<ChannelState>> channels;
     std::mutex scheduling_guard;
     GPU& gpu;
+    GpuCaptureWriter* capture = nullptr;
 };
 
 } // namespace Control
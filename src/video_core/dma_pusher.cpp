@@ -126,12 +126,29 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
             if (dma_state.non_incrementing) {
                 const u32 max_write = static_cast<u32>(
                     std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
-                CallMultiMethod(&command_header.argument, max_write);
+                if (RegisterRunLength(1) == 1) {
+                    // Only the last value written to a plain register is observable
+                    CallRegisterWrites(&commands[index + max_write - 1].argument, 1, max_write);
+                } else {
+                    CallMultiMethod(&command_header.argument, max_write);
+                }
                 dma_state.method_count -= max_write;
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
             } else {
+                const u32 run_length =
+                    dma_increment_once
+                        ? 0
+                        : RegisterRunLength(static_cast<u32>(std::min<std::size_t>(
+                              dma_state.method_count, commands.size() - index)));
+                if (run_length > 1) {
+                    CallRegisterWrites(&command_header.argument, run_length, run_length);
+                    dma_state.method += run_length;
+                    dma_state.method_count -= run_length;
+                    index += run_length;
+                    continue;
+                }
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
             }
@@ -187,6 +204,57 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
 }
 
 void DmaPusher::CallMethod(u32 argument) const {
+    if (statistics) [[unlikely]] {
+        const auto start{std::chrono::steady_clock::now()};
+        ExecuteMethod(argument);
+        AccountStatistics(1, start);
+        return;
+    }
+    ExecuteMethod(argument);
+}
+
+void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    if (statistics) [[unlikely]] {
+        const auto start{std::chrono::steady_clock::now()};
+        ExecuteMultiMethod(base_start, num_methods);
+        AccountStatistics(num_methods, start);
+        return;
+    }
+    ExecuteMultiMethod(base_start, num_methods);
+}
+
+void DmaPusher::CallRegisterWrites(const u32* base_start, u32 amount, u32 num_methods) const {
+    const auto start{statistics ? std::chrono::steady_clock::now()
+                                : std::chrono::steady_clock::time_point{}};
+    subchannels[dma_state.subchannel]->WriteRegisters(dma_state.method, base_start, amount);
+    if (statistics) [[unlikely]] {
+        AccountStatistics(num_methods, start);
+    }
+}
+
+u32 DmaPusher::RegisterRunLength(u32 max_length) const {
+    if (dma_state.method < non_puller_methods) {
+        return 0;
+    }
+    const auto* const subchannel = subchannels[dma_state.subchannel];
+    u32 length = 0;
+    while (length < max_length && !subchannel->execution_mask[dma_state.method + length]) {
+        ++length;
+    }
+    return length;
+}
+
+void DmaPusher::AccountStatistics(u32 num_methods,
+                                  std::chrono::steady_clock::time_point start) const {
+    auto& counter = dma_state.method < non_puller_methods
+                        ? statistics->puller
+                        : statistics->engines[static_cast<size_t>(
+                              subchannel_type[dma_state.subchannel])];
+    counter.methods += num_methods;
+    counter.time += std::chrono::steady_clock::now() - start;
+}
+
+void DmaPusher::ExecuteMethod(u32 argument) const {
     if (dma_state.method < non_puller_methods) {
         puller.CallPullerMethod(Engines::Puller::MethodCall{
             dma_state.method,
@@ -206,7 +274,7 @@ void DmaPusher::CallMethod(u32 argument) const {
     }
 }
 
-void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+void DmaPusher::ExecuteMultiMethod(const u32* base_start, u32 num_methods) const {
     if (dma_state.method < non_puller_methods) {
         puller.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                                dma_state.method_count);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
@@ -111,6 +112,17 @@ struct CommandList final {
     boost::container::small_vector<CommandHeader, 512> prefetch_command_list;
 };
 
+/// Per-engine method counters and execution times, collected by DmaPusher when bound
+struct DmaPusherStatistics {
+    struct Counter {
+        u64 methods{};
+        std::chrono::nanoseconds time{};
+    };
+
+    Counter puller;
+    std::array<Counter, Engines::NUM_ENGINE_TYPES> engines{};
+};
+
 /**
  * The DmaPusher class implements DMA submission to FIFOs, providing an area of memory that the
  * emulated app fills with commands and tells PFIFO to process. The pushbuffers are then assembled
@@ -138,6 +150,11 @@ public:
 
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Enables method statistics collection into the given object, nullptr disables it
+    void BindStatistics(DmaPusherStatistics* statistics_) {
+        statistics = statistics_;
+    }
+
 private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
@@ -149,6 +166,17 @@ private:
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    /// Stores amount plain register values on the current subchannel, standing for num_methods
+    void CallRegisterWrites(const u32* base_start, u32 amount, u32 num_methods) const;
+
+    /// Returns how many of the next methods, up to max_length, write registers without side effects
+    u32 RegisterRunLength(u32 max_length) const;
+
+    void ExecuteMethod(u32 argument) const;
+    void ExecuteMultiMethod(const u32* base_start, u32 num_methods) const;
+
+    void AccountStatistics(u32 num_methods, std::chrono::steady_clock::time_point start) const;
+
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
@@ -178,6 +206,7 @@ private:
     Core::System& system;
     MemoryManager& memory_manager;
     mutable Engines::Puller puller;
+    DmaPusherStatistics* statistics{};
 };
 
 } // namespace Tegra
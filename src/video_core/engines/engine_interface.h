@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <bitset>
+#include <cstring>
 #include <limits>
 #include <vector>
 
@@ -19,6 +22,8 @@ enum class EngineTypes : u32 {
     KeplerMemory,
 };
 
+constexpr std::size_t NUM_ENGINE_TYPES = 5;
+
 class EngineInterface {
 public:
     virtual ~EngineInterface() = default;
@@ -30,6 +35,16 @@ public:
     virtual void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                  u32 methods_pending) = 0;
 
+    /**
+     * Write a run of consecutive registers that are all clear in execution_mask.
+     * Engines override this to store the whole run at once instead of going through the sink.
+     */
+    virtual void WriteRegisters(u32 method, const u32* base_start, u32 amount) {
+        for (u32 i = 0; i < amount; i++) {
+            method_sink.emplace_back(method + i, base_start[i]);
+        }
+    }
+
     void ConsumeSink() {
         if (method_sink.empty()) {
             return;
@@ -49,6 +64,18 @@ protected:
         }
         method_sink.clear();
     }
+
+    /// Flushes the sink and copies a run of register values into the register file
+    template <std::size_t NumRegs>
+    void StoreRegisters(std::array<u32, NumRegs>& reg_array, u32 method, const u32* base_start,
+                        u32 amount) {
+        ConsumeSink();
+        if (method >= NumRegs) {
+            return;
+        }
+        amount = std::min<u32>(amount, static_cast<u32>(NumRegs - method));
+        std::memcpy(reg_array.data() + method, base_start, amount * sizeof(u32));
+    }
 };
 
 } // namespace Tegra::Engines
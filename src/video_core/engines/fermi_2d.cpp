@@ -53,6 +53,10 @@ void Fermi2D::CallMultiMethod(u32 method, const u32* base_start, u32 amount, u32
     }
 }
 
+void Fermi2D::WriteRegisters(u32 method, const u32* base_start, u32 amount) {
+    StoreRegisters(regs.reg_array, method, base_start, amount);
+}
+
 void Fermi2D::ConsumeSinkImpl() {
     for (auto [method, value] : method_sink) {
         regs.reg_array[method] = value;
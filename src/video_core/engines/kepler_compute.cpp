@@ -28,6 +28,10 @@ void KeplerCompute::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
     upload_state.BindRasterizer(rasterizer);
 }
 
+void KeplerCompute::WriteRegisters(u32 method, const u32* base_start, u32 amount) {
+    StoreRegisters(regs.reg_array, method, base_start, amount);
+}
+
 void KeplerCompute::ConsumeSinkImpl() {
     for (auto [method, value] : method_sink) {
         regs.reg_array[method] = value;
@@ -205,6 +205,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write a run of consecutive registers without side effects.
+    void WriteRegisters(u32 method, const u32* base_start, u32 amount) override;
+
     std::optional<GPUVAddr> GetIndirectComputeAddress() const {
         return indirect_compute;
     }
@@ -24,6 +24,10 @@ void KeplerMemory::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_) {
     execution_mask[KEPLERMEMORY_REG_INDEX(data)] = true;
 }
 
+void KeplerMemory::WriteRegisters(u32 method, const u32* base_start, u32 amount) {
+    StoreRegisters(regs.reg_array, method, base_start, amount);
+}
+
 void KeplerMemory::ConsumeSinkImpl() {
     for (auto [method, value] : method_sink) {
         regs.reg_array[method] = value;
@@ -315,6 +315,37 @@ void Maxwell3D::ConsumeSinkImpl() {
     }
 }
 
+void Maxwell3D::WriteRegisters(u32 method, const u32* base_start, u32 amount) {
+    ConsumeSink();
+    ASSERT_MSG(method + amount <= Regs::NUM_REGS,
+               "Invalid Maxwell3D register, increase the size of the Regs structure");
+    amount = std::min<u32>(amount, static_cast<u32>(Regs::NUM_REGS) - method);
+
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], base_start, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        base_start = &shadow_state.reg_array[method];
+    }
+
+    // Games often rewrite whole state blocks with the values they already hold, skip those runs
+    // without touching the dirty tables
+    u32* const destination = &regs.reg_array[method];
+    if (std::memcmp(destination, base_start, amount * sizeof(u32)) == 0) {
+        return;
+    }
+    for (u32 i = 0; i < amount; i++) {
+        if (destination[i] == base_start[i]) {
+            continue;
+        }
+        destination[i] = base_start[i];
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method + i]] = true;
+        }
+    }
+}
+
 void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     if (regs.reg_array[method] == argument) {
         return;
@@ -3078,6 +3078,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write a run of consecutive registers without side effects.
+    void WriteRegisters(u32 method, const u32* base_start, u32 amount) override;
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -40,6 +40,10 @@ void MaxwellDMA::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_) {
     rasterizer = rasterizer_;
 }
 
+void MaxwellDMA::WriteRegisters(u32 method, const u32* base_start, u32 amount) {
+    StoreRegisters(regs.reg_array, method, base_start, amount);
+}
+
 void MaxwellDMA::ConsumeSinkImpl() {
     for (auto [method, value] : method_sink) {
         regs.reg_array[method] = value;
@@ -248,6 +248,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write a run of consecutive registers without side effects.
+    void WriteRegisters(u32 method, const u32* base_start, u32 amount) override;
+
 private:
     /// Performs the copy from the source buffer to the destination buffer as configured in the
     /// registers.
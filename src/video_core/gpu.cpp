@@ -9,12 +9,15 @@
 #include <memory>
 
 #include "common/assert.h"
+#include "common/fs/path_util.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/frontend/emu_window.h"
 #include "core/frontend/graphics_context.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/perf_stats.h"
 #include "video_core/cdma_pusher.h"
@@ -27,6 +30,7 @@
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/gpu_thread.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/host1x/syncpoint_manager.h"
@@ -75,6 +79,23 @@ struct GPU::Impl {
 
     void InitAddressSpace(Tegra::MemoryManager& memory_manager) {
         memory_manager.BindRasterizer(rasterizer);
+        if (Settings::values.dump_gpu_commands.GetValue()) [[unlikely]] {
+            AttachCapture(memory_manager);
+        }
+    }
+
+    /// Starts the capture on the first address space, the following ones are observed by it
+    void AttachCapture(Tegra::MemoryManager& memory_manager) {
+        if (!capture) {
+            const auto* const application = system.Kernel().ApplicationProcess();
+            const u64 program_id = application != nullptr ? application->GetProgramId() : 0;
+            const auto dump_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir)};
+            capture = GpuCaptureWriter::Create(dump_dir / "gpu_captures" /
+                                                   fmt::format("{:016x}.ycap", program_id),
+                                               host1x.MemoryManager());
+            scheduler->BindCapture(capture.get());
+        }
+        capture->Attach(memory_manager);
     }
 
     void ReleaseChannel(Control::ChannelState& to_release) {
@@ -365,6 +386,10 @@ struct GPU::Impl {
 
     const bool is_async;
 
+    /// Recorder of the processed command lists, only present when capturing is enabled. Declared
+    /// before the GPU thread and the scheduler so it outlives the submissions they process.
+    std::shared_ptr<GpuCaptureWriter> capture;
+
     VideoCommon::GPUThread::ThreadManager gpu_thread;
     std::unique_ptr<Core::Frontend::GraphicsContext> cpu_context;
 
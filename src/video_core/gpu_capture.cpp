@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+
+#include "common/alignment.h"
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/scope_exit.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'g', 'c', 'a', 'p'};
+constexpr u32 CAPTURE_VERSION = 2;
+
+/// Upper bound of a single record, anything larger is treated as damage
+constexpr u32 MAX_RECORD_WORDS = 256 * 1024 * 1024;
+
+constexpr size_t PAGE_WORDS = CAPTURE_PAGE_SIZE / sizeof(u32);
+constexpr size_t MAPPING_WORDS = 5;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+// Records are laid out as 32-bit words:
+//   record_size, channel,
+//   num_command_lists, { num_words, words[num_words] }...,
+//   num_mappings, { gpu_addr_lo, gpu_addr_hi, device_addr_lo, device_addr_hi, kind }...,
+//   num_pages, { device_addr_lo, device_addr_hi, data[CAPTURE_PAGE_SIZE / 4] }...
+// where record_size counts the words following it.
+
+void PushAddress(std::vector<u32>& words, u64 address) {
+    words.push_back(static_cast<u32>(address));
+    words.push_back(static_cast<u32>(address >> 32));
+}
+
+u64 ReadAddress(const std::vector<u32>& words, size_t offset) {
+    return static_cast<u64>(words[offset]) | (static_cast<u64>(words[offset + 1]) << 32);
+}
+} // Anonymous namespace
+
+GpuCaptureWriter::GpuCaptureWriter(const std::filesystem::path& path,
+                                   MaxwellDeviceMemoryManager& device_memory_)
+    : device_memory{device_memory_} {
+    const auto parent{path.parent_path()};
+    if (!parent.empty() && !Common::FS::CreateDirs(parent)) {
+        LOG_ERROR(HW_GPU, "Failed to create GPU capture directory");
+        return;
+    }
+    file.Open(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = CAPTURE_VERSION,
+        .reserved = 0,
+    };
+    if (!file.IsOpen() || !file.WriteObject(header)) {
+        LOG_ERROR(HW_GPU, "Failed to create GPU capture {}", Common::FS::PathToUTF8String(path));
+        file.Close();
+        return;
+    }
+    LOG_INFO(HW_GPU, "Capturing GPU commands to {}", Common::FS::PathToUTF8String(path));
+}
+
+GpuCaptureWriter::~GpuCaptureWriter() = default;
+
+std::shared_ptr<GpuCaptureWriter> GpuCaptureWriter::Create(
+    const std::filesystem::path& path, MaxwellDeviceMemoryManager& device_memory) {
+    auto writer = std::make_shared<GpuCaptureWriter>(path, device_memory);
+    device_memory.SetAccessObserver(
+        [weak = std::weak_ptr(writer)](DAddr address, size_t size) {
+            if (const auto capture = weak.lock()) {
+                capture->OnDeviceAccess(address, size);
+            }
+        });
+    return writer;
+}
+
+bool GpuCaptureWriter::IsOpen() const {
+    return file.IsOpen();
+}
+
+void GpuCaptureWriter::Attach(MemoryManager& memory_manager) {
+    memory_manager.SetAccessObserver(
+        [weak = weak_from_this(), &memory_manager](GPUVAddr gpu_addr, size_t size) {
+            if (const auto capture = weak.lock()) {
+                capture->OnGpuAccess(memory_manager, gpu_addr, size);
+            }
+        });
+}
+
+void GpuCaptureWriter::BeginSubmission(s32 channel, const CommandList& entries,
+                                       MemoryManager& memory_manager) {
+    buffer.clear();
+    mapping_words.clear();
+    page_words.clear();
+    touched_pages.clear();
+    num_mappings = 0;
+    num_pages = 0;
+    if (!file.IsOpen()) {
+        return;
+    }
+    buffer.push_back(0);
+    buffer.push_back(static_cast<u32>(channel));
+    if (!entries.prefetch_command_list.empty()) {
+        const auto& prefetch = entries.prefetch_command_list;
+        buffer.push_back(1);
+        buffer.push_back(static_cast<u32>(prefetch.size()));
+        const size_t offset = buffer.size();
+        buffer.resize(offset + prefetch.size());
+        std::memcpy(buffer.data() + offset, prefetch.data(), prefetch.size() * sizeof(u32));
+    } else {
+        buffer.push_back(static_cast<u32>(entries.command_lists.size()));
+        for (const CommandListHeader& header : entries.command_lists) {
+            const u32 num_words = static_cast<u32>(header.size.Value());
+            buffer.push_back(num_words);
+            const size_t offset = buffer.size();
+            buffer.resize(offset + num_words);
+            memory_manager.ReadBlockUnsafe(header.addr, buffer.data() + offset,
+                                           num_words * sizeof(u32));
+        }
+    }
+    recording_memory_manager = &memory_manager;
+    recording_channel = channel;
+    recording_thread.store(std::this_thread::get_id(), std::memory_order_release);
+}
+
+void GpuCaptureWriter::EndSubmission() {
+    recording_thread.store(std::thread::id{}, std::memory_order_release);
+    recording_memory_manager = nullptr;
+    if (!file.IsOpen()) {
+        return;
+    }
+    buffer.push_back(num_mappings);
+    buffer.insert(buffer.end(), mapping_words.begin(), mapping_words.end());
+    buffer.push_back(num_pages);
+    buffer.insert(buffer.end(), page_words.begin(), page_words.end());
+    if (buffer.size() - 1 > MAX_RECORD_WORDS) {
+        LOG_ERROR(HW_GPU, "GPU capture record of {} words is too large, stopping the capture",
+                  buffer.size() - 1);
+        file.Close();
+        return;
+    }
+    buffer[0] = static_cast<u32>(buffer.size() - 1);
+    if (file.WriteSpan(std::span<const u32>(buffer)) != buffer.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU capture, stopping it");
+        file.Close();
+    }
+}
+
+bool GpuCaptureWriter::IsRecording() const {
+    return !in_observer &&
+           recording_thread.load(std::memory_order_acquire) == std::this_thread::get_id();
+}
+
+void GpuCaptureWriter::OnGpuAccess(MemoryManager& memory_manager, GPUVAddr gpu_addr,
+                                   size_t size) {
+    if (!IsRecording() || &memory_manager != recording_memory_manager || size == 0) {
+        return;
+    }
+    in_observer = true;
+    SCOPE_EXIT {
+        in_observer = false;
+    };
+    auto& known = translations[recording_channel];
+    const GPUVAddr end = gpu_addr + size;
+    for (GPUVAddr page = Common::AlignDown(gpu_addr, CAPTURE_PAGE_SIZE); page < end;
+         page += CAPTURE_PAGE_SIZE) {
+        const std::optional<DAddr> device_addr = memory_manager.GpuToCpuAddress(page);
+        if (!device_addr) {
+            continue;
+        }
+        const auto [it, is_new] = known.try_emplace(page, *device_addr);
+        if (is_new || it->second != *device_addr) {
+            it->second = *device_addr;
+            PushAddress(mapping_words, page);
+            PushAddress(mapping_words, *device_addr);
+            mapping_words.push_back(static_cast<u32>(memory_manager.GetPageKind(page)));
+            ++num_mappings;
+        }
+        SnapshotPage(Common::AlignDown(*device_addr, CAPTURE_PAGE_SIZE));
+    }
+}
+
+void GpuCaptureWriter::OnDeviceAccess(DAddr address, size_t size) {
+    if (!IsRecording() || size == 0) {
+        return;
+    }
+    const DAddr end = address + size;
+    for (DAddr page = Common::AlignDown(address, CAPTURE_PAGE_SIZE); page < end;
+         page += CAPTURE_PAGE_SIZE) {
+        SnapshotPage(page);
+    }
+}
+
+void GpuCaptureWriter::SnapshotPage(DAddr page) {
+    if (!touched_pages.insert(page).second) {
+        return;
+    }
+    const u8* const data = device_memory.GetPointer<u8>(page);
+    if (!data) {
+        return;
+    }
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(data), CAPTURE_PAGE_SIZE);
+    const auto [it, is_new] = page_hashes.try_emplace(page, hash);
+    if (!is_new && it->second == hash) {
+        return;
+    }
+    it->second = hash;
+    PushAddress(page_words, page);
+    const size_t offset = page_words.size();
+    page_words.resize(offset + PAGE_WORDS);
+    std::memcpy(page_words.data() + offset, data, CAPTURE_PAGE_SIZE);
+    ++num_pages;
+}
+
+GpuCaptureReader::GpuCaptureReader(const std::filesystem::path& path) {
+    file.Open(path, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile);
+    FileHeader header;
+    if (!file.IsOpen() || !file.ReadObject(header)) {
+        LOG_ERROR(HW_GPU, "Failed to open GPU capture {}", Common::FS::PathToUTF8String(path));
+        file.Close();
+        return;
+    }
+    if (header.magic != MAGIC_NUMBER || header.version != CAPTURE_VERSION) {
+        LOG_ERROR(HW_GPU, "{} is not a supported GPU capture", Common::FS::PathToUTF8String(path));
+        file.Close();
+    }
+}
+
+GpuCaptureReader::~GpuCaptureReader() = default;
+
+bool GpuCaptureReader::IsOpen() const {
+    return file.IsOpen();
+}
+
+bool GpuCaptureReader::Next(CapturedSubmission& submission) {
+    if (!file.IsOpen()) {
+        return false;
+    }
+    u32 record_size{};
+    if (!file.ReadObject(record_size)) {
+        return false;
+    }
+    if (record_size < 4 || record_size > MAX_RECORD_WORDS) {
+        LOG_ERROR(HW_GPU, "GPU capture record has an invalid size of {} words", record_size);
+        return false;
+    }
+    std::vector<u32> words(record_size);
+    if (file.ReadSpan(std::span<u32>(words)) != words.size()) {
+        LOG_ERROR(HW_GPU, "GPU capture is truncated");
+        return false;
+    }
+    const auto damaged = [] {
+        LOG_ERROR(HW_GPU, "GPU capture record is damaged");
+        return false;
+    };
+    // Number of words left after the one at offset
+    const auto remaining = [&](size_t offset) { return words.size() - offset - 1; };
+
+    submission.channel = static_cast<s32>(words[0]);
+    submission.command_lists.clear();
+    submission.mappings.clear();
+    submission.page_addresses.clear();
+    submission.page_data.clear();
+
+    const u32 num_command_lists = words[1];
+    size_t offset = 2;
+    for (u32 list = 0; list < num_command_lists; ++list) {
+        if (offset >= words.size() || words[offset] > remaining(offset)) {
+            return damaged();
+        }
+        const u32 num_words = words[offset++];
+        auto& command_list = submission.command_lists.emplace_back(num_words);
+        std::memcpy(command_list.data(), words.data() + offset, num_words * sizeof(u32));
+        offset += num_words;
+    }
+
+    if (offset >= words.size() || words[offset] > remaining(offset) / MAPPING_WORDS) {
+        return damaged();
+    }
+    const u32 num_mappings = words[offset++];
+    submission.mappings.reserve(num_mappings);
+    for (u32 mapping = 0; mapping < num_mappings; ++mapping) {
+        submission.mappings.push_back({
+            .gpu_addr = ReadAddress(words, offset),
+            .device_addr = ReadAddress(words, offset + 2),
+            .kind = static_cast<PTEKind>(words[offset + 4]),
+        });
+        offset += MAPPING_WORDS;
+    }
+
+    if (offset >= words.size() || words[offset] > remaining(offset) / (PAGE_WORDS + 2)) {
+        return damaged();
+    }
+    const u32 num_pages = words[offset++];
+    submission.page_addresses.reserve(num_pages);
+    submission.page_data.resize(size_t{num_pages} * CAPTURE_PAGE_SIZE);
+    for (u32 page = 0; page < num_pages; ++page) {
+        submission.page_addresses.push_back(ReadAddress(words, offset));
+        std::memcpy(submission.page_data.data() + page * CAPTURE_PAGE_SIZE,
+                    words.data() + offset + 2, CAPTURE_PAGE_SIZE);
+        offset += PAGE_WORDS + 2;
+    }
+    return true;
+}
+
+} // namespace Tegra
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/pte_kind.h"
+
+namespace Tegra {
+
+class MemoryManager;
+
+/// Size of the guest memory pages snapshotted by a GPU capture
+constexpr size_t CAPTURE_PAGE_SIZE = 0x1000;
+
+/// Translation of a GPU page to a device page, as stored in a GPU capture
+struct CapturedMapping {
+    GPUVAddr gpu_addr;
+    DAddr device_addr;
+    PTEKind kind;
+};
+
+/// Command list submission as stored in a GPU capture
+struct CapturedSubmission {
+    s32 channel{};
+    /// Pushbuffer words of each GPFIFO entry, or the prefetched command list
+    std::vector<std::vector<CommandHeader>> command_lists;
+    /// GPU pages translated for the first time, or to a different device page, by the submission
+    std::vector<CapturedMapping> mappings;
+    /// Device pages accessed by the submission whose contents changed since their last snapshot
+    std::vector<DAddr> page_addresses;
+    /// Contents of the pages in page_addresses, CAPTURE_PAGE_SIZE bytes each
+    std::vector<u8> page_data;
+};
+
+/**
+ * Records the command lists processed by the GPU together with the guest memory they access.
+ * The resulting file is replayed with yuzu-gpu-replay.
+ *
+ * Submissions are recorded on the thread processing them. Every GPU page translated, read or
+ * written through the memory manager of the channel, and every device page the renderer reads
+ * or starts caching, is snapshotted on its first access by the submission and stored when its
+ * contents differ from the previous snapshot. The translations of the GPU pages are stored
+ * alongside, so a replay can rebuild the part of the address space the commands use.
+ */
+class GpuCaptureWriter : public std::enable_shared_from_this<GpuCaptureWriter> {
+public:
+    explicit GpuCaptureWriter(const std::filesystem::path& path,
+                              MaxwellDeviceMemoryManager& device_memory);
+    ~GpuCaptureWriter();
+
+    /// Creates a writer observing the accesses to device memory
+    [[nodiscard]] static std::shared_ptr<GpuCaptureWriter> Create(
+        const std::filesystem::path& path, MaxwellDeviceMemoryManager& device_memory);
+
+    [[nodiscard]] bool IsOpen() const;
+
+    /// Observes the accesses through a GPU address space, called once when it is created
+    void Attach(MemoryManager& memory_manager);
+
+    /// Starts recording a submission, the calling thread must process it before EndSubmission
+    void BeginSubmission(s32 channel, const CommandList& entries, MemoryManager& memory_manager);
+
+    /// Appends the submission started by BeginSubmission and its memory to the capture
+    void EndSubmission();
+
+private:
+    [[nodiscard]] bool IsRecording() const;
+
+    void OnGpuAccess(MemoryManager& memory_manager, GPUVAddr gpu_addr, size_t size);
+
+    void OnDeviceAccess(DAddr address, size_t size);
+
+    void SnapshotPage(DAddr page);
+
+    MaxwellDeviceMemoryManager& device_memory;
+    Common::FS::IOFile file;
+
+    /// Thread processing the submission being recorded, observers ignore all others
+    std::atomic<std::thread::id> recording_thread{};
+    MemoryManager* recording_memory_manager = nullptr;
+    s32 recording_channel = 0;
+    bool in_observer = false;
+
+    /// Device pages already snapshotted by the submission being recorded
+    std::unordered_set<DAddr> touched_pages;
+    /// Last translation stored for each GPU page, per channel as replays give each its own
+    std::unordered_map<s32, std::unordered_map<GPUVAddr, DAddr>> translations;
+    /// Hash of the last stored contents of each device page
+    std::unordered_map<DAddr, u64> page_hashes;
+
+    std::vector<u32> buffer;
+    std::vector<u32> mapping_words;
+    std::vector<u32> page_words;
+    u32 num_mappings = 0;
+    u32 num_pages = 0;
+};
+
+/// Sequential reader of the files written by GpuCaptureWriter
+class GpuCaptureReader {
+public:
+    explicit GpuCaptureReader(const std::filesystem::path& path);
+    ~GpuCaptureReader();
+
+    [[nodiscard]] bool IsOpen() const;
+
+    /// Reads the next submission, returns false at the end of the capture or on a damaged record
+    [[nodiscard]] bool Next(CapturedSubmission& submission);
+
+private:
+    Common::FS::IOFile file;
+};
+
+} // namespace Tegra
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <cstring>
 #include <fstream>
 #include <optional>
@@ -18,6 +19,7 @@
 #include "video_core/macro/macro.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/macro/macro_interpreter.h"
+#include "video_core/macro/macro_profiler.h"
 
 #ifdef ARCHITECTURE_x86_64
 #include "video_core/macro/macro_jit_x64.h"
@@ -55,7 +57,11 @@ static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
 }
 
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {}
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {
+    if (Settings::values.profile_macros) {
+        profiler = std::make_unique<MacroProfiler>();
+    }
+}
 
 MacroEngine::~MacroEngine() = default;
 
@@ -69,6 +75,33 @@ void MacroEngine::ClearCode(u32 method) {
 }
 
 void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
+    if (profiler) {
+        ExecuteProfiled(method, parameters);
+        return;
+    }
+    ExecuteMacro(method, parameters);
+}
+
+void MacroEngine::ExecuteProfiled(u32 method, const std::vector<u32>& parameters) {
+    // The first execution of a macro includes its compilation
+    const auto start{std::chrono::steady_clock::now()};
+    ExecuteMacro(method, parameters);
+    const auto time{std::chrono::steady_clock::now() - start};
+
+    const auto it = macro_cache.find(method);
+    if (it == macro_cache.end()) {
+        return;
+    }
+    CacheInfo& cache_info = it->second;
+    if (!cache_info.profile) {
+        const auto& code = uploaded_macro_code[method];
+        cache_info.profile =
+            &profiler->Register(cache_info.hash, code, cache_info.has_hle_program);
+    }
+    cache_info.profile->Account(std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+}
+
+void MacroEngine::ExecuteMacro(u32 method, const std::vector<u32>& parameters) {
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
         const auto& cache_info = compiled_macro->second;
@@ -96,6 +96,8 @@ union MethodAddress {
 } // namespace Macro
 
 class HLEMacro;
+class MacroProfiler;
+struct MacroProfileEntry;
 
 class CachedMacro {
 public:
@@ -130,13 +132,20 @@ private:
     struct CacheInfo {
         std::unique_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
+        MacroProfileEntry* profile{};
         u64 hash{};
         bool has_hle_program{};
     };
 
+    void ExecuteMacro(u32 method, const std::vector<u32>& parameters);
+
+    // Times the execution of the macro and accounts it to its hash
+    void ExecuteProfiled(u32 method, const std::vector<u32>& parameters);
+
     std::unordered_map<u32, CacheInfo> macro_cache;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
+    std::unique_ptr<MacroProfiler> profiler;
     Engines::Maxwell3D& maxwell3d;
 };
 
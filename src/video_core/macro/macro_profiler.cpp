@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/macro/macro_profiler.h"
+
+namespace Tegra {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'm', 'p', 'r', 'f'};
+constexpr u32 PROFILE_VERSION = 1;
+
+/// Larger than the macro memory of the engine, anything bigger is treated as damage
+constexpr u32 MAX_CODE_WORDS = 0x10000;
+
+/// Number of macros listed in the report and dumped with it
+constexpr size_t NUM_REPORTED_MACROS = 32;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 num_entries;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+struct EntryHeader {
+    u64 hash;
+    u64 executions;
+    u64 nanoseconds;
+    u32 is_hle;
+    u32 code_size;
+};
+static_assert(sizeof(EntryHeader) == 32);
+
+/// Serializes the profiles of all the engines of the process writing to the dump directory
+std::mutex profile_mutex;
+
+std::unordered_map<u64, MacroProfileEntry> LoadProfile(const std::filesystem::path& path) {
+    std::unordered_map<u64, MacroProfileEntry> result;
+    if (!Common::FS::Exists(path)) {
+        return result;
+    }
+    const Common::FS::IOFile file(path, Common::FS::FileAccessMode::Read,
+                                  Common::FS::FileType::BinaryFile);
+    FileHeader header;
+    if (!file.ReadObject(header) || header.magic != MAGIC_NUMBER ||
+        header.version != PROFILE_VERSION) {
+        LOG_WARNING(HW_GPU, "Discarding incompatible macro profile");
+        return result;
+    }
+    for (u32 index = 0; index < header.num_entries; ++index) {
+        EntryHeader entry_header;
+        if (!file.ReadObject(entry_header) || entry_header.code_size > MAX_CODE_WORDS) {
+            LOG_WARNING(HW_GPU, "Macro profile is damaged, discarding it");
+            return {};
+        }
+        MacroProfileEntry entry{
+            .executions = entry_header.executions,
+            .nanoseconds = entry_header.nanoseconds,
+            .is_hle = entry_header.is_hle != 0,
+            .code = std::vector<u32>(entry_header.code_size),
+        };
+        if (file.ReadSpan(std::span<u32>(entry.code)) != entry.code.size()) {
+            LOG_WARNING(HW_GPU, "Macro profile is damaged, discarding it");
+            return {};
+        }
+        result.insert_or_assign(entry_header.hash, std::move(entry));
+    }
+    return result;
+}
+
+void SaveProfile(const std::filesystem::path& path,
+                 const std::unordered_map<u64, MacroProfileEntry>& profile) {
+    const Common::FS::IOFile file(path, Common::FS::FileAccessMode::Write,
+                                  Common::FS::FileType::BinaryFile);
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = PROFILE_VERSION,
+        .num_entries = static_cast<u32>(profile.size()),
+    };
+    bool success = file.WriteObject(header);
+    for (const auto& [hash, entry] : profile) {
+        const EntryHeader entry_header{
+            .hash = hash,
+            .executions = entry.executions,
+            .nanoseconds = entry.nanoseconds,
+            .is_hle = entry.is_hle ? 1U : 0U,
+            .code_size = static_cast<u32>(entry.code.size()),
+        };
+        success = success && file.WriteObject(entry_header) &&
+                  file.WriteSpan(std::span<const u32>(entry.code)) == entry.code.size();
+    }
+    if (!success) {
+        LOG_ERROR(HW_GPU, "Failed to write the macro profile {}",
+                  Common::FS::PathToUTF8String(path));
+    }
+}
+
+void WriteTextFile(const std::filesystem::path& path, const std::string& text) {
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, text) != text.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write {}", Common::FS::PathToUTF8String(path));
+    }
+}
+
+/**
+ * Writes the hashes identified as HLE macros and the hottest macros still lacking an HLE
+ * implementation, one per line, so scripts and later runs don't have to parse the report.
+ */
+void WriteHashLists(const std::filesystem::path& macro_dir,
+                    const std::unordered_map<u64, MacroProfileEntry>& profile,
+                    std::span<const std::pair<u64, const MacroProfileEntry*>> hot_macros) {
+    std::vector<u64> hle_hashes;
+    for (const auto& [hash, entry] : profile) {
+        if (entry.is_hle) {
+            hle_hashes.push_back(hash);
+        }
+    }
+    std::ranges::sort(hle_hashes);
+    std::string hle_list;
+    for (const u64 hash : hle_hashes) {
+        hle_list += fmt::format("{:016x}\n", hash);
+    }
+    WriteTextFile(macro_dir / "hle_macros.txt", hle_list);
+
+    std::string hot_list;
+    for (const auto& [hash, entry] : hot_macros) {
+        hot_list += fmt::format("{:016x} {} {}\n", hash, entry->executions, entry->nanoseconds);
+    }
+    WriteTextFile(macro_dir / "hot_macros.txt", hot_list);
+}
+
+void WriteReport(const std::filesystem::path& macro_dir,
+                 const std::unordered_map<u64, MacroProfileEntry>& profile) {
+    u64 total_executions = 0;
+    u64 total_nanoseconds = 0;
+    u64 hle_executions = 0;
+    u64 hle_nanoseconds = 0;
+    std::vector<std::pair<u64, const MacroProfileEntry*>> candidates;
+    for (const auto& [hash, entry] : profile) {
+        total_executions += entry.executions;
+        total_nanoseconds += entry.nanoseconds;
+        if (entry.is_hle) {
+            hle_executions += entry.executions;
+            hle_nanoseconds += entry.nanoseconds;
+        } else {
+            candidates.emplace_back(hash, &entry);
+        }
+    }
+    std::ranges::sort(candidates, [](const auto& lhs, const auto& rhs) {
+        return lhs.second->nanoseconds > rhs.second->nanoseconds;
+    });
+    candidates.resize(std::min(candidates.size(), NUM_REPORTED_MACROS));
+
+    const auto percent = [](u64 part, u64 total) {
+        return total != 0 ? static_cast<double>(part) * 100.0 / static_cast<double>(total) : 0.0;
+    };
+    std::string report = fmt::format(
+        "{} macros, {} executions, {:.3f} ms\n"
+        "HLE coverage: {:.1f}% of executions, {:.1f}% of time\n\n"
+        "Hottest macros without an HLE implementation:\n"
+        "{:<16} {:>12} {:>12} {:>10} {:>6} {:>7}\n",
+        profile.size(), total_executions, static_cast<double>(total_nanoseconds) / 1e6,
+        percent(hle_executions, total_executions), percent(hle_nanoseconds, total_nanoseconds),
+        "Hash", "Executions", "Time (ms)", "ns/exec", "Words", "Time %");
+    for (const auto& [hash, entry] : candidates) {
+        report += fmt::format(
+            "{:016x} {:>12} {:>12.3f} {:>10.1f} {:>6} {:>6.1f}%\n", hash, entry->executions,
+            static_cast<double>(entry->nanoseconds) / 1e6,
+            static_cast<double>(entry->nanoseconds) /
+                static_cast<double>(std::max<u64>(entry->executions, 1)),
+            entry->code.size(), percent(entry->nanoseconds, total_nanoseconds));
+
+        // Same layout as the macros dumped by the engine, ready to be decompiled
+        const Common::FS::IOFile file(macro_dir / fmt::format("{:016x}.macro", hash),
+                                      Common::FS::FileAccessMode::Write,
+                                      Common::FS::FileType::BinaryFile);
+        if (file.WriteSpan(std::span<const u32>(entry->code)) != entry->code.size()) {
+            LOG_ERROR(HW_GPU, "Failed to dump macro {:016x}", hash);
+        }
+    }
+    WriteTextFile(macro_dir / "profile.txt", report);
+    WriteHashLists(macro_dir, profile, candidates);
+}
+} // Anonymous namespace
+
+MacroProfiler::MacroProfiler() = default;
+
+MacroProfiler::~MacroProfiler() {
+    if (entries.empty()) {
+        return;
+    }
+    const auto macro_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "macros"};
+    if (!Common::FS::CreateDirs(macro_dir)) {
+        LOG_ERROR(HW_GPU, "Failed to create the macro profile directory");
+        return;
+    }
+    const auto profile_path = macro_dir / "profile.bin";
+
+    std::scoped_lock lock{profile_mutex};
+    auto profile = LoadProfile(profile_path);
+    for (auto& [hash, entry] : entries) {
+        auto& merged = profile[hash];
+        merged.executions += entry.executions;
+        merged.nanoseconds += entry.nanoseconds;
+        // HLE implementations are added over time, the latest run decides
+        merged.is_hle = entry.is_hle;
+        merged.code = std::move(entry.code);
+    }
+    SaveProfile(profile_path, profile);
+    WriteReport(macro_dir, profile);
+    LOG_INFO(HW_GPU, "Macro profile of {} macros written to {}", profile.size(),
+             Common::FS::PathToUTF8String(macro_dir));
+}
+
+MacroProfileEntry& MacroProfiler::Register(u64 hash, std::span<const u32> code, bool is_hle) {
+    auto& entry = entries[hash];
+    entry.is_hle = is_hle;
+    if (entry.code.empty()) {
+        entry.code.assign(code.begin(), code.end());
+    }
+    return entry;
+}
+
+} // namespace Tegra
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Tegra {
+
+/// Execution statistics of a macro
+struct MacroProfileEntry {
+    u64 executions{};
+    u64 nanoseconds{};
+    bool is_hle{};
+    std::vector<u32> code;
+
+    void Account(std::chrono::nanoseconds time) {
+        ++executions;
+        nanoseconds += static_cast<u64>(time.count());
+    }
+};
+
+/**
+ * Counts the executions and the time spent in each macro, keyed by the hash of its code. On
+ * destruction the statistics are merged into a profile kept in the dump directory, so they
+ * accumulate across runs, and a report of the hottest macros without an HLE implementation is
+ * written next to it together with their code. The hashes identified as HLE macros and the hot
+ * ones lacking an implementation are also written as plain lists, hle_macros.txt and
+ * hot_macros.txt.
+ */
+class MacroProfiler {
+public:
+    MacroProfiler();
+    ~MacroProfiler();
+
+    /// Returns the statistics of a macro, registering it on its first execution
+    MacroProfileEntry& Register(u64 hash, std::span<const u32> code, bool is_hle);
+
+private:
+    std::unordered_map<u64, MacroProfileEntry> entries;
+};
+
+} // namespace Tegra
@@ -179,6 +179,10 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
     rasterizer = rasterizer_;
 }
 
+void MemoryManager::SetAccessObserver(AccessObserver&& observer) {
+    access_observer = std::move(observer);
+}
+
 GPUVAddr MemoryManager::Map(GPUVAddr gpu_addr, DAddr dev_addr, std::size_t size, PTEKind kind,
                             bool is_big_pages) {
     if (is_big_pages) [[likely]] {
@@ -213,6 +217,9 @@ std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
     if (!IsWithinGPUAddressRange(gpu_addr)) [[unlikely]] {
         return std::nullopt;
     }
+    if (access_observer) [[unlikely]] {
+        access_observer(gpu_addr, 1);
+    }
     if (GetEntry<true>(gpu_addr) != EntryType::Mapped) [[unlikely]] {
         if (GetEntry<false>(gpu_addr) != EntryType::Mapped) {
             return std::nullopt;
@@ -229,6 +236,9 @@ std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
 }
 
 std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr, std::size_t size) const {
+    if (access_observer) [[unlikely]] {
+        access_observer(addr, size);
+    }
     size_t page_index{addr >> page_bits};
     const size_t page_last{(addr + size + page_size - 1) >> page_bits};
     while (page_index < page_last) {
@@ -368,6 +378,9 @@ inline void MemoryManager::MemoryOperation(GPUVAddr gpu_src_addr, std::size_t si
 template <bool is_safe>
 void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
                                   [[maybe_unused]] VideoCommon::CacheType which) const {
+    if (access_observer) [[unlikely]] {
+        access_observer(gpu_src_addr, size);
+    }
     auto set_to_zero = [&]([[maybe_unused]] std::size_t page_index,
                            [[maybe_unused]] std::size_t offset, std::size_t copy_amount) {
         std::memset(dest_buffer, 0, copy_amount);
@@ -418,6 +431,9 @@ void MemoryManager::ReadBlockUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
 template <bool is_safe>
 void MemoryManager::WriteBlockImpl(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size,
                                    [[maybe_unused]] VideoCommon::CacheType which) {
+    if (access_observer) [[unlikely]] {
+        access_observer(gpu_dest_addr, size);
+    }
     auto just_advance = [&]([[maybe_unused]] std::size_t page_index,
                             [[maybe_unused]] std::size_t offset, std::size_t copy_amount) {
         src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
@@ -763,6 +779,9 @@ void MemoryManager::FlushCaching() {
 }
 
 const u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size) const {
+    if (access_observer) [[unlikely]] {
+        access_observer(src_addr, size);
+    }
     if (!IsContinuousRange(src_addr, size)) {
         return nullptr;
     }
@@ -774,6 +793,9 @@ const u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size
 }
 
 u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size) {
+    if (access_observer) [[unlikely]] {
+        access_observer(src_addr, size);
+    }
     if (!IsContinuousRange(src_addr, size)) {
         return nullptr;
     }
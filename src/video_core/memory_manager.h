@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <optional>
@@ -52,6 +53,13 @@ public:
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Called with the GPU address ranges translated, read or written through the memory manager
+    using AccessObserver = std::function<void(GPUVAddr gpu_addr, std::size_t size)>;
+
+    /// Sets the observer of the accesses, used by GPU captures. Must be set before the memory
+    /// manager is used by other threads.
+    void SetAccessObserver(AccessObserver&& observer);
+
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr, std::size_t size) const;
@@ -209,6 +217,7 @@ private:
     u64 big_page_table_mask;
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
+    AccessObserver access_observer;
 
     enum class EntryType : u64 {
         Free = 0,
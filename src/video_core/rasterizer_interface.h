@@ -34,6 +34,13 @@ enum class LoadCallbackStage {
 };
 using DiskResourceLoadCallback = std::function<void(LoadCallbackStage, std::size_t, std::size_t)>;
 
+/// Lookup counters of the texture, buffer and pipeline caches of a rasterizer
+struct CacheStatistics {
+    VideoCommon::CacheCounters textures;
+    VideoCommon::CacheCounters buffers;
+    VideoCommon::CacheCounters pipelines;
+};
+
 class RasterizerInterface {
 public:
     virtual ~RasterizerInterface() = default;
@@ -172,5 +179,10 @@ public:
     virtual bool HasDrawTransformFeedback() {
         return false;
     }
+
+    /// Returns the lookup counters of the renderer caches, empty when the rasterizer has none
+    [[nodiscard]] virtual CacheStatistics GetCacheStatistics() const {
+        return {};
+    }
 };
 } // namespace VideoCore
@@ -152,6 +152,7 @@ void RasterizerOpenGL::SyncVertexInstances() {
 
 void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    texture_cache.LoadDiskResources(title_id);
     shader_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
@@ -726,6 +727,14 @@ Tegra::Engines::AccelerateDMAInterface& RasterizerOpenGL::AccessAccelerateDMA()
     return accelerate_dma;
 }
 
+VideoCore::CacheStatistics RasterizerOpenGL::GetCacheStatistics() const {
+    return {
+        .textures = texture_cache.ImageCounters(),
+        .buffers = buffer_cache.BufferCounters(),
+        .pipelines = shader_cache.PipelineCounters(),
+    };
+}
+
 void RasterizerOpenGL::AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
                                                 std::span<const u8> memory) {
     auto cpu_addr = gpu_memory->GpuToCpuAddress(address);
@@ -143,6 +143,8 @@ public:
         return true;
     }
 
+    VideoCore::CacheStatistics GetCacheStatistics() const override;
+
     std::optional<FramebufferTextureInfo> AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                                             VAddr framebuffer_addr,
                                                             u32 pixel_stride);
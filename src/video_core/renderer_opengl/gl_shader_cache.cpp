@@ -49,6 +49,8 @@ using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
 using VideoCommon::LoadPipelines;
 using VideoCommon::SerializePipeline;
+using VideoCommon::ShaderTranslationCache;
+using VideoCommon::TranslatedShader;
 using Context = ShaderContext::Context;
 
 constexpr u32 CACHE_VERSION = 10;
@@ -251,6 +253,13 @@ ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
     if (use_asynchronous_shaders) {
         workers = CreateWorkers();
     }
+    const std::string host_identity{
+        fmt::format("{} {} {} {}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+                    reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+                    reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+                    static_cast<u32>(device.GetShaderBackend()))};
+    translation_fingerprint =
+        ShaderTranslationCache::MakeFingerprint(host_identity, CACHE_VERSION, profile, host_info);
 }
 
 ShaderCache::~ShaderCache() = default;
@@ -267,6 +276,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         return;
     }
     shader_cache_filename = base_dir / "opengl.bin";
+    translation_cache.Open(base_dir / "opengl_translated.bin", translation_fingerprint);
 
     if (!workers && !strict_context_required) {
         workers = CreateWorkers();
@@ -290,7 +300,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
             workers->QueueWork(std::move(work));
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env) {
         ComputePipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
@@ -307,7 +317,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
@@ -366,6 +376,7 @@ GraphicsPipeline* ShaderCache::CurrentGraphicsPipeline() {
         SetXfbState(graphics_key.xfb_state, regs);
     }
     if (current_pipeline && graphics_key == current_pipeline->Key()) {
+        ++pipeline_counters.hits;
         return BuiltPipeline(current_pipeline);
     }
     return CurrentGraphicsPipelineSlowPath();
@@ -375,7 +386,10 @@ GraphicsPipeline* ShaderCache::CurrentGraphicsPipelineSlowPath() {
     const auto [pair, is_new]{graphics_cache.try_emplace(graphics_key)};
     auto& pipeline{pair->second};
     if (is_new) {
+        ++pipeline_counters.misses;
         pipeline = CreateGraphicsPipeline();
+    } else {
+        ++pipeline_counters.hits;
     }
     if (!pipeline) {
         return nullptr;
@@ -420,12 +434,32 @@ ComputePipeline* ShaderCache::CurrentComputePipeline() {
     const auto [pair, is_new]{compute_cache.try_emplace(key)};
     auto& pipeline{pair->second};
     if (!is_new) {
+        ++pipeline_counters.hits;
         return pipeline.get();
     }
+    ++pipeline_counters.misses;
     pipeline = CreateComputePipeline(key, shader);
     return pipeline.get();
 }
 
+std::unique_ptr<GraphicsPipeline> ShaderCache::BuildGraphicsPipeline(
+    const GraphicsPipelineKey& key, std::span<const TranslatedShader> translated,
+    bool use_shader_workers, bool force_context_flush) {
+    std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
+    std::array<std::string, 5> sources;
+    std::array<std::vector<u32>, 5> sources_spirv;
+    for (const TranslatedShader& shader : translated) {
+        infos[shader.stage_index] = &shader.info;
+        sources[shader.stage_index] = shader.source;
+        sources_spirv[shader.stage_index] = shader.spirv;
+    }
+    auto* const thread_worker{use_shader_workers ? workers.get() : nullptr};
+    return std::make_unique<GraphicsPipeline>(
+        device, texture_cache, buffer_cache, program_manager, state_tracker, thread_worker,
+        &shader_notify, std::move(sources), std::move(sources_spirv), infos, key,
+        force_context_flush);
+}
+
 std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline() {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
@@ -452,6 +486,17 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     bool force_context_flush) try {
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
+    if (const auto translated{translation_cache.Find(key)}) {
+        if (Settings::values.dump_shaders) {
+            size_t env_index{};
+            for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+                if (key.unique_hashes[index] != 0) {
+                    envs[env_index++]->Dump(hash, key.unique_hashes[index]);
+                }
+            }
+        }
+        return BuildGraphicsPipeline(key, *translated, use_shader_workers, force_context_flush);
+    }
     size_t env_index{};
     u32 total_storage_buffers{};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
@@ -505,10 +550,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     const u32 glasm_storage_buffer_limit{device.GetMaxGLASMStorageBufferBlocks()};
     const bool glasm_use_storage_buffers{total_storage_buffers <= glasm_storage_buffer_limit};
 
-    std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
+    std::vector<TranslatedShader> translated;
+    translated.reserve(Maxwell::MaxShaderStage);
 
-    std::array<std::string, 5> sources;
-    std::array<std::vector<u32>, 5> sources_spirv;
     Shader::Backend::Bindings binding;
     Shader::IR::Program* previous_program{};
     const bool use_glasm{device.UseAssemblyShaders()};
@@ -522,30 +566,29 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
         UNIMPLEMENTED_IF(index == 0);
 
         Shader::IR::Program& program{programs[index]};
-        const size_t stage_index{index - 1};
-        infos[stage_index] = &program.info;
+        TranslatedShader& shader{translated.emplace_back()};
+        shader.stage_index = static_cast<u32>(index - 1);
 
         const auto runtime_info{
             MakeRuntimeInfo(key, program, previous_program, glasm_use_storage_buffers, use_glasm)};
         switch (device.GetShaderBackend()) {
         case Settings::ShaderBackend::Glsl:
             ConvertLegacyToGeneric(program, runtime_info);
-            sources[stage_index] = EmitGLSL(profile, runtime_info, program, binding);
+            shader.source = EmitGLSL(profile, runtime_info, program, binding);
             break;
         case Settings::ShaderBackend::Glasm:
-            sources[stage_index] = EmitGLASM(profile, runtime_info, program, binding);
+            shader.source = EmitGLASM(profile, runtime_info, program, binding);
             break;
         case Settings::ShaderBackend::SpirV:
             ConvertLegacyToGeneric(program, runtime_info);
-            sources_spirv[stage_index] = EmitSPIRV(profile, runtime_info, program, binding);
+            shader.spirv = EmitSPIRV(profile, runtime_info, program, binding);
             break;
         }
+        shader.info = program.info;
         previous_program = &program;
     }
-    auto* const thread_worker{use_shader_workers ? workers.get() : nullptr};
-    return std::make_unique<GraphicsPipeline>(device, texture_cache, buffer_cache, program_manager,
-                                              state_tracker, thread_worker, &shader_notify, sources,
-                                              sources_spirv, infos, key, force_context_flush);
+    translation_cache.Store(key, translated);
+    return BuildGraphicsPipeline(key, translated, use_shader_workers, force_context_flush);
 
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
@@ -575,33 +618,40 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
 
-    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
-
     if (Settings::values.dump_shaders) {
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-    const u32 num_storage_buffers{Shader::NumDescriptors(program.info.storage_buffers_descriptors)};
-    Shader::RuntimeInfo info;
-    info.glasm_use_storage_buffers = num_storage_buffers <= device.GetMaxGLASMStorageBufferBlocks();
-
-    std::string code{};
-    std::vector<u32> code_spirv;
-    switch (device.GetShaderBackend()) {
-    case Settings::ShaderBackend::Glsl:
-        code = EmitGLSL(profile, program);
-        break;
-    case Settings::ShaderBackend::Glasm:
-        code = EmitGLASM(profile, info, program);
-        break;
-    case Settings::ShaderBackend::SpirV:
-        code_spirv = EmitSPIRV(profile, program);
-        break;
+    auto translated{translation_cache.Find(key)};
+    if (!translated || translated->size() != 1) {
+        Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+        auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+        const u32 num_storage_buffers{
+            Shader::NumDescriptors(program.info.storage_buffers_descriptors)};
+        Shader::RuntimeInfo info;
+        info.glasm_use_storage_buffers =
+            num_storage_buffers <= device.GetMaxGLASMStorageBufferBlocks();
+
+        translated.emplace();
+        TranslatedShader& shader{translated->emplace_back()};
+        switch (device.GetShaderBackend()) {
+        case Settings::ShaderBackend::Glsl:
+            shader.source = EmitGLSL(profile, program);
+            break;
+        case Settings::ShaderBackend::Glasm:
+            shader.source = EmitGLASM(profile, info, program);
+            break;
+        case Settings::ShaderBackend::SpirV:
+            shader.spirv = EmitSPIRV(profile, program);
+            break;
+        }
+        shader.info = program.info;
+        translation_cache.Store(key, *translated);
     }
-
+    TranslatedShader& shader{translated->front()};
     return std::make_unique<ComputePipeline>(device, texture_cache, buffer_cache, program_manager,
-                                             program.info, code, code_spirv, force_context_flush);
+                                             shader.info, std::move(shader.source),
+                                             std::move(shader.spirv), force_context_flush);
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
     return nullptr;
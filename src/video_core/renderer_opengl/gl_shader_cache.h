@@ -10,10 +10,12 @@
 #include "common/thread_worker.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/profile.h"
+#include "video_core/cache_types.h"
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
 #include "video_core/renderer_opengl/gl_shader_context.h"
 #include "video_core/shader_cache.h"
+#include "video_core/shader_translation_cache.h"
 
 namespace Tegra {
 class MemoryManager;
@@ -42,6 +44,11 @@ public:
 
     [[nodiscard]] ComputePipeline* CurrentComputePipeline();
 
+    /// Returns the lookup counters of the graphics and compute pipelines
+    [[nodiscard]] const VideoCommon::CacheCounters& PipelineCounters() const noexcept {
+        return pipeline_counters;
+    }
+
 private:
     GraphicsPipeline* CurrentGraphicsPipelineSlowPath();
 
@@ -54,6 +61,10 @@ private:
         std::span<Shader::Environment* const> envs, bool use_shader_workers,
         bool force_context_flush = false);
 
+    std::unique_ptr<GraphicsPipeline> BuildGraphicsPipeline(
+        const GraphicsPipelineKey& key, std::span<const VideoCommon::TranslatedShader> translated,
+        bool use_shader_workers, bool force_context_flush);
+
     std::unique_ptr<ComputePipeline> CreateComputePipeline(const ComputePipelineKey& key,
                                                            const VideoCommon::ShaderInfo* shader);
 
@@ -76,6 +87,7 @@ private:
 
     GraphicsPipelineKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
+    VideoCommon::CacheCounters pipeline_counters;
 
     ShaderContext::ShaderPools main_pools;
     std::unordered_map<GraphicsPipelineKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
@@ -85,6 +97,8 @@ private:
     Shader::HostTranslateInfo host_info;
 
     std::filesystem::path shader_cache_filename;
+    VideoCommon::ShaderTranslationCache translation_cache;
+    u64 translation_fingerprint{};
     std::unique_ptr<ShaderWorker> workers;
 };
 
@@ -52,6 +52,8 @@ using VideoCommon::ComputeEnvironment;
 using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
+using VideoCommon::ShaderTranslationCache;
+using VideoCommon::TranslatedShader;
 
 constexpr u32 CACHE_VERSION = 11;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
@@ -430,6 +432,7 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipeline() {
     if (current_pipeline) {
         GraphicsPipeline* const next{current_pipeline->Next(graphics_key)};
         if (next) {
+            ++pipeline_counters.hits;
             current_pipeline = next;
             return BuiltPipeline(current_pipeline);
         }
@@ -453,8 +456,10 @@ ComputePipeline* PipelineCache::CurrentComputePipeline() {
     const auto [pair, is_new]{compute_cache.try_emplace(key)};
     auto& pipeline{pair->second};
     if (!is_new) {
+        ++pipeline_counters.hits;
         return pipeline.get();
     }
+    ++pipeline_counters.misses;
     pipeline = CreateComputePipeline(key, shader);
     return pipeline.get();
 }
@@ -472,6 +477,12 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     }
     pipeline_cache_filename = base_dir / "vulkan.bin";
 
+    const std::string host_identity{fmt::format("{} {} {:08x}", device.GetDriverName(),
+                                                device.GetModelName(), device.GetDriverVersion())};
+    translation_cache.Open(base_dir / "vulkan_translated.bin",
+                           ShaderTranslationCache::MakeFingerprint(host_identity, CACHE_VERSION,
+                                                                   profile, host_info));
+
     if (use_vulkan_pipeline_cache) {
         vulkan_pipeline_cache_filename = base_dir / "vulkan_pipelines.bin";
         vulkan_pipeline_cache =
@@ -489,7 +500,7 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env) {
         ComputePipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
@@ -507,7 +518,7 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
@@ -570,7 +581,10 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
     const auto [pair, is_new]{graphics_cache.try_emplace(graphics_key)};
     auto& pipeline{pair->second};
     if (is_new) {
+        ++pipeline_counters.misses;
         pipeline = CreateGraphicsPipeline();
+    } else {
+        ++pipeline_counters.hits;
     }
     if (!pipeline) {
         return nullptr;
@@ -610,6 +624,17 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     bool build_in_parallel) try {
     auto hash = key.Hash();
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
+    if (const auto translated{translation_cache.Find(key)}) {
+        if (Settings::values.dump_shaders) {
+            size_t env_index{0};
+            for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+                if (key.unique_hashes[index] != 0) {
+                    envs[env_index++]->Dump(hash, key.unique_hashes[index]);
+                }
+            }
+        }
+        return BuildGraphicsPipeline(key, *translated, statistics, build_in_parallel);
+    }
     size_t env_index{0};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
     const bool uses_vertex_a{key.unique_hashes[0] != 0};
@@ -653,8 +678,8 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
             layer_source_program = &programs[index];
         }
     }
-    std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
-    std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
+    std::vector<TranslatedShader> translated;
+    translated.reserve(Maxwell::MaxShaderStage);
 
     const Shader::IR::Program* previous_stage{};
     Shader::Backend::Bindings binding;
@@ -668,25 +693,17 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         UNIMPLEMENTED_IF(index == 0);
 
         Shader::IR::Program& program{programs[index]};
-        const size_t stage_index{index - 1};
-        infos[stage_index] = &program.info;
-
         const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
         ConvertLegacyToGeneric(program, runtime_info);
-        const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
-        device.SaveShader(code);
-        modules[stage_index] = BuildShader(device, code);
-        if (device.HasDebuggingToolAttached()) {
-            const std::string name{fmt::format("Shader {:016x}", key.unique_hashes[index])};
-            modules[stage_index].SetObjectNameEXT(name.c_str());
-        }
+        translated.push_back(TranslatedShader{
+            .stage_index = static_cast<u32>(index - 1),
+            .info = program.info,
+            .spirv = EmitSPIRV(profile, runtime_info, program, binding),
+        });
         previous_stage = &program;
     }
-    Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
-    return std::make_unique<GraphicsPipeline>(
-        scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
-        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache, key,
-        std::move(modules), infos);
+    translation_cache.Store(key, translated);
+    return BuildGraphicsPipeline(key, translated, statistics, build_in_parallel);
 
 } catch (const Shader::Exception& exception) {
     auto hash = key.Hash();
@@ -706,6 +723,29 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     return nullptr;
 }
 
+std::unique_ptr<GraphicsPipeline> PipelineCache::BuildGraphicsPipeline(
+    const GraphicsPipelineCacheKey& key, std::span<const TranslatedShader> translated,
+    PipelineStatistics* statistics, bool build_in_parallel) {
+    std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
+    std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
+    for (const TranslatedShader& shader : translated) {
+        const size_t stage_index{shader.stage_index};
+        infos[stage_index] = &shader.info;
+        device.SaveShader(shader.spirv);
+        modules[stage_index] = BuildShader(device, shader.spirv);
+        if (device.HasDebuggingToolAttached()) {
+            const std::string name{
+                fmt::format("Shader {:016x}", key.unique_hashes[stage_index + 1])};
+            modules[stage_index].SetObjectNameEXT(name.c_str());
+        }
+    }
+    Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
+    return std::make_unique<GraphicsPipeline>(
+        scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
+        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache, key,
+        std::move(modules), infos);
+}
+
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GraphicsEnvironments environments;
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
@@ -759,17 +799,25 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
 
-    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
-
     // Dump it before error.
     if (Settings::values.dump_shaders) {
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-    const std::vector<u32> code{EmitSPIRV(profile, program)};
-    device.SaveShader(code);
-    vk::ShaderModule spv_module{BuildShader(device, code)};
+    auto translated{translation_cache.Find(key)};
+    if (!translated || translated->size() != 1) {
+        Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+        auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+        translated.emplace();
+        translated->push_back(TranslatedShader{
+            .info = program.info,
+            .spirv = EmitSPIRV(profile, program),
+        });
+        translation_cache.Store(key, *translated);
+    }
+    const TranslatedShader& shader{translated->front()};
+    device.SaveShader(shader.spirv);
+    vk::ShaderModule spv_module{BuildShader(device, shader.spirv)};
     if (device.HasDebuggingToolAttached()) {
         const auto name{fmt::format("Shader {:016x}", key.unique_hash)};
         spv_module.SetObjectNameEXT(name.c_str());
@@ -777,7 +825,7 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<ComputePipeline>(device, vulkan_pipeline_cache, descriptor_pool,
                                              guest_descriptor_queue, thread_worker, statistics,
-                                             &shader_notify, program.info, std::move(spv_module));
+                                             &shader_notify, shader.info, std::move(spv_module));
 
 } catch (const Shader::Exception& exception) {
     LOG_ERROR(Render_Vulkan, "{}", exception.what());
@@ -792,6 +792,14 @@ Tegra::Engines::AccelerateDMAInterface& RasterizerVulkan::AccessAccelerateDMA()
     return accelerate_dma;
 }
 
+VideoCore::CacheStatistics RasterizerVulkan::GetCacheStatistics() const {
+    return {
+        .textures = texture_cache.ImageCounters(),
+        .buffers = buffer_cache.BufferCounters(),
+        .pipelines = pipeline_cache.PipelineCounters(),
+    };
+}
+
 void RasterizerVulkan::AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
                                                 std::span<const u8> memory) {
     auto cpu_addr = gpu_memory->GpuToCpuAddress(address);
@@ -841,6 +849,7 @@ std::optional<FramebufferTextureInfo> RasterizerVulkan::AccelerateDisplay(
 
 void RasterizerVulkan::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    texture_cache.LoadDiskResources(title_id);
     pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
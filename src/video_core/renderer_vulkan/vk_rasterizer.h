@@ -134,6 +134,8 @@ public:
 
     void ReleaseChannel(s32 channel_id) override;
 
+    VideoCore::CacheStatistics GetCacheStatistics() const override;
+
     std::optional<FramebufferTextureInfo> AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                                             VAddr framebuffer_addr,
                                                             u32 pixel_stride);
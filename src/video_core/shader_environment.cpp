@@ -5,7 +5,13 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "common/assert.h"
@@ -16,6 +22,7 @@
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/thread_worker.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
@@ -25,7 +32,7 @@
 
 namespace VideoCommon {
 
-constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'p', 'i', 'p', '2'};
 
 constexpr size_t INST_SIZE = sizeof(u64);
 
@@ -193,7 +200,7 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -448,7 +455,7 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+void FileEnvironment::Deserialize(std::istream& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
@@ -582,8 +589,279 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
     return it->second;
 }
 
+namespace {
+/// Previous cache layout, pipelines stored back to back without any framing
+constexpr std::array<char, 8> LEGACY_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+
+/// Framed layout without environment records, discarded rather than migrated
+constexpr std::array<char, 8> FRAMED_V1_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'p', 'i', 'p', 'e'};
+
+/// Pipelines deserialized in parallel before being handed to the backend
+constexpr size_t PIPELINES_PER_BATCH = 1024;
+
+enum class RecordKind : u32 {
+    Pipeline = 0,    ///< Number of environments, the environments and the pipeline key
+    Environment = 1, ///< A single environment, identified by the checksum of its record
+    PipelineRef = 2, ///< Number of environments, their environment checksums and the key
+};
+
+/// Precedes every record, allows finding record boundaries without deserializing them
+struct RecordHeader {
+    u32 size;
+    RecordKind kind;
+    u64 checksum;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+/// Read-only stream buffer over memory owned by someone else
+class SpanStreamBuffer final : public std::streambuf {
+public:
+    explicit SpanStreamBuffer(std::span<const char> data) {
+        char* const begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+
+    [[nodiscard]] size_t Position() const noexcept {
+        return static_cast<size_t>(gptr() - eback());
+    }
+};
+
+struct PipelineRecord {
+    RecordKind kind{};
+    std::vector<char> data;
+    std::vector<FileEnvironment> envs;
+    size_t key_offset{};
+    bool is_valid{};
+};
+
+/// Environments written to each cache file, shared shaders are only stored once per file
+std::mutex serialized_envs_mutex;
+std::unordered_map<std::string, std::unordered_set<u64>> serialized_envs;
+/// Cache files left in the legacy layout, framed records must not be appended to them
+std::unordered_set<std::string> legacy_files;
+
+using LoadComputeFunc = Common::UniqueFunction<void, std::istream&, FileEnvironment>;
+using LoadGraphicsFunc = Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>>;
+
+u64 RecordChecksum(std::span<const char> data) {
+    return Common::CityHash64(data.data(), data.size());
+}
+
+/// Writes a record, returns false when it didn't make it to the stream
+bool WriteRecord(std::ostream& file, RecordKind kind, std::span<const char> data) {
+    const RecordHeader header{
+        .size = static_cast<u32>(data.size()),
+        .kind = kind,
+        .checksum = RecordChecksum(data),
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+        .write(data.data(), data.size());
+    return file.good();
+}
+
+/// Reads the environments of a pipeline, leaving the stream at the pipeline key
+std::vector<FileEnvironment> ReadEnvironments(std::istream& file) {
+    u32 num_envs{};
+    file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+    std::vector<FileEnvironment> envs(num_envs);
+    for (FileEnvironment& env : envs) {
+        env.Deserialize(file);
+    }
+    return envs;
+}
+
+/// Reads the environments referenced by a pipeline, leaving the stream at the pipeline key
+std::optional<std::vector<FileEnvironment>> ReadEnvironmentRefs(
+    std::istream& file, const std::unordered_map<u64, std::vector<char>>& env_blobs) {
+    u32 num_envs{};
+    file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+    std::vector<FileEnvironment> envs(num_envs);
+    for (FileEnvironment& env : envs) {
+        u64 env_hash{};
+        file.read(reinterpret_cast<char*>(&env_hash), sizeof(env_hash));
+        const auto it = env_blobs.find(env_hash);
+        if (it == env_blobs.end()) {
+            return std::nullopt;
+        }
+        SpanStreamBuffer buffer{it->second};
+        std::istream stream{&buffer};
+        stream.exceptions(std::ios::failbit);
+        env.Deserialize(stream);
+    }
+    return envs;
+}
+
+void DeserializeRecord(PipelineRecord& record,
+                       const std::unordered_map<u64, std::vector<char>>& env_blobs) try {
+    SpanStreamBuffer buffer{record.data};
+    std::istream stream{&buffer};
+    stream.exceptions(std::ios::failbit);
+    if (record.kind == RecordKind::PipelineRef) {
+        auto envs = ReadEnvironmentRefs(stream, env_blobs);
+        if (!envs) {
+            record.is_valid = false;
+            return;
+        }
+        record.envs = std::move(*envs);
+    } else {
+        record.envs = ReadEnvironments(stream);
+    }
+    record.key_offset = buffer.Position();
+    record.is_valid = !record.envs.empty();
+} catch (const std::ios_base::failure&) {
+    record.is_valid = false;
+}
+
+void DispatchPipeline(std::istream& file, std::vector<FileEnvironment> envs,
+                      LoadComputeFunc& load_compute, LoadGraphicsFunc& load_graphics) {
+    if (envs.front().ShaderStage() == Shader::Stage::Compute) {
+        load_compute(file, std::move(envs.front()));
+    } else {
+        load_graphics(file, std::move(envs));
+    }
+}
+
+/// Drops a damaged tail, so pipelines appended later in the session stay reachable
+void TruncatePipelineCache(const std::filesystem::path& filename, u64 valid_size) {
+    LOG_WARNING(Common_Filesystem, "Pipeline cache is damaged past offset {}, truncating it",
+                valid_size);
+    std::error_code ec;
+    std::filesystem::resize_file(filename, valid_size, ec);
+    if (ec) {
+        LOG_ERROR(Common_Filesystem, "Failed to truncate pipeline cache file {}: {}",
+                  Common::FS::PathToUTF8String(filename), ec.message());
+    }
+}
+
+void LoadPipelineRecords(std::stop_token stop_loading, std::ifstream& file, std::streamoff end,
+                         const std::filesystem::path& filename, LoadComputeFunc& load_compute,
+                         LoadGraphicsFunc& load_graphics) {
+    Common::ThreadWorker parsers(std::max(std::thread::hardware_concurrency(), 2U) / 2,
+                                 "PipelineParser");
+    std::vector<PipelineRecord> batch;
+    std::unordered_map<u64, std::vector<char>> env_blobs;
+    std::unordered_set<u64> env_hashes;
+    std::streamoff offset = file.tellg();
+    bool is_damaged = false;
+    while (offset != end && !is_damaged) {
+        // Framing lets records be read with plain sequential I/O and decoded on several threads
+        batch.clear();
+        while (offset != end && batch.size() < PIPELINES_PER_BATCH) {
+            RecordHeader header{};
+            if (end - offset < static_cast<std::streamoff>(sizeof(header)) ||
+                !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+                end - offset - static_cast<std::streamoff>(sizeof(header)) < header.size) {
+                is_damaged = true;
+                break;
+            }
+            std::vector<char> data(header.size);
+            file.read(data.data(), header.size);
+            if (header.checksum != RecordChecksum(data)) {
+                is_damaged = true;
+                break;
+            }
+            switch (header.kind) {
+            case RecordKind::Pipeline:
+            case RecordKind::PipelineRef:
+                batch.push_back(PipelineRecord{.kind = header.kind, .data = std::move(data)});
+                break;
+            case RecordKind::Environment:
+                env_hashes.insert(header.checksum);
+                env_blobs.emplace(header.checksum, std::move(data));
+                break;
+            default:
+                is_damaged = true;
+                break;
+            }
+            if (is_damaged) {
+                break;
+            }
+            offset += sizeof(header) + header.size;
+        }
+        // Environments are only inserted while reading, parsers can look them up concurrently
+        for (PipelineRecord& record : batch) {
+            parsers.QueueWork([&record, &env_blobs] { DeserializeRecord(record, env_blobs); });
+        }
+        parsers.WaitForRequests(stop_loading);
+        for (PipelineRecord& record : batch) {
+            if (stop_loading.stop_requested()) {
+                return;
+            }
+            if (!record.is_valid) {
+                LOG_ERROR(Common_Filesystem, "Skipping malformed pipeline cache entry");
+                continue;
+            }
+            SpanStreamBuffer buffer{std::span(record.data).subspan(record.key_offset)};
+            std::istream stream{&buffer};
+            stream.exceptions(std::ios::failbit);
+            DispatchPipeline(stream, std::move(record.envs), load_compute, load_graphics);
+        }
+    }
+    if (is_damaged) {
+        file.close();
+        TruncatePipelineCache(filename, static_cast<u64>(offset));
+    }
+    std::scoped_lock lock{serialized_envs_mutex};
+    serialized_envs[filename.string()] = std::move(env_hashes);
+}
+
+/// Loads a cache in the previous layout and rewrites it framed, so later boots parse it in parallel
+void MigrateLegacyPipelines(std::stop_token stop_loading, std::ifstream& file, std::streamoff end,
+                            const std::filesystem::path& filename, u32 cache_version,
+                            LoadComputeFunc& load_compute, LoadGraphicsFunc& load_graphics) {
+    std::vector<std::pair<std::streamoff, std::streamoff>> records;
+    while (file.tellg() != end) {
+        if (stop_loading.stop_requested()) {
+            return;
+        }
+        const std::streamoff begin = file.tellg();
+        DispatchPipeline(file, ReadEnvironments(file), load_compute, load_graphics);
+        records.emplace_back(begin, file.tellg());
+    }
+
+    auto migrated_filename = filename;
+    migrated_filename += ".migrate";
+    {
+        std::ofstream migrated(migrated_filename, std::ios::binary | std::ios::trunc);
+        migrated.exceptions(std::ios::failbit);
+        migrated.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+        std::vector<char> data;
+        for (const auto& [begin, record_end] : records) {
+            data.resize(static_cast<size_t>(record_end - begin));
+            file.seekg(begin);
+            file.read(data.data(), data.size());
+            WriteRecord(migrated, RecordKind::Pipeline, data);
+        }
+    }
+    file.close();
+    // Common::FS::RenameFile refuses to overwrite, the old cache has to be replaced in one step
+    std::error_code ec;
+    std::filesystem::rename(migrated_filename, filename, ec);
+    if (ec) {
+        LOG_ERROR(Common_Filesystem, "Failed to replace pipeline cache file {}: {}",
+                  Common::FS::PathToUTF8String(filename), ec.message());
+        Common::FS::RemoveFile(migrated_filename);
+        // Start a fresh cache rather than appending framed records to the legacy one
+        if (!Common::FS::RemoveFile(filename)) {
+            LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+                      Common::FS::PathToUTF8String(filename));
+            std::scoped_lock lock{serialized_envs_mutex};
+            legacy_files.insert(filename.string());
+        }
+        return;
+    }
+    LOG_INFO(Common_Filesystem, "Migrated {} pipelines to the new cache format", records.size());
+}
+} // Anonymous namespace
+
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
                        const std::filesystem::path& filename, u32 cache_version) try {
+    std::scoped_lock lock{serialized_envs_mutex};
+    if (legacy_files.contains(filename.string())) {
+        return;
+    }
+    std::unordered_set<u64>& written_envs = serialized_envs[filename.string()];
     std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
     file.exceptions(std::ifstream::failbit);
     if (!file.is_open()) {
@@ -593,21 +871,45 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
     }
     if (file.tellp() == 0) {
         // Write header
+        written_envs.clear();
         file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
             .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
     }
     if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
         return;
     }
+    std::ostringstream record;
+    record.exceptions(std::ios::failbit);
     const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
+    record.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
     for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
+        // The same shader is usually shared by many pipelines, store it once and refer to it
+        std::ostringstream env_record;
+        env_record.exceptions(std::ios::failbit);
+        env->Serialize(env_record);
+        const std::string env_data{std::move(env_record).str()};
+        const u64 env_hash{RecordChecksum(env_data)};
+        if (!written_envs.contains(env_hash)) {
+            if (!WriteRecord(file, RecordKind::Environment, env_data)) {
+                // The pipeline would refer to an environment missing from the file
+                return;
+            }
+            written_envs.insert(env_hash);
+        }
+        record.write(reinterpret_cast<const char*>(&env_hash), sizeof(env_hash));
     }
-    file.write(key.data(), key.size_bytes());
+    record.write(key.data(), key.size_bytes());
+
+    const std::string data{std::move(record).str()};
+    WriteRecord(file, RecordKind::PipelineRef, data);
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
+    {
+        // The environments written so far are lost with the file
+        std::scoped_lock lock{serialized_envs_mutex};
+        serialized_envs.erase(filename.string());
+    }
     if (!Common::FS::RemoveFile(filename)) {
         LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
                   Common::FS::PathToUTF8String(filename));
@@ -616,27 +918,34 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
 
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
+    Common::UniqueFunction<void, std::istream&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>> load_graphics) try {
     std::ifstream file(filename, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         return;
     }
     file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
+    const std::streamoff end{file.tellg()};
     file.seekg(0, std::ios::beg);
 
     std::array<char, 8> magic_number;
     u32 cache_version;
     file.read(magic_number.data(), magic_number.size())
         .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    if (magic_number == LEGACY_MAGIC_NUMBER && cache_version == expected_cache_version) {
+        MigrateLegacyPipelines(stop_loading, file, end, filename, cache_version, load_compute,
+                               load_graphics);
+        return;
+    }
     if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
         file.close();
         if (Common::FS::RemoveFile(filename)) {
-            if (magic_number != MAGIC_NUMBER) {
+            if (magic_number != MAGIC_NUMBER && magic_number != LEGACY_MAGIC_NUMBER &&
+                magic_number != FRAMED_V1_MAGIC_NUMBER) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
             }
-            if (cache_version != expected_cache_version) {
+            if (magic_number == FRAMED_V1_MAGIC_NUMBER ||
+                cache_version != expected_cache_version) {
                 LOG_INFO(Common_Filesystem, "Deleting old pipeline cache");
             }
         } else {
@@ -646,22 +955,7 @@ void LoadPipelines(
         }
         return;
     }
-    while (file.tellg() != end) {
-        if (stop_loading.stop_requested()) {
-            return;
-        }
-        u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
-        std::vector<FileEnvironment> envs(num_envs);
-        for (FileEnvironment& env : envs) {
-            env.Deserialize(file);
-        }
-        if (envs.front().ShaderStage() == Shader::Stage::Compute) {
-            load_compute(file, std::move(envs.front()));
-        } else {
-            load_graphics(file, std::move(envs));
-        }
-    }
+    LoadPipelineRecords(stop_loading, file, end, filename, load_compute, load_graphics);
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
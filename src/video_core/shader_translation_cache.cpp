@@ -0,0 +1,421 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <map>
+#include <ranges>
+#include <system_error>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "video_core/shader_translation_cache.h"
+
+namespace VideoCommon {
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 't', 'r', 'n', 's'};
+constexpr u32 FILE_VERSION = 2;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+    u64 fingerprint;
+};
+static_assert(sizeof(FileHeader) == 24);
+
+struct RecordHeader {
+    u64 key;
+    u64 checksum;
+    u32 size;
+    u32 reserved;
+};
+static_assert(sizeof(RecordHeader) == 24);
+
+template <typename T>
+concept Container = !std::is_trivially_copyable_v<T> && std::ranges::sized_range<T>;
+
+/// Boost containers store their elements contiguously without modeling contiguous_range
+template <typename T>
+concept TriviallyCopyableArray = requires(T& container) {
+    { container.data() } -> std::convertible_to<const typename T::value_type*>;
+} && std::is_trivially_copyable_v<typename T::value_type>;
+
+class Writer {
+public:
+    explicit Writer(std::vector<char>& data_) : data{data_} {}
+
+    template <typename... Ts>
+    void operator()(const Ts&... values) {
+        (Write(values), ...);
+    }
+
+private:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Write(const T& value) {
+        WriteBytes(&value, sizeof(value));
+    }
+
+    template <Container T>
+    void Write(const T& container) {
+        Write(static_cast<u32>(std::ranges::size(container)));
+        if constexpr (TriviallyCopyableArray<T>) {
+            WriteBytes(container.data(), container.size() * sizeof(typename T::value_type));
+        } else {
+            for (const auto& [key, value] : container) {
+                Write(key);
+                Write(value);
+            }
+        }
+    }
+
+    void WriteBytes(const void* bytes, size_t size) {
+        const size_t offset = data.size();
+        data.resize(offset + size);
+        std::memcpy(data.data() + offset, bytes, size);
+    }
+
+    std::vector<char>& data;
+};
+
+class Reader {
+public:
+    explicit Reader(std::span<const char> data_) : data{data_} {}
+
+    template <typename... Ts>
+    void operator()(Ts&... values) {
+        (Read(values), ...);
+    }
+
+    [[nodiscard]] bool Failed() const noexcept {
+        return failed;
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept {
+        return offset == data.size();
+    }
+
+private:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Read(T& value) {
+        ReadBytes(&value, sizeof(value));
+    }
+
+    template <Container T>
+    void Read(T& container) {
+        u32 count{};
+        Read(count);
+        if (failed || count > container.max_size() || count > data.size() - offset) {
+            failed = true;
+            return;
+        }
+        container.clear();
+        if constexpr (TriviallyCopyableArray<T>) {
+            container.resize(count);
+            ReadBytes(container.data(), count * sizeof(typename T::value_type));
+        } else {
+            for (u32 index = 0; index < count && !failed; ++index) {
+                typename T::key_type key{};
+                typename T::mapped_type value{};
+                Read(key);
+                Read(value);
+                container.emplace(key, value);
+            }
+        }
+    }
+
+    void ReadBytes(void* bytes, size_t size) {
+        if (failed || size > data.size() - offset) {
+            failed = true;
+            return;
+        }
+        std::memcpy(bytes, data.data() + offset, size);
+        offset += size;
+    }
+
+    std::span<const char> data;
+    size_t offset = 0;
+    bool failed = false;
+};
+
+/// Lists every member of Shader::Info, has to be kept in sync with it
+template <typename Archive, typename Info>
+void VisitInfo(Archive& ar, Info& info) {
+    ar(info.uses_workgroup_id, info.uses_local_invocation_id, info.uses_invocation_id,
+       info.uses_invocation_info, info.uses_sample_id, info.uses_is_helper_invocation,
+       info.uses_subgroup_invocation_id, info.uses_subgroup_shuffles, info.uses_patches,
+       info.interpolation, info.loads, info.stores, info.passthrough, info.legacy_stores_mapping,
+       info.loads_indexed_attributes, info.stores_frag_color, info.stores_sample_mask,
+       info.stores_frag_depth, info.stores_tess_level_outer, info.stores_tess_level_inner,
+       info.stores_indexed_attributes, info.stores_global_memory, info.uses_local_memory);
+    ar(info.uses_fp16, info.uses_fp64, info.uses_fp16_denorms_flush,
+       info.uses_fp16_denorms_preserve, info.uses_fp32_denorms_flush,
+       info.uses_fp32_denorms_preserve, info.uses_int8, info.uses_int16, info.uses_int64,
+       info.uses_image_1d, info.uses_sampled_1d, info.uses_sparse_residency,
+       info.uses_demote_to_helper_invocation, info.uses_subgroup_vote, info.uses_subgroup_mask,
+       info.uses_fswzadd, info.uses_derivatives, info.uses_typeless_image_reads,
+       info.uses_typeless_image_writes, info.uses_image_buffers, info.uses_shared_increment,
+       info.uses_shared_decrement, info.uses_global_increment, info.uses_global_decrement,
+       info.uses_atomic_f32_add, info.uses_atomic_f16x2_add, info.uses_atomic_f16x2_min,
+       info.uses_atomic_f16x2_max, info.uses_atomic_f32x2_add, info.uses_atomic_f32x2_min,
+       info.uses_atomic_f32x2_max, info.uses_atomic_s32_min, info.uses_atomic_s32_max,
+       info.uses_int64_bit_atomics, info.uses_global_memory, info.uses_atomic_image_u32,
+       info.uses_shadow_lod, info.uses_rescaling_uniform, info.uses_cbuf_indirect,
+       info.uses_render_area);
+    ar(info.used_constant_buffer_types, info.used_storage_buffer_types,
+       info.used_indirect_cbuf_types, info.constant_buffer_mask, info.constant_buffer_used_sizes,
+       info.nvn_buffer_base, info.nvn_buffer_used, info.requires_layer_emulation,
+       info.emulated_layer, info.used_clip_distances, info.constant_buffer_descriptors,
+       info.storage_buffers_descriptors, info.texture_buffer_descriptors,
+       info.image_buffer_descriptors, info.texture_descriptors, info.image_descriptors);
+}
+
+/// Lists every member of Shader::Profile, has to be kept in sync with it
+template <typename Archive>
+void VisitProfile(Archive& ar, const Shader::Profile& profile) {
+    ar(profile.supported_spirv, profile.unified_descriptor_binding,
+       profile.support_descriptor_aliasing, profile.support_int8, profile.support_int16,
+       profile.support_int64, profile.support_vertex_instance_id, profile.support_float_controls,
+       profile.support_separate_denorm_behavior, profile.support_separate_rounding_mode,
+       profile.support_fp16_denorm_preserve, profile.support_fp32_denorm_preserve,
+       profile.support_fp16_denorm_flush, profile.support_fp32_denorm_flush,
+       profile.support_fp16_signed_zero_nan_preserve,
+       profile.support_fp32_signed_zero_nan_preserve,
+       profile.support_fp64_signed_zero_nan_preserve, profile.support_explicit_workgroup_layout,
+       profile.support_vote, profile.support_viewport_index_layer_non_geometry,
+       profile.support_viewport_mask, profile.support_typeless_image_loads,
+       profile.support_demote_to_helper_invocation, profile.support_int64_atomics,
+       profile.support_derivative_control, profile.support_geometry_shader_passthrough,
+       profile.support_native_ndc, profile.support_gl_nv_gpu_shader_5,
+       profile.support_gl_amd_gpu_shader_half_float, profile.support_gl_texture_shadow_lod,
+       profile.support_gl_warp_intrinsics, profile.support_gl_variable_aoffi,
+       profile.support_gl_sparse_textures, profile.support_gl_derivative_control,
+       profile.support_scaled_attributes, profile.support_multi_viewport,
+       profile.support_geometry_streams);
+    ar(profile.warp_size_potentially_larger_than_guest, profile.lower_left_origin_mode,
+       profile.need_declared_frag_colors, profile.need_fastmath_off,
+       profile.need_gather_subpixel_offset, profile.has_broken_spirv_clamp,
+       profile.has_broken_spirv_position_input, profile.has_broken_unsigned_image_offsets,
+       profile.has_broken_signed_operations, profile.has_broken_fp16_float_controls,
+       profile.has_gl_component_indexing_bug, profile.has_gl_precise_bug,
+       profile.has_gl_cbuf_ftou_bug, profile.has_gl_bool_ref_bug,
+       profile.ignore_nan_fp_comparisons,
+       profile.has_broken_spirv_subgroup_mask_vector_extract_dynamic,
+       profile.gl_max_compute_smem_size, profile.has_broken_robust, profile.min_ssbo_alignment,
+       profile.max_user_clip_distances);
+}
+
+/// Lists every member of Shader::HostTranslateInfo, has to be kept in sync with it
+template <typename Archive>
+void VisitHostInfo(Archive& ar, const Shader::HostTranslateInfo& host_info) {
+    ar(host_info.support_float64, host_info.support_float16, host_info.support_int64,
+       host_info.needs_demote_reorder, host_info.support_snorm_render_buffer,
+       host_info.support_viewport_index_layer, host_info.min_ssbo_alignment,
+       host_info.support_geometry_shader_passthrough, host_info.support_conditional_barrier);
+}
+
+/// Lists the settings read by the shader recompiler
+template <typename Archive>
+void VisitSettings(Archive& ar) {
+    const auto& resolution_info = Settings::values.resolution_info;
+    ar(resolution_info.up_scale, resolution_info.down_shift, resolution_info.up_factor,
+       resolution_info.down_factor, resolution_info.active, resolution_info.downscale);
+    ar(Settings::values.renderer_debug.GetValue(),
+       Settings::values.disable_shader_loop_safety_checks.GetValue());
+}
+
+template <typename Archive, typename TranslatedShaderType>
+void VisitShader(Archive& ar, TranslatedShaderType& shader) {
+    ar(shader.stage_index);
+    VisitInfo(ar, shader.info);
+    ar(shader.source, shader.spirv);
+}
+
+u64 Checksum(std::span<const char> data) {
+    return Common::CityHash64(data.data(), data.size());
+}
+} // Anonymous namespace
+
+ShaderTranslationCache::ShaderTranslationCache() = default;
+
+ShaderTranslationCache::~ShaderTranslationCache() = default;
+
+u64 ShaderTranslationCache::MakeFingerprint(std::string_view host_identity, u32 cache_version,
+                                            const Shader::Profile& profile,
+                                            const Shader::HostTranslateInfo& host_info) {
+    const std::string identity{fmt::format("{} {} {} {} {}", Common::g_scm_rev, host_identity,
+                                           cache_version, FILE_VERSION, sizeof(Shader::Info))};
+    // Written member by member, the padding of these structures is not initialized
+    std::vector<char> data(identity.begin(), identity.end());
+    Writer writer{data};
+    VisitProfile(writer, profile);
+    VisitHostInfo(writer, host_info);
+    VisitSettings(writer);
+    return Checksum(data);
+}
+
+void ShaderTranslationCache::Open(const std::filesystem::path& filename, u64 fingerprint) {
+    std::scoped_lock lock{mutex};
+    path = filename;
+    entries.clear();
+    file.Open(path, Common::FS::FileAccessMode::ReadAppend, Common::FS::FileType::BinaryFile);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open shader translation cache {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    file_size = file.GetSize();
+
+    FileHeader header{};
+    if (!file.Seek(0) || !file.ReadObject(header) || header.magic != MAGIC_NUMBER ||
+        header.version != FILE_VERSION || header.fingerprint != fingerprint) {
+        if (file_size != 0) {
+            LOG_INFO(Common_Filesystem, "Discarding outdated shader translation cache");
+        }
+        if (!Reset(fingerprint)) {
+            LOG_ERROR(Common_Filesystem, "Failed to create shader translation cache {}",
+                      Common::FS::PathToUTF8String(path));
+            file.Close();
+        }
+        return;
+    }
+    u64 offset{sizeof(FileHeader)};
+    while (offset != file_size) {
+        RecordHeader record{};
+        if (file_size - offset < sizeof(RecordHeader) || !file.ReadObject(record) ||
+            file_size - offset - sizeof(RecordHeader) < record.size) {
+            break;
+        }
+        offset += sizeof(RecordHeader);
+        entries.insert_or_assign(record.key, Entry{
+                                                 .offset = offset,
+                                                 .size = record.size,
+                                                 .checksum = record.checksum,
+                                             });
+        offset += record.size;
+        if (!file.Seek(static_cast<s64>(offset))) {
+            break;
+        }
+    }
+    if (offset != file_size) {
+        // Drop a partially written record, records appended later would be unreachable otherwise
+        LOG_WARNING(Common_Filesystem, "Shader translation cache is damaged, truncating it");
+        file.Close();
+        std::error_code ec;
+        std::filesystem::resize_file(path, offset, ec);
+        file.Open(path, Common::FS::FileAccessMode::ReadAppend, Common::FS::FileType::BinaryFile);
+        if (ec || !file.IsOpen()) {
+            file.Close();
+            entries.clear();
+            return;
+        }
+        file_size = offset;
+    }
+    LOG_INFO(Common_Filesystem, "Loaded {} translated pipelines from disk", entries.size());
+}
+
+std::optional<std::vector<TranslatedShader>> ShaderTranslationCache::Find(
+    u64 hash, std::span<const char> key) {
+    std::vector<char> data;
+    u64 checksum{};
+    {
+        std::scoped_lock lock{mutex};
+        const auto it = entries.find(hash);
+        if (it == entries.end()) {
+            return std::nullopt;
+        }
+        data.resize(it->second.size);
+        checksum = it->second.checksum;
+        if (!file.Seek(static_cast<s64>(it->second.offset)) ||
+            file.ReadSpan(std::span<char>(data)) != data.size()) {
+            LOG_ERROR(Common_Filesystem, "Failed to read translated pipeline {:016x}", hash);
+            entries.erase(it);
+            return std::nullopt;
+        }
+    }
+    Reader reader{data};
+    std::vector<char> stored_key;
+    u32 num_shaders{};
+    reader(stored_key, num_shaders);
+    std::vector<TranslatedShader> shaders(reader.Failed() ? 0 : std::min<size_t>(num_shaders, 6));
+    for (TranslatedShader& shader : shaders) {
+        VisitShader(reader, shader);
+    }
+    if (Checksum(data) != checksum || reader.Failed() || !reader.AtEnd() ||
+        shaders.size() != num_shaders) {
+        LOG_ERROR(Common_Filesystem, "Translated pipeline {:016x} is corrupted", hash);
+        std::scoped_lock lock{mutex};
+        entries.erase(hash);
+        return std::nullopt;
+    }
+    if (!std::ranges::equal(stored_key, key)) {
+        // Another pipeline with the same hash
+        return std::nullopt;
+    }
+    return shaders;
+}
+
+void ShaderTranslationCache::Store(u64 hash, std::span<const char> key,
+                                   std::span<const TranslatedShader> shaders) {
+    std::vector<char> data;
+    Writer writer{data};
+    writer(std::vector<char>(key.begin(), key.end()), static_cast<u32>(shaders.size()));
+    for (const TranslatedShader& shader : shaders) {
+        VisitShader(writer, shader);
+    }
+    const RecordHeader record{
+        .key = hash,
+        .checksum = Checksum(data),
+        .size = static_cast<u32>(data.size()),
+        .reserved = 0,
+    };
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen() || entries.contains(hash)) {
+        return;
+    }
+    // Find reads from the same update stream, it has to be repositioned before writing
+    if (!file.Seek(0, Common::FS::SeekOrigin::End) || !file.WriteObject(record) ||
+        file.WriteSpan(std::span<const char>(data)) != data.size() || !file.Flush()) {
+        LOG_ERROR(Common_Filesystem, "Failed to write shader translation cache, disabling it");
+        file.Close();
+        entries.clear();
+        return;
+    }
+    entries.emplace(hash, Entry{
+                             .offset = file_size + sizeof(RecordHeader),
+                             .size = record.size,
+                             .checksum = record.checksum,
+                         });
+    file_size += sizeof(RecordHeader) + data.size();
+}
+
+bool ShaderTranslationCache::Reset(u64 fingerprint) {
+    file.Close();
+    file_size = 0;
+    file.Open(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    const FileHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = FILE_VERSION,
+        .reserved = 0,
+        .fingerprint = fingerprint,
+    };
+    if (!file.IsOpen() || !file.WriteObject(header)) {
+        return false;
+    }
+    file.Close();
+    file.Open(path, Common::FS::FileAccessMode::ReadAppend, Common::FS::FileType::BinaryFile);
+    file_size = sizeof(FileHeader);
+    return file.IsOpen();
+}
+
+} // namespace VideoCommon
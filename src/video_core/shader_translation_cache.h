@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/profile.h"
+#include "shader_recompiler/shader_info.h"
+
+namespace VideoCommon {
+
+/// Backend output of the shader recompiler for a single stage of a pipeline
+struct TranslatedShader {
+    u32 stage_index{};
+    Shader::Info info;
+    std::string source;     ///< GLSL or GLASM source
+    std::vector<u32> spirv; ///< SPIR-V words
+};
+
+/**
+ * Persistent cache of translated shaders, keyed by pipeline key.
+ *
+ * Warm boots take the backend code and shader info from here instead of running the recompiler,
+ * only the host driver compiles the result. The file is discarded when its fingerprint, which
+ * covers the emulator build, the host device and the settings affecting translation, doesn't
+ * match. Records store the whole pipeline key, so a hash collision is a miss.
+ */
+class ShaderTranslationCache {
+public:
+    ShaderTranslationCache();
+    ~ShaderTranslationCache();
+
+    /// Computes the fingerprint of everything besides the pipeline key affecting translation
+    [[nodiscard]] static u64 MakeFingerprint(std::string_view host_identity, u32 cache_version,
+                                             const Shader::Profile& profile,
+                                             const Shader::HostTranslateInfo& host_info);
+
+    /// Opens the cache file and reads its index, recreates it on a fingerprint mismatch
+    void Open(const std::filesystem::path& filename, u64 fingerprint);
+
+    /// Returns the cached translation of a pipeline, or nothing on a miss
+    template <typename Key>
+    [[nodiscard]] std::optional<std::vector<TranslatedShader>> Find(const Key& key) {
+        return Find(key.Hash(), KeyBytes(key));
+    }
+
+    /// Stores the translation of a pipeline
+    template <typename Key>
+    void Store(const Key& key, std::span<const TranslatedShader> shaders) {
+        Store(key.Hash(), KeyBytes(key), shaders);
+    }
+
+private:
+    /// Bytes of a pipeline key, graphics keys only use the state their Size() covers
+    template <typename Key>
+    static std::span<const char> KeyBytes(const Key& key) {
+        if constexpr (requires { key.Size(); }) {
+            return std::span(reinterpret_cast<const char*>(&key), key.Size());
+        } else {
+            return std::span(reinterpret_cast<const char*>(&key), sizeof(key));
+        }
+    }
+
+    std::optional<std::vector<TranslatedShader>> Find(u64 hash, std::span<const char> key);
+
+    void Store(u64 hash, std::span<const char> key, std::span<const TranslatedShader> shaders);
+
+    struct Entry {
+        u64 offset;
+        u32 size;
+        u64 checksum;
+    };
+
+    bool Reset(u64 fingerprint);
+
+    std::mutex mutex;
+    std::filesystem::path path;
+    Common::FS::IOFile file;
+    u64 file_size = 0;
+    std::unordered_map<u64, Entry> entries;
+};
+
+} // namespace VideoCommon
@@ -167,6 +167,11 @@ void TextureCache<P>::TickFrame() {
     }
 }
 
+template <class P>
+void TextureCache<P>::LoadDiskResources(u64 title_id) {
+    transcode_cache.Open(title_id);
+}
+
 template <class P>
 const typename P::ImageView& TextureCache<P>::GetImageView(ImageViewId id) const noexcept {
     return slot_image_views[id];
@@ -1090,7 +1095,7 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
-        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies, &transcode_cache);
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1140,8 +1145,10 @@ template <class P>
 ImageId TextureCache<P>::FindOrInsertImage(const ImageInfo& info, GPUVAddr gpu_addr,
                                            RelaxedOptions options) {
     if (const ImageId image_id = FindImage(info, gpu_addr, options); image_id) {
+        ++image_counters.hits;
         return image_id;
     }
+    ++image_counters.misses;
     return InsertImage(info, gpu_addr, options);
 }
 
@@ -1296,12 +1303,12 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
                                  local_unswizzle_data_buffer);
     const size_t out_size = MapSizeBytes(image);
 
-    auto func = [out_size, copies, info = image.info,
+    auto func = [this, out_size, copies, info = image.info,
                  input = std::move(local_unswizzle_data_buffer),
                  async_decode = decode_ptr]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
         std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        ConvertImage(input, info, async_decode->decoded_data, copies_span, &transcode_cache);
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
@@ -2119,22 +2126,21 @@ void TextureCache<P>::TrackImage(ImageBase& image, ImageId image_id) {
         }
         return;
     }
+    boost::container::small_vector<std::pair<DAddr, size_t>, 16> ranges;
     if (True(image.flags & ImageFlagBits::Registered)) {
         auto it = sparse_views.find(image_id);
         ASSERT(it != sparse_views.end());
         auto& sparse_maps = it->second;
         for (auto& map_view_id : sparse_maps) {
             const auto& map = slot_map_views[map_view_id];
-            const DAddr cpu_addr = map.cpu_addr;
-            const std::size_t size = map.size;
-            device_memory.UpdatePagesCachedCount(cpu_addr, size, 1);
+            ranges.emplace_back(map.cpu_addr, map.size);
         }
-        return;
+    } else {
+        ForEachSparseSegment(image,
+                             [&ranges]([[maybe_unused]] GPUVAddr gpu_addr, DAddr cpu_addr,
+                                       size_t size) { ranges.emplace_back(cpu_addr, size); });
     }
-    ForEachSparseSegment(image,
-                         [this]([[maybe_unused]] GPUVAddr gpu_addr, DAddr cpu_addr, size_t size) {
-                             device_memory.UpdatePagesCachedCount(cpu_addr, size, 1);
-                         });
+    device_memory.UpdatePagesCachedBatch({ranges.data(), ranges.size()}, 1);
 }
 
 template <class P>
@@ -2151,12 +2157,12 @@ void TextureCache<P>::UntrackImage(ImageBase& image, ImageId image_id) {
     auto it = sparse_views.find(image_id);
     ASSERT(it != sparse_views.end());
     auto& sparse_maps = it->second;
+    boost::container::small_vector<std::pair<DAddr, size_t>, 16> ranges;
     for (auto& map_view_id : sparse_maps) {
         const auto& map = slot_map_views[map_view_id];
-        const DAddr cpu_addr = map.cpu_addr;
-        const std::size_t size = map.size;
-        device_memory.UpdatePagesCachedCount(cpu_addr, size, -1);
+        ranges.emplace_back(map.cpu_addr, map.size);
     }
+    device_memory.UpdatePagesCachedBatch({ranges.data(), ranges.size()}, -1);
 }
 
 template <class P>
@@ -23,6 +23,7 @@
 #include "common/scratch_buffer.h"
 #include "common/slot_vector.h"
 #include "common/thread_worker.h"
+#include "video_core/cache_types.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/control/channel_state_cache.h"
 #include "video_core/delayed_destruction_ring.h"
@@ -33,6 +34,7 @@
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
 
@@ -134,6 +136,9 @@ public:
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
+    /// Select the title whose CPU transcoded textures are persisted on disk
+    void LoadDiskResources(u64 title_id);
+
     /// Return a constant reference to the given image view id
     [[nodiscard]] const ImageView& GetImageView(ImageViewId id) const noexcept;
 
@@ -250,6 +255,11 @@ public:
     /// Prepare an image to be used
     void PrepareImage(ImageId image_id, bool is_modification, bool invalidate);
 
+    /// Return the lookup counters of the images requested by the guest
+    [[nodiscard]] const CacheCounters& ImageCounters() const noexcept {
+        return image_counters;
+    }
+
     std::recursive_mutex mutex;
 
 private:
@@ -488,7 +498,9 @@ private:
 
     u64 modification_tick = 0;
     u64 frame_tick = 0;
+    CacheCounters image_counters;
 
+    TranscodeCache transcode_cache;
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+namespace VideoCommon {
+
+using namespace Common::Literals;
+
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 't', 'x', 'c', 'c'};
+constexpr u32 CACHE_VERSION = 1;
+
+/// Stop growing the cache past this size, old entries stay valid
+constexpr u64 MAX_BLOB_SIZE = 4_GiB;
+
+/// Drop stores while this many bytes wait for the worker
+constexpr size_t MAX_QUEUED_BYTES = 256_MiB;
+
+struct IndexHeader {
+    std::array<char, 8> magic;
+    u32 version;
+    u32 reserved;
+};
+static_assert(sizeof(IndexHeader) == 16);
+} // Anonymous namespace
+
+TranscodeCache::TranscodeCache() : worker{1, "TranscodeCache"} {}
+
+TranscodeCache::~TranscodeCache() {
+    worker.WaitForRequests();
+}
+
+void TranscodeCache::Open(u64 title_id) {
+    // Queued stores belong to the previous title
+    worker.WaitForRequests();
+    std::scoped_lock lock{mutex};
+    index_file.Close();
+    blob_file.Close();
+    entries.clear();
+    blob_size = 0;
+    is_loaded = false;
+    is_broken = title_id == 0;
+    if (is_broken) {
+        return;
+    }
+    const auto shader_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir)};
+    base_dir = shader_dir / fmt::format("{:016x}", title_id);
+}
+
+u64 TranscodeCache::MakeKey(std::span<const u8> guest_data, VideoCore::Surface::PixelFormat format,
+                            Settings::AstcRecompression recompression, Extent3D extent,
+                            s32 num_layers) {
+    const std::array<u32, 6> parameters{
+        static_cast<u32>(format), static_cast<u32>(recompression), extent.width,
+        extent.height,            extent.depth,                    static_cast<u32>(num_layers),
+    };
+    const u64 seed = Common::CityHash64(reinterpret_cast<const char*>(parameters.data()),
+                                        sizeof(parameters));
+    return Common::CityHash64WithSeed(reinterpret_cast<const char*>(guest_data.data()),
+                                      guest_data.size(), seed);
+}
+
+bool TranscodeCache::Load(u64 key, std::span<u8> output) {
+    std::vector<u8> compressed;
+    {
+        std::scoped_lock lock{mutex};
+        if (!EnsureLoaded()) {
+            return false;
+        }
+        const auto it = entries.find(key);
+        if (it == entries.end() || it->second.decompressed_size != output.size()) {
+            return false;
+        }
+        compressed.resize(it->second.compressed_size);
+        if (!blob_file.Seek(static_cast<s64>(it->second.offset)) ||
+            blob_file.ReadSpan(std::span<u8>(compressed)) != compressed.size()) {
+            LOG_ERROR(HW_GPU, "Failed to read transcoded texture {:016x}", key);
+            entries.erase(it);
+            return false;
+        }
+    }
+    const std::vector<u8> decompressed = Common::Compression::DecompressDataZSTD(compressed);
+    if (decompressed.size() != output.size()) {
+        LOG_ERROR(HW_GPU, "Transcoded texture {:016x} is corrupted", key);
+        return false;
+    }
+    std::memcpy(output.data(), decompressed.data(), output.size());
+    return true;
+}
+
+void TranscodeCache::Store(u64 key, std::span<const u8> data) {
+    {
+        std::scoped_lock lock{mutex};
+        if (!EnsureLoaded() || entries.contains(key) || queued_keys.contains(key) ||
+            queued_bytes + data.size() > MAX_QUEUED_BYTES) {
+            return;
+        }
+        queued_keys.insert(key);
+        queued_bytes += data.size();
+    }
+    worker.QueueWork([this, key, owned_data = std::vector<u8>(data.begin(), data.end())] {
+        Write(key, owned_data);
+    });
+}
+
+void TranscodeCache::Write(u64 key, std::span<const u8> data) {
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(data.data(), data.size());
+
+    std::scoped_lock lock{mutex};
+    queued_keys.erase(key);
+    queued_bytes -= data.size();
+    if (compressed.empty() || is_broken || blob_size + compressed.size() > MAX_BLOB_SIZE) {
+        return;
+    }
+    const IndexEntry entry{
+        .key = key,
+        .offset = blob_size,
+        .compressed_size = static_cast<u32>(compressed.size()),
+        .decompressed_size = static_cast<u32>(data.size()),
+    };
+    // Load reads the files, stdio requires a seek before switching to writing
+    if (!blob_file.Seek(static_cast<s64>(blob_size)) ||
+        blob_file.WriteSpan(std::span<const u8>(compressed)) != compressed.size() ||
+        !blob_file.Flush() || !index_file.Seek(0, Common::FS::SeekOrigin::End) ||
+        !index_file.WriteObject(entry) || !index_file.Flush()) {
+        LOG_ERROR(HW_GPU, "Failed to write transcoded texture cache, disabling it");
+        is_broken = true;
+        return;
+    }
+    blob_size += compressed.size();
+    entries.emplace(key, entry);
+}
+
+bool TranscodeCache::EnsureLoaded() {
+    if (is_loaded || is_broken) {
+        return is_loaded;
+    }
+    if (!Common::FS::CreateDirs(base_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create transcoded texture cache directory");
+        is_broken = true;
+        return false;
+    }
+    index_file.Open(base_dir / "transcoded_textures.idx", Common::FS::FileAccessMode::ReadAppend,
+                    Common::FS::FileType::BinaryFile);
+    blob_file.Open(base_dir / "transcoded_textures.bin", Common::FS::FileAccessMode::ReadAppend,
+                   Common::FS::FileType::BinaryFile);
+    if (!index_file.IsOpen() || !blob_file.IsOpen()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open transcoded texture cache");
+        is_broken = true;
+        return false;
+    }
+    blob_size = blob_file.GetSize();
+
+    IndexHeader header{};
+    if (!index_file.Seek(0) || !index_file.ReadObject(header) || header.magic != MAGIC_NUMBER ||
+        header.version != CACHE_VERSION) {
+        is_loaded = Reset();
+        is_broken = !is_loaded;
+        return is_loaded;
+    }
+    const u64 num_entries = (index_file.GetSize() - sizeof(IndexHeader)) / sizeof(IndexEntry);
+    std::vector<IndexEntry> index(num_entries);
+    if (index_file.ReadSpan(std::span<IndexEntry>(index)) != index.size()) {
+        is_loaded = Reset();
+        is_broken = !is_loaded;
+        return is_loaded;
+    }
+    for (const IndexEntry& entry : index) {
+        // Entries whose payload didn't make it to disk are ignored
+        if (entry.offset + entry.compressed_size <= blob_size) {
+            entries.insert_or_assign(entry.key, entry);
+        }
+    }
+    LOG_INFO(HW_GPU, "Loaded {} transcoded textures from disk", entries.size());
+    is_loaded = true;
+    return true;
+}
+
+bool TranscodeCache::Reset() {
+    index_file.Close();
+    blob_file.Close();
+    entries.clear();
+    blob_size = 0;
+
+    const auto index_path = base_dir / "transcoded_textures.idx";
+    const auto blob_path = base_dir / "transcoded_textures.bin";
+    index_file.Open(index_path, Common::FS::FileAccessMode::Write,
+                    Common::FS::FileType::BinaryFile);
+    const IndexHeader header{
+        .magic = MAGIC_NUMBER,
+        .version = CACHE_VERSION,
+        .reserved = 0,
+    };
+    if (!index_file.IsOpen() || !index_file.WriteObject(header)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create transcoded texture cache");
+        return false;
+    }
+    index_file.Close();
+    blob_file.Open(blob_path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    blob_file.Close();
+
+    index_file.Open(index_path, Common::FS::FileAccessMode::ReadAppend,
+                    Common::FS::FileType::BinaryFile);
+    blob_file.Open(blob_path, Common::FS::FileAccessMode::ReadAppend,
+                   Common::FS::FileType::BinaryFile);
+    return index_file.IsOpen() && blob_file.IsOpen();
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/settings_enums.h"
+#include "common/thread_worker.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+/**
+ * Persistent per-title cache of textures transcoded on the CPU (ASTC decoding and recompression,
+ * BCn decompression), so later sessions can skip the transcode.
+ *
+ * Payloads are Zstandard compressed and appended to a blob file, an append-only index file maps
+ * content keys to their location in the blob. The index is read on first use. Stores are
+ * compressed and written on a worker thread, off the GPU thread.
+ */
+class TranscodeCache {
+public:
+    TranscodeCache();
+    ~TranscodeCache();
+
+    /// Selects the directory of the running title, drops any previously opened cache
+    void Open(u64 title_id);
+
+    /// Computes the key of a transcode from its guest data and the parameters affecting the output
+    [[nodiscard]] static u64 MakeKey(std::span<const u8> guest_data,
+                                     VideoCore::Surface::PixelFormat format,
+                                     Settings::AstcRecompression recompression, Extent3D extent,
+                                     s32 num_layers);
+
+    /// Fills 'output' with the cached transcode of 'key', returns false on a miss
+    [[nodiscard]] bool Load(u64 key, std::span<u8> output);
+
+    /// Queues the transcoded 'data' of 'key' to be stored
+    void Store(u64 key, std::span<const u8> data);
+
+private:
+    struct IndexEntry {
+        u64 key;
+        u64 offset;
+        u32 compressed_size;
+        u32 decompressed_size;
+    };
+    static_assert(sizeof(IndexEntry) == 24);
+
+    bool EnsureLoaded();
+
+    /// Compresses and appends a queued store to the cache files, runs on the worker
+    void Write(u64 key, std::span<const u8> data);
+
+    bool Reset();
+
+    std::mutex mutex;
+    std::filesystem::path base_dir;
+    bool is_loaded = false;
+    bool is_broken = false;
+    Common::FS::IOFile index_file;
+    Common::FS::IOFile blob_file;
+    u64 blob_size = 0;
+    std::unordered_map<u64, IndexEntry> entries;
+    std::unordered_set<u64> queued_keys;
+    size_t queued_bytes = 0;
+    Common::ThreadWorker worker;
+};
+
+} // namespace VideoCommon
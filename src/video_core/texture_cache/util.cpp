@@ -19,6 +19,7 @@
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "common/scratch_buffer.h"
+#include "common/literals.h"
 #include "common/settings.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -29,6 +30,7 @@
 #include "video_core/texture_cache/format_lookup_table.h"
 #include "video_core/texture_cache/formatter.h"
 #include "video_core/texture_cache/samples_helper.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/util.h"
 #include "video_core/textures/astc.h"
 #include "video_core/textures/bcn.h"
@@ -62,6 +64,11 @@ using VideoCore::Surface::PixelFormatFromDepthFormat;
 using VideoCore::Surface::PixelFormatFromRenderTargetFormat;
 using VideoCore::Surface::SurfaceType;
 
+using namespace Common::Literals;
+
+/// Transcodes producing less data than this are cheaper to redo than to fetch from disk
+constexpr u32 MIN_DISK_TRANSCODE_SIZE = 64_KiB;
+
 struct LevelInfo {
     Extent3D size;
     Extent3D block;
@@ -911,11 +918,16 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
 }
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+                  std::span<BufferImageCopy> copies, TranscodeCache* transcode_cache) {
     u32 output_offset = 0;
     Common::ScratchBuffer<u8> decode_scratch;
 
     const Extent2D tile_size = DefaultBlockSize(info.format);
+    const auto recompression_setting = Settings::values.astc_recompression.GetValue();
+    const bool astc = IsPixelFormatASTC(info.format);
+    if (!Settings::values.use_disk_texture_cache.GetValue()) {
+        transcode_cache = nullptr;
+    }
     for (BufferImageCopy& copy : copies) {
         const u32 level = copy.image_subresource.base_level;
         const Extent3D mip_size = AdjustMipSize(info.size, level);
@@ -926,27 +938,57 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
         ASSERT(copy.buffer_image_height == Common::AlignUp(mip_size.height, tile_size.height));
 
         const auto input_offset = input.subspan(copy.buffer_offset);
+        const auto guest_data = input_offset.first(copy.buffer_size);
         copy.buffer_offset = output_offset;
 
-        const auto recompression_setting = Settings::values.astc_recompression.GetValue();
-        const bool astc = IsPixelFormatASTC(info.format);
+        u32 converted_size;
+        if (astc && recompression_setting == Settings::AstcRecompression::Uncompressed) {
+            converted_size = copy.image_extent.width * copy.image_extent.height *
+                             copy.image_subresource.num_layers *
+                             BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
+        } else if (astc) {
+            // BC1 uses 0.5 bytes per texel
+            // BC3 uses 1 byte per texel
+            const auto bpp_div = recompression_setting == Settings::AstcRecompression::Bc1 ? 2 : 1;
+            const u32 aligned_plane_dim = Common::AlignUp(copy.image_extent.width, 4) *
+                                          Common::AlignUp(copy.image_extent.height, 4);
+
+            copy.buffer_size =
+                (aligned_plane_dim * copy.image_extent.depth * copy.image_subresource.num_layers) /
+                bpp_div;
+            converted_size = static_cast<u32>(copy.buffer_size);
+        } else {
+            converted_size = copy.image_extent.width * copy.image_extent.height *
+                             copy.image_subresource.num_layers *
+                             ConvertedBytesPerBlock(info.format);
+        }
+        const std::span<u8> converted = output.subspan(output_offset, converted_size);
+
+        // 3D images are rare and their converted size doesn't account for depth, skip them
+        u64 transcode_key = 0;
+        if (transcode_cache && copy.image_extent.depth == 1 &&
+            converted_size >= MIN_DISK_TRANSCODE_SIZE) {
+            transcode_key =
+                TranscodeCache::MakeKey(guest_data, info.format, recompression_setting,
+                                        copy.image_extent, copy.image_subresource.num_layers);
+            if (transcode_cache->Load(transcode_key, converted)) {
+                transcode_key = 0;
+                output_offset += converted_size;
+                copy.buffer_row_length = mip_size.width;
+                copy.buffer_image_height = mip_size.height;
+                continue;
+            }
+        }
 
         if (astc && recompression_setting == Settings::AstcRecompression::Uncompressed) {
             Tegra::Texture::ASTC::Decompress(
                 input_offset, copy.image_extent.width, copy.image_extent.height,
                 copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
                 tile_size.height, output.subspan(output_offset));
-
-            output_offset += copy.image_extent.width * copy.image_extent.height *
-                             copy.image_subresource.num_layers *
-                             BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
         } else if (astc) {
-            // BC1 uses 0.5 bytes per texel
-            // BC3 uses 1 byte per texel
             const auto compress = recompression_setting == Settings::AstcRecompression::Bc1
                                       ? Tegra::Texture::BCN::CompressBC1
                                       : Tegra::Texture::BCN::CompressBC3;
-            const auto bpp_div = recompression_setting == Settings::AstcRecompression::Bc1 ? 2 : 1;
 
             const u32 plane_dim = copy.image_extent.width * copy.image_extent.height;
             const u32 level_size = plane_dim * copy.image_extent.depth *
@@ -962,20 +1004,13 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
             compress(decode_scratch, copy.image_extent.width, copy.image_extent.height,
                      copy.image_subresource.num_layers * copy.image_extent.depth,
                      output.subspan(output_offset));
-
-            const u32 aligned_plane_dim = Common::AlignUp(copy.image_extent.width, 4) *
-                                          Common::AlignUp(copy.image_extent.height, 4);
-
-            copy.buffer_size =
-                (aligned_plane_dim * copy.image_extent.depth * copy.image_subresource.num_layers) /
-                bpp_div;
-            output_offset += static_cast<u32>(copy.buffer_size);
         } else {
             DecompressBCn(input_offset, output.subspan(output_offset), copy, info.format);
-            output_offset += copy.image_extent.width * copy.image_extent.height *
-                             copy.image_subresource.num_layers *
-                             ConvertedBytesPerBlock(info.format);
         }
+        if (transcode_key != 0) {
+            transcode_cache->Store(transcode_key, converted);
+        }
+        output_offset += converted_size;
 
         copy.buffer_row_length = mip_size.width;
         copy.buffer_image_height = mip_size.height;
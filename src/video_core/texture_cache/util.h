@@ -19,6 +19,8 @@ namespace VideoCommon {
 
 using Tegra::Texture::TICEntry;
 
+class TranscodeCache;
+
 using LevelArray = std::array<u32, MAX_MIP_LEVELS>;
 
 struct OverlapResult {
@@ -67,7 +69,7 @@ struct OverlapResult {
     std::span<const u8> input, std::span<u8> output);
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+                  std::span<BufferImageCopy> copies, TranscodeCache* transcode_cache = nullptr);
 
 [[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(
     const ImageInfo& info);
@@ -8,14 +8,21 @@
 #include <bit>
 #include <cassert>
 #include <cstring>
+#include <list>
+#include <mutex>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/container/static_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/cityhash.h"
 #include "common/common_types.h"
+#include "common/literals.h"
 #include "common/polyfill_ranges.h"
+#include "common/settings.h"
 #include "video_core/textures/astc.h"
 #include "video_core/textures/workers.h"
 
@@ -1651,42 +1658,139 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
         }
 }
 
+namespace {
+
+using namespace Common::Literals;
+
+/// Minimum number of blocks decoded by a single worker job, avoids flooding the queue
+constexpr u32 MIN_BLOCKS_PER_JOB = 256;
+
+/// Upper bound of decoded texel data kept alive by the decoded layer cache
+constexpr size_t DECODED_LAYER_CACHE_CAPACITY = 256_MiB;
+
+/// Least recently used cache of decoded layers indexed by a hash of their compressed contents
+class DecodedLayerCache {
+public:
+    bool Lookup(u64 key, std::span<u8> output) {
+        std::scoped_lock lock{mutex};
+        const auto it = lookup.find(key);
+        if (it == lookup.end() || it->second->data.size() != output.size()) {
+            return false;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        std::memcpy(output.data(), it->second->data.data(), output.size());
+        return true;
+    }
+
+    void Insert(u64 key, std::span<const u8> decoded) {
+        if (decoded.size() > DECODED_LAYER_CACHE_CAPACITY) {
+            return;
+        }
+        std::scoped_lock lock{mutex};
+        if (lookup.contains(key)) {
+            return;
+        }
+        while (total_size + decoded.size() > DECODED_LAYER_CACHE_CAPACITY) {
+            total_size -= entries.back().data.size();
+            lookup.erase(entries.back().key);
+            entries.pop_back();
+        }
+        entries.push_front(Entry{key, std::vector<u8>(decoded.begin(), decoded.end())});
+        lookup.emplace(key, entries.begin());
+        total_size += decoded.size();
+    }
+
+private:
+    struct Entry {
+        u64 key;
+        std::vector<u8> data;
+    };
+
+    std::mutex mutex;
+    std::list<Entry> entries;
+    std::unordered_map<u64, std::list<Entry>::iterator> lookup;
+    size_t total_size = 0;
+};
+
+DecodedLayerCache& GetDecodedLayerCache() {
+    static DecodedLayerCache cache;
+    return cache;
+}
+
+u64 LayerHash(std::span<const u8> layer, u32 width, u32 height, u32 block_width,
+              u32 block_height) {
+    const u64 seed = (static_cast<u64>(width) << 40) | (static_cast<u64>(height) << 16) |
+                     (block_width << 8) | block_height;
+    return Common::CityHash64WithSeed(reinterpret_cast<const char*>(layer.data()), layer.size(),
+                                      seed);
+}
+
+void DecompressBlockRow(std::span<const u8> data, u32 width, u32 height, u32 block_width,
+                        u32 block_height, u32 cols, u32 y_index, std::span<u8> output) {
+    const u32 y = y_index * block_height;
+    for (u32 x_index = 0; x_index < cols; ++x_index) {
+        const u32 block_index = y_index * cols + x_index;
+        const u32 x = x_index * block_width;
+
+        const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+        // Blocks can be at most 12x12
+        std::array<u32, 12 * 12> uncompData;
+        DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+        u32 decompWidth = std::min(block_width, width - x);
+        u32 decompHeight = std::min(block_height, height - y);
+
+        const std::span<u8> outRow = output.subspan((y * width + x) * 4);
+        for (u32 h = 0; h < decompHeight; ++h) {
+            std::memcpy(outRow.data() + h * width * 4, uncompData.data() + h * block_width,
+                        decompWidth * 4);
+        }
+    }
+}
+
+} // Anonymous namespace
+
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
     const u32 rows = Common::DivideUp(height, block_height);
     const u32 cols = Common::DivideUp(width, block_width);
+    const size_t compressed_layer_size = static_cast<size_t>(rows) * cols * 16;
+    const size_t layer_size = static_cast<size_t>(width) * height * 4;
 
     Common::ThreadWorker& workers{GetThreadWorkers()};
+    DecodedLayerCache& cache{GetDecodedLayerCache()};
+    const bool use_cache = Settings::values.use_astc_decode_cache.GetValue();
 
+    // Queue every layer before waiting, so small layers of array textures don't serialize
+    const u32 rows_per_job = std::max(1U, MIN_BLOCKS_PER_JOB / cols);
+    boost::container::small_vector<std::pair<u32, u64>, 8> layers_to_cache;
     for (u32 z = 0; z < depth; ++z) {
-        const u32 depth_offset = z * height * width * 4;
-        for (u32 y_index = 0; y_index < rows; ++y_index) {
-            auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
-                                      cols, z, depth_offset, y_index] {
-                const u32 y = y_index * block_height;
-                for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
-                    const u32 x = x_index * block_width;
-
-                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
-                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                    u32 decompWidth = std::min(block_width, width - x);
-                    u32 decompHeight = std::min(block_height, height - y);
-
-                    const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                    for (u32 h = 0; h < decompHeight; ++h) {
-                        std::memcpy(outRow.data() + h * width * 4,
-                                    uncompData.data() + h * block_width, decompWidth * 4);
-                    }
+        const std::span<const u8> layer_data = data.subspan(z * compressed_layer_size);
+        const std::span<u8> layer_output = output.subspan(z * layer_size, layer_size);
+        if (use_cache) {
+            const u64 key = LayerHash(layer_data.first(compressed_layer_size), width, height,
+                                      block_width, block_height);
+            if (cache.Lookup(key, layer_output)) {
+                continue;
+            }
+            layers_to_cache.emplace_back(z, key);
+        }
+        for (u32 first_row = 0; first_row < rows; first_row += rows_per_job) {
+            const u32 last_row = std::min(rows, first_row + rows_per_job);
+            workers.QueueWork([layer_data, width, height, block_width, block_height, cols,
+                               first_row, last_row, layer_output] {
+                for (u32 y_index = first_row; y_index < last_row; ++y_index) {
+                    DecompressBlockRow(layer_data, width, height, block_width, block_height, cols,
+                                       y_index, layer_output);
                 }
-            };
-            workers.QueueWork(std::move(decompress_stride));
+            });
         }
-        workers.WaitForRequests();
+    }
+    workers.WaitForRequests();
+
+    for (const auto& [z, key] : layers_to_cache) {
+        cache.Insert(key, output.subspan(z * layer_size, layer_size));
     }
 }
 
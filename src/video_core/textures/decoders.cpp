@@ -2,9 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <span>
+#include <utility>
 
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -12,6 +14,7 @@
 #include "common/div_ceil.h"
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
+#include "video_core/textures/swizzle_kernels.h"
 
 namespace Tegra::Texture {
 namespace {
@@ -33,73 +36,50 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
-template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
-void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
-                 u32 block_height, u32 block_depth, u32 stride) {
-    // The origin of the transformation can be configured here, leave it as zero as the current API
-    // doesn't expose it.
-    static constexpr u32 origin_x = 0;
-    static constexpr u32 origin_y = 0;
-    static constexpr u32 origin_z = 0;
-
-    // We can configure here a custom pitch
-    // As it's not exposed 'width * BYTES_PER_PIXEL' will be the expected pitch.
-    const u32 pitch = width * BYTES_PER_PIXEL;
-
-    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
-    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
-    const u32 slice_size =
-        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
-
-    const u32 block_height_mask = (1U << block_height) - 1;
-    const u32 block_depth_mask = (1U << block_depth) - 1;
-    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
-
-    for (u32 slice = 0; slice < depth; ++slice) {
-        const u32 z = slice + origin_z;
-        const u32 offset_z = (z >> block_depth) * slice_size +
-                             ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
-        for (u32 line = 0; line < height; ++line) {
-            const u32 y = line + origin_y;
-            const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
-
-            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
-            const u32 offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < width;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+/// Returns the range of columns [begin, end) relative to 'origin_x' that covers whole GOBs.
+template <u32 BYTES_PER_PIXEL>
+std::pair<u32, u32> WholeGobColumns(u32 origin_x, u32 extent_x) {
+    if constexpr (!std::has_single_bit(BYTES_PER_PIXEL)) {
+        // Pixels straddle GOB boundaries, leave everything to the per pixel path
+        return {0, 0};
+    }
+    const u32 begin_x = Common::AlignUpLog2(origin_x * BYTES_PER_PIXEL, GOB_SIZE_X_SHIFT);
+    const u32 end_x = Common::AlignDown((origin_x + extent_x) * BYTES_PER_PIXEL, GOB_SIZE_X);
+    if (begin_x >= end_x) {
+        return {0, 0};
+    }
+    return {begin_x / BYTES_PER_PIXEL - origin_x, end_x / BYTES_PER_PIXEL - origin_x};
+}
 
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
-            }
-        }
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleColumns(std::span<u8> output, std::span<const u8> input, u32 base_swizzled_offset,
+                    u32 swizzled_y, u32 x_shift, u32 unswizzled_line_offset, u32 origin_x,
+                    u32 column_begin, u32 column_end) {
+    u32 swizzled_x = pdep<SWIZZLE_X_BITS>((origin_x + column_begin) * BYTES_PER_PIXEL);
+    for (u32 column = column_begin; column < column_end;
+         ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
+        const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
+        const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+
+        const u32 swizzled_offset = base_swizzled_offset + offset_x + (swizzled_x | swizzled_y);
+        const u32 unswizzled_offset = unswizzled_line_offset + column * BYTES_PER_PIXEL;
+
+        u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
+        const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+
+        std::memcpy(dst, src, BYTES_PER_PIXEL);
     }
 }
 
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
-void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height,
-                        u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines,
-                        u32 block_height, u32 block_depth, u32 pitch_linear) {
+void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 height, u32 depth,
+                        u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines,
+                        u32 block_height, u32 block_depth, u32 pitch_linear, u32 stride) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_z = 0;
 
-    // We can configure here a custom pitch
-    // As it's not exposed 'width * BYTES_PER_PIXEL' will be the expected pitch.
     const u32 pitch = pitch_linear;
-    const u32 stride = Common::AlignUpLog2(width * BYTES_PER_PIXEL, GOB_SIZE_X_SHIFT);
 
     const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
     const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
@@ -110,6 +90,13 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
+    // Runs of whole GOBs are handed to the vectorized kernels, edges go through the per pixel path
+    const auto [gob_column_begin, gob_column_end] =
+        WholeGobColumns<BYTES_PER_PIXEL>(origin_x, extent_x);
+    const u32 num_gobs = (gob_column_end - gob_column_begin) * BYTES_PER_PIXEL / GOB_SIZE_X;
+    const GobCopyFn copy_gobs =
+        TO_LINEAR ? GetSwizzleKernels().swizzle_gobs : GetSwizzleKernels().unswizzle_gobs;
+
     u32 unprocessed_lines = num_lines;
     u32 extent_y = std::min(num_lines, height - origin_y);
 
@@ -126,23 +113,34 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < extent_x;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
-
+            const u32 base_swizzled_offset = offset_z + offset_y;
+            const u32 unswizzled_line_offset = slice * pitch * height + line * pitch;
+
+            const u32 gob_row_begin = y & ~(GOB_SIZE_Y - 1);
+            const bool whole_gob_row = num_gobs != 0 && gob_row_begin >= origin_y &&
+                                       gob_row_begin + GOB_SIZE_Y <= origin_y + lines_in_y;
+            if (!whole_gob_row) {
+                SwizzleColumns<TO_LINEAR, BYTES_PER_PIXEL>(
+                    output, input, base_swizzled_offset, swizzled_y, x_shift,
+                    unswizzled_line_offset, origin_x, 0, extent_x);
+                continue;
+            }
+            if (y == gob_row_begin) {
+                const u32 x = (origin_x + gob_column_begin) * BYTES_PER_PIXEL;
+                const u32 swizzled_offset =
+                    base_swizzled_offset + ((x >> GOB_SIZE_X_SHIFT) << x_shift);
                 const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
-
+                    unswizzled_line_offset + gob_column_begin * BYTES_PER_PIXEL;
                 u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
                 const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
+                copy_gobs(dst, src, pitch, num_gobs, 1U << x_shift);
             }
+            SwizzleColumns<TO_LINEAR, BYTES_PER_PIXEL>(output, input, base_swizzled_offset,
+                                                       swizzled_y, x_shift, unswizzled_line_offset,
+                                                       origin_x, 0, gob_column_begin);
+            SwizzleColumns<TO_LINEAR, BYTES_PER_PIXEL>(output, input, base_swizzled_offset,
+                                                       swizzled_y, x_shift, unswizzled_line_offset,
+                                                       origin_x, gob_column_end, extent_x);
         }
         unprocessed_lines -= lines_in_y;
         if (unprocessed_lines == 0) {
@@ -151,6 +149,17 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     }
 }
 
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
+                 u32 block_height, u32 block_depth, u32 stride) {
+    // We can configure here a custom pitch
+    // As it's not exposed 'width * BYTES_PER_PIXEL' will be the expected pitch.
+    const u32 pitch = width * BYTES_PER_PIXEL;
+    SwizzleSubrectImpl<TO_LINEAR, BYTES_PER_PIXEL>(output, input, height, depth, 0, 0, width,
+                                                   height * depth, block_height, block_depth, pitch,
+                                                   stride);
+}
+
 template <bool TO_LINEAR>
 void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
              u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
@@ -201,12 +210,13 @@ void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_p
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
                     u32 block_height, u32 block_depth, u32 pitch_linear) {
+    const u32 stride = Common::AlignUpLog2(width * bytes_per_pixel, GOB_SIZE_X_SHIFT);
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
-        return SwizzleSubrectImpl<true, x>(output, input, width, height, depth, origin_x,          \
-                                           origin_y, extent_x, extent_y, block_height,             \
-                                           block_depth, pitch_linear);
+        return SwizzleSubrectImpl<true, x>(output, input, height, depth, origin_x, origin_y,       \
+                                           extent_x, extent_y, block_height, block_depth,          \
+                                           pitch_linear, stride);
         BPP_CASE(1)
         BPP_CASE(2)
         BPP_CASE(3)
@@ -225,12 +235,13 @@ void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_p
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
                       u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear) {
+    const u32 stride = Common::AlignUpLog2(width * bytes_per_pixel, GOB_SIZE_X_SHIFT);
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
-        return SwizzleSubrectImpl<false, x>(output, input, width, height, depth, origin_x,         \
-                                            origin_y, extent_x, extent_y, block_height,            \
-                                            block_depth, pitch_linear);
+        return SwizzleSubrectImpl<false, x>(output, input, height, depth, origin_x, origin_y,      \
+                                            extent_x, extent_y, block_height, block_depth,         \
+                                            pitch_linear, stride);
         BPP_CASE(1)
         BPP_CASE(2)
         BPP_CASE(3)
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#if defined(ARCHITECTURE_x86_64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#include "common/logging/log.h"
+#include "video_core/textures/decoders.h"
+#include "video_core/textures/swizzle_kernels.h"
+#include "video_core/textures/swizzle_kernels_impl.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "common/x64/cpu_detect.h"
+#endif
+
+namespace Tegra::Texture {
+namespace {
+
+struct GenericSector {
+    static void Copy(u8* dst, const u8* src) {
+        std::memcpy(dst, src, SECTOR_SIZE);
+    }
+};
+
+#if defined(ARCHITECTURE_x86_64)
+struct SSE2Sector {
+    static void Copy(u8* dst, const u8* src) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+};
+#elif defined(ARCHITECTURE_arm64)
+struct NEONSector {
+    static void Copy(u8* dst, const u8* src) {
+        vst1q_u8(dst, vld1q_u8(src));
+    }
+};
+#endif
+
+constexpr SwizzleKernels GENERIC_KERNELS{
+    .swizzle_gobs = &CopyGobsBySector<GenericSector, true>,
+    .unswizzle_gobs = &CopyGobsBySector<GenericSector, false>,
+    .name = "Generic",
+};
+
+#if defined(ARCHITECTURE_x86_64)
+constexpr SwizzleKernels SSE2_KERNELS{
+    .swizzle_gobs = &CopyGobsBySector<SSE2Sector, true>,
+    .unswizzle_gobs = &CopyGobsBySector<SSE2Sector, false>,
+    .name = "SSE2",
+};
+#elif defined(ARCHITECTURE_arm64)
+constexpr SwizzleKernels NEON_KERNELS{
+    .swizzle_gobs = &CopyGobsBySector<NEONSector, true>,
+    .unswizzle_gobs = &CopyGobsBySector<NEONSector, false>,
+    .name = "NEON",
+};
+#endif
+
+const SwizzleKernels& DetectSwizzleKernels() {
+#if defined(ARCHITECTURE_x86_64)
+    if (Common::GetCPUCaps().avx2) {
+        return GetAVX2SwizzleKernels();
+    }
+    return SSE2_KERNELS;
+#elif defined(ARCHITECTURE_arm64)
+    // Advanced SIMD is mandatory on AArch64, no runtime detection is needed.
+    return NEON_KERNELS;
+#else
+    return GENERIC_KERNELS;
+#endif
+}
+
+} // Anonymous namespace
+
+const SwizzleKernels& GetGenericSwizzleKernels() {
+    return GENERIC_KERNELS;
+}
+
+const SwizzleKernels& GetSwizzleKernels() {
+    static const SwizzleKernels& kernels = []() -> const SwizzleKernels& {
+        const SwizzleKernels& detected = DetectSwizzleKernels();
+        LOG_INFO(HW_GPU, "Using {} block linear swizzle kernels", detected.name);
+        return detected;
+    }();
+    return kernels;
+}
+
+} // namespace Tegra::Texture
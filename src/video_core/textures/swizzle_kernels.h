@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace Tegra::Texture {
+
+/**
+ * Copies a horizontal run of whole GOBs between block linear and linear memory.
+ * Block linear pointers point to the first GOB of the run, linear pointers point to the first byte
+ * of the top line of the run.
+ * @param dst        Destination of the copy
+ * @param src        Source of the copy
+ * @param pitch      Distance in bytes between two lines in linear memory
+ * @param num_gobs   Number of GOBs in the run
+ * @param gob_stride Distance in bytes between two horizontally adjacent GOBs in swizzled memory
+ */
+using GobCopyFn = void (*)(u8* dst, const u8* src, u32 pitch, u32 num_gobs, u32 gob_stride);
+
+struct SwizzleKernels {
+    GobCopyFn swizzle_gobs;   ///< Linear to block linear
+    GobCopyFn unswizzle_gobs; ///< Block linear to linear
+    const char* name;
+};
+
+/// Returns the portable kernels, used as a fallback and as a reference
+const SwizzleKernels& GetGenericSwizzleKernels();
+
+/// Returns the fastest kernels supported by the host CPU, detected on first use
+const SwizzleKernels& GetSwizzleKernels();
+
+} // namespace Tegra::Texture
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+#include "video_core/textures/swizzle_kernels_impl.h"
+
+namespace Tegra::Texture {
+namespace {
+
+/*
+ * Two consecutive lines of a GOB interleave their sectors, so the first 64 bytes of a GOB hold
+ * sectors 0 and 1 of lines 0 and 1 as [L0S0 L1S0 L0S1 L1S1]. Loading that as two 32 byte vectors
+ * and exchanging their 128-bit lanes yields the first 32 linear bytes of each line. The same
+ * pattern repeats for sectors 2 and 3 at byte 256.
+ */
+template <bool TO_SWIZZLED>
+void CopyGobsAVX2(u8* dst, const u8* src, u32 pitch, u32 num_gobs, u32 gob_stride) {
+    const u32 dst_gob_stride = TO_SWIZZLED ? gob_stride : GOB_SIZE_X;
+    const u32 src_gob_stride = TO_SWIZZLED ? GOB_SIZE_X : gob_stride;
+    for (u32 gob = 0; gob < num_gobs; ++gob, dst += dst_gob_stride, src += src_gob_stride) {
+        for (u32 y = 0; y < GOB_SIZE_Y; y += 2) {
+            for (u32 half = 0; half < 2; ++half) {
+                const u32 swizzled_offset = GobSectorOffset(half * 2, y);
+                const u32 linear_offset = y * pitch + half * 32;
+                if constexpr (TO_SWIZZLED) {
+                    const u8* const line = src + linear_offset;
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line));
+                    const __m256i b =
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line + pitch));
+                    u8* const gob = dst + swizzled_offset;
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(gob),
+                                        _mm256_permute2x128_si256(a, b, 0x20));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(gob + 32),
+                                        _mm256_permute2x128_si256(a, b, 0x31));
+                } else {
+                    const u8* const gob = src + swizzled_offset;
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(gob));
+                    const __m256i b =
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(gob + 32));
+                    u8* const line = dst + linear_offset;
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(line),
+                                        _mm256_permute2x128_si256(a, b, 0x20));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(line + pitch),
+                                        _mm256_permute2x128_si256(a, b, 0x31));
+                }
+            }
+        }
+    }
+}
+
+constexpr SwizzleKernels AVX2_KERNELS{
+    .swizzle_gobs = &CopyGobsAVX2<true>,
+    .unswizzle_gobs = &CopyGobsAVX2<false>,
+    .name = "AVX2",
+};
+
+} // Anonymous namespace
+
+const SwizzleKernels& GetAVX2SwizzleKernels() {
+    return AVX2_KERNELS;
+}
+
+} // namespace Tegra::Texture
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+#include "video_core/textures/decoders.h"
+#include "video_core/textures/swizzle_kernels.h"
+
+namespace Tegra::Texture {
+
+/// A GOB line is made of four 16 byte sectors, each contiguous in block linear memory.
+constexpr u32 SECTOR_SIZE = 16;
+constexpr u32 SECTORS_PER_GOB_LINE = GOB_SIZE_X / SECTOR_SIZE;
+
+/// Offset inside a GOB of the 'sector'-th sector of line 'y'
+constexpr u32 GobSectorOffset(u32 sector, u32 y) {
+    return (sector / 2) * 256 + (y / 2) * 64 + (sector % 2) * 32 + (y % 2) * 16;
+}
+
+/// Copies whole GOBs one 16 byte sector at a time, 'Sector::Copy' moves a single sector.
+template <typename Sector, bool TO_SWIZZLED>
+void CopyGobsBySector(u8* dst, const u8* src, u32 pitch, u32 num_gobs, u32 gob_stride) {
+    const u32 dst_gob_stride = TO_SWIZZLED ? gob_stride : GOB_SIZE_X;
+    const u32 src_gob_stride = TO_SWIZZLED ? GOB_SIZE_X : gob_stride;
+    for (u32 gob = 0; gob < num_gobs; ++gob, dst += dst_gob_stride, src += src_gob_stride) {
+        for (u32 y = 0; y < GOB_SIZE_Y; ++y) {
+            for (u32 sector = 0; sector < SECTORS_PER_GOB_LINE; ++sector) {
+                const u32 swizzled_offset = GobSectorOffset(sector, y);
+                const u32 linear_offset = y * pitch + sector * SECTOR_SIZE;
+                Sector::Copy(dst + (TO_SWIZZLED ? swizzled_offset : linear_offset),
+                             src + (TO_SWIZZLED ? linear_offset : swizzled_offset));
+            }
+        }
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64)
+/// Implemented in a translation unit built with AVX2 enabled, only call when the host supports it.
+const SwizzleKernels& GetAVX2SwizzleKernels();
+#endif
+
+} // namespace Tegra::Texture
@@ -47,6 +47,10 @@ void ConfigureDebug::SetConfiguration() {
     ui->dump_audio_commands->setChecked(Settings::values.dump_audio_commands.GetValue());
     ui->quest_flag->setChecked(Settings::values.quest_flag.GetValue());
     ui->use_debug_asserts->setChecked(Settings::values.use_debug_asserts.GetValue());
+    ui->guest_profiler->setEnabled(runtime_lock);
+    ui->guest_profiler->setChecked(Settings::values.guest_profiler.GetValue());
+    ui->service_profiler->setEnabled(runtime_lock);
+    ui->service_profiler->setChecked(Settings::values.service_profiler.GetValue());
     ui->use_auto_stub->setChecked(Settings::values.use_auto_stub.GetValue());
     ui->enable_all_controllers->setChecked(Settings::values.enable_all_controllers.GetValue());
     ui->enable_renderdoc_hotkey->setEnabled(runtime_lock);
@@ -65,6 +69,10 @@ void ConfigureDebug::SetConfiguration() {
     ui->dump_shaders->setChecked(Settings::values.dump_shaders.GetValue());
     ui->dump_macros->setEnabled(runtime_lock);
     ui->dump_macros->setChecked(Settings::values.dump_macros.GetValue());
+    ui->dump_gpu_commands->setEnabled(runtime_lock);
+    ui->dump_gpu_commands->setChecked(Settings::values.dump_gpu_commands.GetValue());
+    ui->profile_macros->setEnabled(runtime_lock);
+    ui->profile_macros->setChecked(Settings::values.profile_macros.GetValue());
     ui->disable_macro_jit->setEnabled(runtime_lock);
     ui->disable_macro_jit->setChecked(Settings::values.disable_macro_jit.GetValue());
     ui->disable_macro_hle->setEnabled(runtime_lock);
@@ -94,6 +102,8 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.dump_audio_commands = ui->dump_audio_commands->isChecked();
     Settings::values.quest_flag = ui->quest_flag->isChecked();
     Settings::values.use_debug_asserts = ui->use_debug_asserts->isChecked();
+    Settings::values.guest_profiler = ui->guest_profiler->isChecked();
+    Settings::values.service_profiler = ui->service_profiler->isChecked();
     Settings::values.use_auto_stub = ui->use_auto_stub->isChecked();
     Settings::values.enable_all_controllers = ui->enable_all_controllers->isChecked();
     Settings::values.renderer_debug = ui->enable_graphics_debugging->isChecked();
@@ -104,6 +114,8 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.enable_nsight_aftermath = ui->enable_nsight_aftermath->isChecked();
     Settings::values.dump_shaders = ui->dump_shaders->isChecked();
     Settings::values.dump_macros = ui->dump_macros->isChecked();
+    Settings::values.dump_gpu_commands = ui->dump_gpu_commands->isChecked();
+    Settings::values.profile_macros = ui->profile_macros->isChecked();
     Settings::values.disable_shader_loop_safety_checks =
         ui->disable_loop_safety_checks->isChecked();
     Settings::values.disable_macro_jit = ui->disable_macro_jit->isChecked();
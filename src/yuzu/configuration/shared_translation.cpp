@@ -164,6 +164,13 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            "the emulator to decompress to an intermediate format any card supports, RGBA8.\n"
            "This option recompresses RGBA8 to either the BC1 or BC3 format, saving VRAM but "
            "negatively affecting image quality."));
+    INSERT(Settings, use_astc_decode_cache, tr("Cache CPU decoded ASTC textures"),
+           tr("Keeps recently decoded ASTC textures in memory so identical texture uploads skip "
+              "decoding.\n"
+              "Only used when ASTC textures are decoded on the CPU."));
+    INSERT(Settings, use_disk_texture_cache, tr("Use disk texture cache"),
+           tr("Stores the textures transcoded on the CPU to disk, per game, so later sessions "
+              "load them instead of transcoding them again."));
     INSERT(Settings, vram_usage_mode, tr("VRAM Usage Mode:"),
            tr("Selects whether the emulator should prefer to conserve memory or make maximum usage "
               "of available video memory for performance. Has no effect on integrated graphics. "
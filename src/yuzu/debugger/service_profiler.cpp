@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <QHeaderView>
+#include <QTreeWidget>
+
+#include "core/core.h"
+#include "core/hle/service/service_profiler.h"
+#include "yuzu/debugger/service_profiler.h"
+
+namespace {
+
+enum Column : int {
+    ServiceColumn,
+    CommandColumn,
+    CallsColumn,
+    HandlerTotalColumn,
+    HandlerMeanColumn,
+    HandlerP99Column,
+    HandlerMaxColumn,
+    OverheadMeanColumn,
+    OverheadP99Column,
+    ColumnCount,
+};
+
+/// Sorts the numeric columns by value rather than by text.
+class ServiceProfilerItem : public QTreeWidgetItem {
+public:
+    using QTreeWidgetItem::QTreeWidgetItem;
+
+    bool operator<(const QTreeWidgetItem& other) const override {
+        const int column = treeWidget() != nullptr ? treeWidget()->sortColumn() : 0;
+        if (column < CallsColumn) {
+            return QTreeWidgetItem::operator<(other);
+        }
+        return data(column, Qt::UserRole).toULongLong() <
+               other.data(column, Qt::UserRole).toULongLong();
+    }
+};
+
+void SetNumber(QTreeWidgetItem* item, int column, u64 value, const QString& text) {
+    item->setData(column, Qt::UserRole, QVariant::fromValue<qulonglong>(value));
+    item->setText(column, text);
+    item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+}
+
+QString FormatMicroseconds(u64 ns) {
+    return QString::number(static_cast<double>(ns) / 1000.0, 'f', 1);
+}
+
+} // Anonymous namespace
+
+ServiceProfilerWidget::ServiceProfilerWidget(Core::System& system_, QWidget* parent)
+    : QDockWidget(tr("&Service Profiler"), parent), system{system_} {
+    setObjectName(QStringLiteral("ServiceProfilerWidget"));
+
+    view = new QTreeWidget(this);
+    view->setColumnCount(ColumnCount);
+    view->setHeaderLabels({
+        tr("Service"),
+        tr("Command"),
+        tr("Calls"),
+        tr("Handler total (ms)"),
+        tr("Handler mean (µs)"),
+        tr("Handler p99 (µs)"),
+        tr("Handler max (µs)"),
+        tr("Overhead mean (µs)"),
+        tr("Overhead p99 (µs)"),
+    });
+    view->setRootIsDecorated(false);
+    view->setUniformRowHeights(true);
+    view->setSortingEnabled(true);
+    view->sortByColumn(HandlerTotalColumn, Qt::DescendingOrder);
+    view->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    setWidget(view);
+    setEnabled(false);
+
+    refresh_timer.setInterval(1000);
+    connect(&refresh_timer, &QTimer::timeout, this, &ServiceProfilerWidget::Refresh);
+}
+
+ServiceProfilerWidget::~ServiceProfilerWidget() = default;
+
+void ServiceProfilerWidget::OnEmulationStarting(EmuThread* emu_thread) {
+    view->clear();
+
+    // The profiler is created with the services, it is only enabled with its setting.
+    const bool is_enabled = system.GetServiceProfiler() != nullptr;
+    setEnabled(is_enabled);
+    if (is_enabled) {
+        refresh_timer.start();
+    }
+}
+
+void ServiceProfilerWidget::OnEmulationStopping() {
+    // The last refresh stays shown, the profiler is destroyed with the services.
+    refresh_timer.stop();
+}
+
+void ServiceProfilerWidget::Refresh() {
+    const auto* profiler = system.GetServiceProfiler();
+    if (profiler == nullptr || !isVisible()) {
+        return;
+    }
+
+    view->setSortingEnabled(false);
+    view->clear();
+    for (const auto& entry : profiler->Snapshot()) {
+        auto* const item = new ServiceProfilerItem(view);
+        item->setText(ServiceColumn, QString::fromStdString(entry.service_name));
+
+        const QString command_name = entry.command_name.empty()
+                                         ? tr("Unknown")
+                                         : QString::fromStdString(entry.command_name);
+        item->setText(CommandColumn, entry.is_tipc
+                                         ? QStringLiteral("%1 (TIPC %2)")
+                                               .arg(command_name)
+                                               .arg(entry.command_id)
+                                         : QStringLiteral("%1 (%2)")
+                                               .arg(command_name)
+                                               .arg(entry.command_id));
+
+        const auto& handler = entry.handler_time;
+        const auto& overhead = entry.session_overhead;
+        const u64 handler_mean = handler.count != 0 ? handler.total_ns / handler.count : 0;
+        const u64 overhead_mean = overhead.count != 0 ? overhead.total_ns / overhead.count : 0;
+        SetNumber(item, CallsColumn, handler.count, QString::number(handler.count));
+        SetNumber(item, HandlerTotalColumn, handler.total_ns,
+                  QString::number(static_cast<double>(handler.total_ns) / 1e6, 'f', 2));
+        SetNumber(item, HandlerMeanColumn, handler_mean, FormatMicroseconds(handler_mean));
+        SetNumber(item, HandlerP99Column, handler.Percentile(0.99),
+                  FormatMicroseconds(handler.Percentile(0.99)));
+        SetNumber(item, HandlerMaxColumn, handler.max_ns, FormatMicroseconds(handler.max_ns));
+        SetNumber(item, OverheadMeanColumn, overhead_mean, FormatMicroseconds(overhead_mean));
+        SetNumber(item, OverheadP99Column, overhead.Percentile(0.99),
+                  FormatMicroseconds(overhead.Percentile(0.99)));
+    }
+    view->setSortingEnabled(true);
+}
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <QDockWidget>
+#include <QTimer>
+
+class EmuThread;
+class QTreeWidget;
+
+namespace Core {
+class System;
+}
+
+/**
+ * Shows the calls and latencies of the commands of the HLE services recorded by the service
+ * profiler, refreshed every second while emulation runs.
+ */
+class ServiceProfilerWidget : public QDockWidget {
+    Q_OBJECT
+
+public:
+    explicit ServiceProfilerWidget(Core::System& system_, QWidget* parent = nullptr);
+    ~ServiceProfilerWidget() override;
+
+public slots:
+    void OnEmulationStarting(EmuThread* emu_thread);
+    void OnEmulationStopping();
+
+private:
+    void Refresh();
+
+    QTreeWidget* view;
+    QTimer refresh_timer;
+
+    Core::System& system;
+};
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,16 +16,16 @@
 
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
-#include "core/file_sys/card_image.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
 #include "core/file_sys/fs_filesystem.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
-#include "core/file_sys/submission_package.h"
 #include "core/loader/loader.h"
+#include "frontend_common/game_list_index.h"
 #include "yuzu/compatibility_list.h"
 #include "yuzu/game_list.h"
 #include "yuzu/game_list_p.h"
@@ -193,10 +196,11 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
                                         const std::size_t size, const std::vector<u8>& icon,
-                                        Loader::AppLoader& loader, u64 program_id,
+                                        Loader::FileType file_type, u64 program_id,
                                         const CompatibilityList& compatibility_list,
                                         const PlayTime::PlayTimeManager& play_time_manager,
-                                        const FileSys::PatchManager& patch) {
+                                        const FileSys::PatchManager& patch,
+                                        const std::function<QString()>& patch_versions_generator) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -205,7 +209,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -217,14 +220,35 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         new GameListItemPlayTime(play_time_manager.GetPlayTime(program_id)),
     };
 
-    const auto patch_versions = GetGameListCachedObject(
-        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
-        });
+    const auto patch_versions = GetGameListCachedObject(fmt::format("{:016X}", patch.GetTitleID()),
+                                                        "pv.txt", patch_versions_generator);
     list.insert(2, new GameListItem(patch_versions));
 
     return list;
 }
+
+bool IsVirtualGameDir(const UISettings::GameDir& game_dir) {
+    return game_dir.path == std::string("SDMC") || game_dir.path == std::string("UserNAND") ||
+           game_dir.path == std::string("SysNAND");
+}
+
+/// Calls func on every path from a pool of threads, returning the results in the same order.
+template <typename Func>
+auto ParallelMap(const std::vector<std::string>& paths, const std::atomic_bool& stop_requested,
+                 Func&& func) {
+    std::vector<std::invoke_result_t<Func&, const std::string&>> results(paths.size());
+    Common::ThreadWorker workers(std::max(std::thread::hardware_concurrency(), 2U),
+                                 "GameListScan");
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        workers.QueueWork([&, i] {
+            if (!stop_requested) {
+                results[i] = func(paths[i]);
+            }
+        });
+    }
+    workers.WaitForRequests();
+    return results;
+}
 } // Anonymous namespace
 
 GameListWorker::GameListWorker(FileSys::VirtualFilesystem vfs_,
@@ -328,111 +352,30 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        auto entry = MakeGameListEntry(file->GetFullPath(), name, file->GetSize(), icon, *loader,
-                                       program_id, compatibility_list, play_time_manager, patch);
+        auto entry = MakeGameListEntry(
+            file->GetFullPath(), name, file->GetSize(), icon, loader->GetFileType(), program_id,
+            compatibility_list, play_time_manager, patch, [&patch, &loader] {
+                return FormatPatchNameVersions(patch, *loader, loader->IsRomFSUpdatable());
+            });
         RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
     }
 }
 
-void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
-                                    GameListDir* parent_dir) {
-    const auto callback = [this, target, parent_dir](const std::filesystem::path& path) -> bool {
+std::vector<std::string> GameListWorker::FindGameFiles(const std::string& dir_path,
+                                                      bool deep_scan) {
+    std::vector<std::string> files;
+    const auto callback = [this, &files](const std::filesystem::path& path) -> bool {
         if (stop_requested) {
             // Breaks the callback loop.
             return false;
         }
 
-        const auto physical_name = Common::FS::PathToUTF8String(path);
-        const auto is_dir = Common::FS::IsDir(path);
-
-        if (!is_dir &&
-            (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
-            const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
-            if (!file) {
-                return true;
-            }
-
-            auto loader = Loader::GetLoader(system, file);
-            if (!loader) {
-                return true;
-            }
-
-            const auto file_type = loader->GetFileType();
-            if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
-                return true;
-            }
-
-            u64 program_id = 0;
-            const auto res2 = loader->ReadProgramId(program_id);
-
-            if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
-                    }
-                }
-            } else {
-                std::vector<u64> program_ids;
-                loader->ReadProgramIds(program_ids);
-
-                if (res2 == Loader::ResultStatus::Success && program_ids.size() > 1 &&
-                    (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP)) {
-                    for (const auto id : program_ids) {
-                        loader = Loader::GetLoader(system, file, id);
-                        if (!loader) {
-                            continue;
-                        }
-
-                        std::vector<u8> icon;
-                        [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                        std::string name = " ";
-                        [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                        const FileSys::PatchManager patch{id, system.GetFileSystemController(),
-                                                          system.GetContentProvider()};
-
-                        auto entry = MakeGameListEntry(
-                            physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                            id, compatibility_list, play_time_manager, patch);
-
-                        RecordEvent(
-                            [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
-                    }
-                } else {
-                    std::vector<u8> icon;
-                    [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                    std::string name = " ";
-                    [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                    const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
-                                                      system.GetContentProvider()};
-
-                    auto entry = MakeGameListEntry(
-                        physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                        program_id, compatibility_list, play_time_manager, patch);
-
-                    RecordEvent(
-                        [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
-                }
-            }
-        } else if (is_dir) {
+        auto physical_name = Common::FS::PathToUTF8String(path);
+        if (Common::FS::IsDir(path)) {
             watch_list.append(QString::fromStdString(physical_name));
+        } else if (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name)) {
+            files.push_back(std::move(physical_name));
         }
-
         return true;
     };
 
@@ -442,21 +385,112 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
     } else {
         Common::FS::IterateDirEntries(dir_path, callback, Common::FS::DirEntryFilter::File);
     }
+    return files;
+}
+
+void GameListWorker::FillManualContentProvider(GameListIndex& index,
+                                               const std::vector<std::string>& files) {
+    const auto contents = ParallelMap(files, stop_requested, [&index](const std::string& path) {
+        return index.GetContents(path);
+    });
+
+    // The provider is not thread safe, fill it once every file was read.
+    for (const auto& file_contents : contents) {
+        if (!file_contents) {
+            continue;
+        }
+        for (const auto& content : file_contents->contents) {
+            provider->AddEntry(content.title_type, content.record_type, content.title_id,
+                               content.file);
+        }
+    }
+}
+
+void GameListWorker::PopulateGameList(GameListIndex& index, const std::vector<std::string>& files,
+                                      GameListDir* parent_dir) {
+    const auto programs = ParallelMap(files, stop_requested, [&index](const std::string& path) {
+        return index.GetPrograms(path);
+    });
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        if (stop_requested) {
+            return;
+        }
+        if (!programs[i]) {
+            continue;
+        }
+
+        const auto& physical_name = files[i];
+        const bool multi_program = programs[i]->programs.size() > 1;
+        for (const auto& program : programs[i]->programs) {
+            const FileSys::PatchManager patch{program.program_id,
+                                              system.GetFileSystemController(),
+                                              system.GetContentProvider()};
+
+            // Only reopen the game when the add-ons it shows are not cached.
+            const auto patch_versions_generator = [&] {
+                const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
+                if (!file) {
+                    return QString{};
+                }
+                const auto loader =
+                    Loader::GetLoader(system, file, multi_program ? program.program_id : 0);
+                if (!loader) {
+                    return QString{};
+                }
+                return FormatPatchNameVersions(patch, *loader, loader->IsRomFSUpdatable());
+            };
+
+            auto entry = MakeGameListEntry(physical_name, program.name, programs[i]->size,
+                                           program.icon, programs[i]->file_type,
+                                           program.program_id, compatibility_list,
+                                           play_time_manager, patch, patch_versions_generator);
+
+            RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
+        }
+    }
 }
 
 void GameListWorker::run() {
     watch_list.clear();
     provider->ClearAllEntries();
 
+    const auto index_path =
+        Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "game_list" / "index.bin";
+    GameListIndex index{system};
+    if (UISettings::values.cache_game_list) {
+        void(index.Load(index_path));
+    }
+
+    // Find the games of every directory first, the updates they contain must all be known before
+    // the name of any game is read.
+    std::vector<std::vector<std::string>> game_files;
+    std::vector<std::string> all_game_files;
+    for (const UISettings::GameDir& game_dir : game_dirs) {
+        auto& files = game_files.emplace_back();
+        if (stop_requested || IsVirtualGameDir(game_dir)) {
+            continue;
+        }
+
+        watch_list.append(QString::fromStdString(game_dir.path));
+        files = FindGameFiles(game_dir.path, game_dir.deep_scan);
+        all_game_files.insert(all_game_files.end(), files.begin(), files.end());
+    }
+    FillManualContentProvider(index, all_game_files);
+    index.SetContentFingerprint(
+        GameListIndex::ComputeContentFingerprint(system.GetContentProvider()));
+
     const auto DirEntryReady = [&](GameListDir* game_list_dir) {
         RecordEvent([=](GameList* game_list) { game_list->AddDirEntry(game_list_dir); });
     };
 
+    std::size_t dir_index = 0;
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (stop_requested) {
             break;
         }
 
+        const auto& files = game_files[dir_index++];
         if (game_dir.path == std::string("SDMC")) {
             auto* const game_list_dir = new GameListDir(game_dir, GameListItemType::SdmcDir);
             DirEntryReady(game_list_dir);
@@ -470,16 +504,17 @@ void GameListWorker::run() {
             DirEntryReady(game_list_dir);
             AddTitlesToGameList(game_list_dir);
         } else {
-            watch_list.append(QString::fromStdString(game_dir.path));
             auto* const game_list_dir = new GameListDir(game_dir);
             DirEntryReady(game_list_dir);
-            ScanFileSystem(ScanTarget::FillManualContentProvider, game_dir.path, game_dir.deep_scan,
-                           game_list_dir);
-            ScanFileSystem(ScanTarget::PopulateGameList, game_dir.path, game_dir.deep_scan,
-                           game_list_dir);
+            PopulateGameList(index, files, game_list_dir);
         }
     }
 
+    if (UISettings::values.cache_game_list) {
+        // Only forget the files which are gone after a complete scan.
+        void(index.Save(index_path, !stop_requested));
+    }
+
     RecordEvent([this](GameList* game_list) { game_list->DonePopulating(watch_list); });
     processing_completed.Set();
 }
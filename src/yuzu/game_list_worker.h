@@ -7,6 +7,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QList>
 #include <QObject>
@@ -22,6 +23,7 @@ class System;
 }
 
 class GameList;
+class GameListIndex;
 class QStandardItem;
 
 namespace FileSys {
@@ -68,13 +70,12 @@ private:
 private:
     void AddTitlesToGameList(GameListDir* parent_dir);
 
-    enum class ScanTarget {
-        FillManualContentProvider,
-        PopulateGameList,
-    };
+    /// Collects the game files of a directory, and the directories to watch for changes.
+    std::vector<std::string> FindGameFiles(const std::string& dir_path, bool deep_scan);
 
-    void ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
-                        GameListDir* parent_dir);
+    void FillManualContentProvider(GameListIndex& index, const std::vector<std::string>& files);
+    void PopulateGameList(GameListIndex& index, const std::vector<std::string>& files,
+                          GameListDir* parent_dir);
 
     std::shared_ptr<FileSys::VfsFilesystem> vfs;
     FileSys::ManualContentProvider* provider;
@@ -149,6 +149,7 @@ static FileSys::VirtualFile VfsDirectoryCreateFileWrapper(const FileSys::Virtual
 #include "yuzu/debugger/console.h"
 #include "yuzu/debugger/controller.h"
 #include "yuzu/debugger/profiler.h"
+#include "yuzu/debugger/service_profiler.h"
 #include "yuzu/debugger/wait_tree.h"
 #include "yuzu/discord.h"
 #include "yuzu/game_list.h"
@@ -1279,6 +1280,11 @@ void GMainWindow::InitializeDebugWidgets() {
     waitTreeWidget->hide();
     debug_menu->addAction(waitTreeWidget->toggleViewAction());
 
+    serviceProfilerWidget = new ServiceProfilerWidget(*system, this);
+    addDockWidget(Qt::BottomDockWidgetArea, serviceProfilerWidget);
+    serviceProfilerWidget->hide();
+    debug_menu->addAction(serviceProfilerWidget->toggleViewAction());
+
     controller_dialog = new ControllerDialog(system->HIDCore(), input_subsystem, this);
     controller_dialog->hide();
     debug_menu->addAction(controller_dialog->toggleViewAction());
@@ -1287,6 +1293,10 @@ void GMainWindow::InitializeDebugWidgets() {
             &WaitTreeWidget::OnEmulationStarting);
     connect(this, &GMainWindow::EmulationStopping, waitTreeWidget,
             &WaitTreeWidget::OnEmulationStopping);
+    connect(this, &GMainWindow::EmulationStarting, serviceProfilerWidget,
+            &ServiceProfilerWidget::OnEmulationStarting);
+    connect(this, &GMainWindow::EmulationStopping, serviceProfilerWidget,
+            &ServiceProfilerWidget::OnEmulationStopping);
 }
 
 void GMainWindow::InitializeRecentFileMenuActions() {
@@ -3257,6 +3267,8 @@ void GMainWindow::OnMenuInstallToNAND() {
     QStringList new_files{};         // Newly installed files that do not yet exist in the NAND
     QStringList overwritten_files{}; // Files that overwrote those existing in the NAND
     QStringList failed_files{};      // Files that failed to install due to errors
+    QStringList corrupted_files{};   // Files whose contents did not match their hashes
+    QStringList cancelled_files{};   // Files whose installation was cancelled
     bool detected_base_install{};    // Whether a base game was attempted to be installed
 
     ui->action_Install_File_NAND->setEnabled(false);
@@ -3276,8 +3288,13 @@ void GMainWindow::OnMenuInstallToNAND() {
         ContentManager::InstallResult result;
 
         if (file.endsWith(QStringLiteral("nsp"), Qt::CaseInsensitive)) {
-            const auto progress_callback = [this](size_t size, size_t progress) {
-                emit UpdateInstallProgress();
+            // The installer reports the bytes copied so far, the dialog counts CopyBufferSize
+            // blocks.
+            const auto progress_callback = [this, reported = size_t{0}](
+                                               size_t size, size_t progress) mutable {
+                for (; reported < progress / CopyBufferSize; ++reported) {
+                    emit UpdateInstallProgress();
+                }
                 if (install_progress->wasCanceled()) {
                     return true;
                 }
@@ -3315,9 +3332,20 @@ void GMainWindow::OnMenuInstallToNAND() {
             failed_files.append(QFileInfo(file).fileName());
             detected_base_install = true;
             break;
+        case ContentManager::InstallResult::HashMismatch:
+            corrupted_files.append(QFileInfo(file).fileName());
+            break;
+        case ContentManager::InstallResult::Cancelled:
+            cancelled_files.append(QFileInfo(file).fileName());
+            break;
         }
 
         --remaining;
+
+        // The remaining files are not installed either once the dialog was cancelled.
+        if (result == ContentManager::InstallResult::Cancelled) {
+            break;
+        }
     }
 
     install_progress->close();
@@ -3336,7 +3364,14 @@ void GMainWindow::OnMenuInstallToNAND() {
              ? QString{}
              : tr("%n file(s) were overwritten\n", "", overwritten_files.size())) +
         (failed_files.isEmpty() ? QString{}
-                                : tr("%n file(s) failed to install\n", "", failed_files.size()));
+                                : tr("%n file(s) failed to install\n", "", failed_files.size())) +
+        (corrupted_files.isEmpty()
+             ? QString{}
+             : tr("%n file(s) failed the hash verification, the dump may be corrupted\n", "",
+                  corrupted_files.size())) +
+        (cancelled_files.isEmpty()
+             ? QString{}
+             : tr("%n file(s) were cancelled\n", "", cancelled_files.size()));
 
     QMessageBox::information(this, tr("Install Results"), install_results);
     Common::FS::RemoveDirRecursively(Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) /
@@ -45,6 +45,7 @@ class QPushButton;
 class QProgressDialog;
 class QSlider;
 class QHBoxLayout;
+class ServiceProfilerWidget;
 class WaitTreeWidget;
 enum class GameListOpenTarget;
 enum class GameListRemoveTarget;
@@ -534,6 +535,7 @@ private:
     ProfilerWidget* profilerWidget;
     MicroProfileDialog* microProfileDialog;
     WaitTreeWidget* waitTreeWidget;
+    ServiceProfilerWidget* serviceProfilerWidget;
     ControllerDialog* controller_dialog;
 
     QAction* actions_recent_files[max_recent_files_item];
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/alignment.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/svc_common.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/host1x/host1x.h"
+#include "video_core/memory_manager.h"
+#include "yuzu_gpu_replay/replay_memory.h"
+
+namespace {
+constexpr size_t PAGE_SIZE = Tegra::CAPTURE_PAGE_SIZE;
+} // Anonymous namespace
+
+ReplayMemory::ReplayMemory(Core::System& system_) : system{system_} {}
+
+ReplayMemory::~ReplayMemory() {
+    Release();
+}
+
+bool ReplayMemory::Initialize(std::span<const Tegra::CapturedSubmission> submissions) {
+    std::vector<DAddr> pages;
+    for (const Tegra::CapturedSubmission& submission : submissions) {
+        for (const Tegra::CapturedMapping& mapping : submission.mappings) {
+            pages.push_back(Common::AlignDown(mapping.device_addr, PAGE_SIZE));
+        }
+        pages.insert(pages.end(), submission.page_addresses.begin(),
+                     submission.page_addresses.end());
+    }
+    std::ranges::sort(pages);
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+    if (pages.empty()) {
+        return true;
+    }
+
+    // Contiguous device pages share a run, so spans crossing them stay contiguous on the host
+    std::vector<std::pair<DAddr, size_t>> runs;
+    for (const DAddr page : pages) {
+        if (!runs.empty() && runs.back().first + runs.back().second == page) {
+            runs.back().second += PAGE_SIZE;
+        } else {
+            runs.emplace_back(page, PAGE_SIZE);
+        }
+    }
+    const size_t heap_size =
+        Common::AlignUp(pages.size() * PAGE_SIZE, Kernel::Svc::HeapSizeAlignment);
+
+    auto& kernel = system.Kernel();
+    process = Kernel::KProcess::Create(kernel);
+    Kernel::KProcess::Register(kernel, process);
+    if (process->LoadFromMetadata(FileSys::ProgramMetadata::GetDefault(), Kernel::PageSize, 0,
+                                  false)
+            .IsError()) {
+        LOG_CRITICAL(Frontend, "Failed to create the replay process");
+        return false;
+    }
+    auto& page_table = process->GetPageTable();
+    Kernel::KProcessAddress heap_address{};
+    if (page_table.SetMaxHeapSize(heap_size).IsError() ||
+        page_table.SetHeapSize(&heap_address, heap_size).IsError()) {
+        LOG_CRITICAL(Frontend, "Failed to allocate {} MiB of guest memory for the capture",
+                     heap_size >> 20);
+        return false;
+    }
+
+    auto& device_memory = system.Host1x().MemoryManager();
+    asid = device_memory.RegisterProcess(&process->GetMemory());
+    is_registered = true;
+    VAddr virtual_address = GetInteger(heap_address);
+    for (const auto& [address, size] : runs) {
+        device_memory.AllocateFixed(address, size);
+        device_memory.Map(address, virtual_address, size, asid, true);
+        device_ranges.emplace_back(address, size);
+        virtual_address += size;
+    }
+    return true;
+}
+
+void ReplayMemory::Apply(Tegra::MemoryManager& memory_manager,
+                         const Tegra::CapturedSubmission& submission) {
+    const auto is_mapped = [&](const Tegra::CapturedMapping& mapping, size_t size) {
+        for (size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+            const auto device_addr = memory_manager.GpuToCpuAddress(mapping.gpu_addr + offset);
+            if (device_addr != mapping.device_addr + offset ||
+                memory_manager.GetPageKind(mapping.gpu_addr + offset) != mapping.kind) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const auto& mappings = submission.mappings;
+    for (size_t first = 0; first < mappings.size();) {
+        // Merge the translations of consecutive pages into a single mapping
+        size_t last = first + 1;
+        while (last < mappings.size() &&
+               mappings[last].gpu_addr == mappings[last - 1].gpu_addr + PAGE_SIZE &&
+               mappings[last].device_addr == mappings[last - 1].device_addr + PAGE_SIZE &&
+               mappings[last].kind == mappings[first].kind) {
+            ++last;
+        }
+        const size_t size = (last - first) * PAGE_SIZE;
+        if (!is_mapped(mappings[first], size)) {
+            memory_manager.Map(mappings[first].gpu_addr, mappings[first].device_addr, size,
+                               mappings[first].kind, false);
+        }
+        first = last;
+    }
+
+    // Pages still holding the captured contents are left alone, so the caches keep them
+    auto& device_memory = system.Host1x().MemoryManager();
+    for (size_t index = 0; index < submission.page_addresses.size(); ++index) {
+        const DAddr address = submission.page_addresses[index];
+        const u8* const data = submission.page_data.data() + index * PAGE_SIZE;
+        const u8* const current = device_memory.GetPointer<u8>(address);
+        if (current == nullptr || std::memcmp(current, data, PAGE_SIZE) != 0) {
+            device_memory.WriteBlock(address, data, PAGE_SIZE);
+        }
+    }
+}
+
+void ReplayMemory::Release() {
+    auto& device_memory = system.Host1x().MemoryManager();
+    for (const auto& [address, size] : device_ranges) {
+        device_memory.Unmap(address, size);
+        device_memory.Free(address, size);
+    }
+    device_ranges.clear();
+    if (is_registered) {
+        device_memory.UnregisterProcess(asid);
+        is_registered = false;
+    }
+    if (process != nullptr) {
+        process->Close();
+        process = nullptr;
+    }
+}
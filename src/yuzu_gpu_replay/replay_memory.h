@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/device_memory_manager.h"
+
+namespace Core {
+class System;
+}
+
+namespace Kernel {
+class KProcess;
+}
+
+namespace Tegra {
+class MemoryManager;
+struct CapturedSubmission;
+} // namespace Tegra
+
+/**
+ * Guest memory of a replay. The device pages a capture stores are backed by the heap of a
+ * process that never runs, and each submission gets the GPU mappings and page contents it was
+ * recorded with restored before it is replayed.
+ */
+class ReplayMemory {
+public:
+    explicit ReplayMemory(Core::System& system);
+    ~ReplayMemory();
+
+    ReplayMemory(const ReplayMemory&) = delete;
+    ReplayMemory& operator=(const ReplayMemory&) = delete;
+
+    /// Backs every device page the submissions reference, returns false when it doesn't fit
+    [[nodiscard]] bool Initialize(std::span<const Tegra::CapturedSubmission> submissions);
+
+    /// Restores the mappings and the memory a submission was recorded with
+    void Apply(Tegra::MemoryManager& memory_manager, const Tegra::CapturedSubmission& submission);
+
+private:
+    void Release();
+
+    Core::System& system;
+    Kernel::KProcess* process = nullptr;
+    Core::Asid asid{};
+    bool is_registered = false;
+    std::vector<std::pair<DAddr, size_t>> device_ranges;
+};
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <SDL.h>
+#include <SDL_syswm.h>
+
+#include "common/logging/log.h"
+#include "core/frontend/framebuffer_layout.h"
+#include "core/frontend/graphics_context.h"
+#include "yuzu_gpu_replay/replay_window.h"
+
+namespace {
+class DummyContext : public Core::Frontend::GraphicsContext {};
+} // Anonymous namespace
+
+VulkanReplayWindow::VulkanReplayWindow() {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        LOG_CRITICAL(Frontend, "Failed to initialize SDL2: {}", SDL_GetError());
+        return;
+    }
+    render_window = SDL_CreateWindow("yuzu-gpu-replay", SDL_WINDOWPOS_UNDEFINED,
+                                     SDL_WINDOWPOS_UNDEFINED, Layout::ScreenUndocked::Width,
+                                     Layout::ScreenUndocked::Height, SDL_WINDOW_HIDDEN);
+    if (render_window == nullptr) {
+        LOG_CRITICAL(Frontend, "Failed to create the replay window: {}", SDL_GetError());
+        return;
+    }
+
+    SDL_SysWMinfo wm;
+    SDL_VERSION(&wm.version);
+    if (SDL_GetWindowWMInfo(render_window, &wm) == SDL_FALSE) {
+        LOG_CRITICAL(Frontend, "Failed to get information from the window manager: {}",
+                     SDL_GetError());
+        return;
+    }
+
+    switch (wm.subsystem) {
+#ifdef SDL_VIDEO_DRIVER_WINDOWS
+    case SDL_SYSWM_TYPE::SDL_SYSWM_WINDOWS:
+        window_info.type = Core::Frontend::WindowSystemType::Windows;
+        window_info.render_surface = reinterpret_cast<void*>(wm.info.win.window);
+        break;
+#endif
+#ifdef SDL_VIDEO_DRIVER_X11
+    case SDL_SYSWM_TYPE::SDL_SYSWM_X11:
+        window_info.type = Core::Frontend::WindowSystemType::X11;
+        window_info.display_connection = wm.info.x11.display;
+        window_info.render_surface = reinterpret_cast<void*>(wm.info.x11.window);
+        break;
+#endif
+#ifdef SDL_VIDEO_DRIVER_WAYLAND
+    case SDL_SYSWM_TYPE::SDL_SYSWM_WAYLAND:
+        window_info.type = Core::Frontend::WindowSystemType::Wayland;
+        window_info.display_connection = wm.info.wl.display;
+        window_info.render_surface = wm.info.wl.surface;
+        break;
+#endif
+#ifdef SDL_VIDEO_DRIVER_COCOA
+    case SDL_SYSWM_TYPE::SDL_SYSWM_COCOA:
+        window_info.type = Core::Frontend::WindowSystemType::Cocoa;
+        window_info.render_surface = SDL_Metal_CreateView(render_window);
+        break;
+#endif
+    default:
+        LOG_CRITICAL(Frontend, "Window manager subsystem {} not implemented", wm.subsystem);
+        return;
+    }
+
+    UpdateCurrentFramebufferLayout(Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height);
+    is_open = true;
+}
+
+VulkanReplayWindow::~VulkanReplayWindow() {
+    if (render_window != nullptr) {
+        SDL_DestroyWindow(render_window);
+    }
+    SDL_Quit();
+}
+
+bool VulkanReplayWindow::IsOpen() const {
+    return is_open;
+}
+
+std::unique_ptr<Core::Frontend::GraphicsContext> VulkanReplayWindow::CreateSharedContext() const {
+    return std::make_unique<DummyContext>();
+}
+
+bool VulkanReplayWindow::IsShown() const {
+    return false;
+}
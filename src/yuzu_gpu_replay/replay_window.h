@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+
+#include "core/frontend/emu_window.h"
+
+struct SDL_Window;
+
+/// Hidden SDL window providing the surface the Vulkan renderer is created with
+class VulkanReplayWindow final : public Core::Frontend::EmuWindow {
+public:
+    VulkanReplayWindow();
+    ~VulkanReplayWindow() override;
+
+    /// Returns true when the window and its surface were created
+    [[nodiscard]] bool IsOpen() const;
+
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override;
+
+    bool IsShown() const override;
+
+private:
+    SDL_Window* render_window = nullptr;
+    bool is_open = false;
+};
@@ -0,0 +1,381 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/detached_tasks.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/scope_exit.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_base.h"
+#include "yuzu_gpu_replay/replay_memory.h"
+#ifdef HAVE_SDL2
+#include "yuzu_gpu_replay/replay_window.h"
+#endif
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::array<const char*, Tegra::Engines::NUM_ENGINE_TYPES> ENGINE_NAMES{
+    "KeplerCompute", "Maxwell3D", "Fermi2D", "MaxwellDMA", "KeplerMemory",
+};
+
+class DummyContext : public Core::Frontend::GraphicsContext {};
+
+/// Window without a surface, the null renderer never presents to it
+class HeadlessWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<DummyContext>();
+    }
+
+    bool IsShown() const override {
+        return false;
+    }
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <capture>\n"
+                 "Replays the command lists of a capture, restoring the guest memory recorded\n"
+                 "with each submission, and reports the methods per engine and the hits of the\n"
+                 "renderer caches.\n"
+                 "-b, --backend         Renderer to replay with, null (default) or vulkan\n"
+                 "-r, --repeat          Number of timed replays after the profiling pass\n"
+                 "-s, --synthetic       Replay the given number of generated state-heavy\n"
+                 "                      submissions instead of a capture\n"
+                 "-h, --help            Display this help and exit\n"
+                 "-v, --version         Output version information and exit\n";
+}
+
+void PrintVersion() {
+    std::cout << "yuzu-gpu-replay " << Common::g_scm_branch << " " << Common::g_scm_desc
+              << std::endl;
+}
+
+std::vector<Tegra::CapturedSubmission> LoadCapture(const std::string& filepath) {
+    std::vector<Tegra::CapturedSubmission> submissions;
+    Tegra::GpuCaptureReader reader(filepath);
+    if (!reader.IsOpen()) {
+        return submissions;
+    }
+    Tegra::CapturedSubmission submission;
+    while (reader.Next(submission)) {
+        submissions.push_back(std::move(submission));
+    }
+    return submissions;
+}
+
+/**
+ * Generates a stream shaped like the state updates games emit between draws: incrementing runs
+ * over viewport state and non-incrementing writes to a single register, three out of four runs
+ * rewriting the values already present.
+ */
+std::vector<Tegra::CapturedSubmission> BuildSyntheticCapture(u32 num_submissions) {
+    using Tegra::Engines::Maxwell3D;
+    static constexpr u32 BATCHES_PER_SUBMISSION = 64;
+    static constexpr u32 SUBCHANNEL = 0;
+
+    const auto method_header = [](Tegra::SubmissionMode mode, u32 method, u32 count) {
+        Tegra::CommandHeader header{};
+        header.method.Assign(method);
+        header.subchannel.Assign(SUBCHANNEL);
+        header.method_count.Assign(count);
+        header.mode.Assign(mode);
+        return header;
+    };
+    const auto append_run = [&](std::vector<Tegra::CommandHeader>& words,
+                                Tegra::SubmissionMode mode, u32 method, u32 count, u32 seed) {
+        words.push_back(method_header(mode, method, count));
+        for (u32 i = 0; i < count; ++i) {
+            Tegra::CommandHeader value{};
+            value.argument = seed + i;
+            words.push_back(value);
+        }
+    };
+
+    std::vector<Tegra::CapturedSubmission> submissions(num_submissions);
+    for (u32 index = 0; index < num_submissions; ++index) {
+        auto& words = submissions[index].command_lists.emplace_back();
+        if (index == 0) {
+            words.push_back(method_header(Tegra::SubmissionMode::Increasing,
+                                          static_cast<u32>(Tegra::BufferMethods::BindObject), 1));
+            Tegra::CommandHeader engine{};
+            engine.argument = static_cast<u32>(Tegra::EngineID::MAXWELL_B);
+            words.push_back(engine);
+        }
+        for (u32 batch = 0; batch < BATCHES_PER_SUBMISSION; ++batch) {
+            const u32 seed = (index * BATCHES_PER_SUBMISSION + batch) / 4;
+            append_run(words, Tegra::SubmissionMode::Increasing,
+                       MAXWELL3D_REG_INDEX(viewport_transform), 32, seed);
+            append_run(words, Tegra::SubmissionMode::Increasing, MAXWELL3D_REG_INDEX(viewports),
+                       16, seed);
+            append_run(words, Tegra::SubmissionMode::NonIncreasing,
+                       MAXWELL3D_REG_INDEX(scissor_test), 4, seed);
+        }
+    }
+    return submissions;
+}
+
+void PrintCacheCounters(const char* name, const VideoCommon::CacheCounters& first,
+                        const VideoCommon::CacheCounters& total) {
+    const auto hit_rate = [](u64 hits, u64 misses) {
+        const u64 lookups = hits + misses;
+        return lookups == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / lookups;
+    };
+    const u64 hits = total.hits - first.hits;
+    const u64 misses = total.misses - first.misses;
+    std::cout << fmt::format("{:<14} {:>10} {:>10} {:>7.1f}% {:>10} {:>10} {:>7.1f}%\n", name,
+                             first.hits, first.misses, hit_rate(first.hits, first.misses), hits,
+                             misses, hit_rate(hits, misses));
+}
+
+/// Builds the command lists of a pass up front, so copying them isn't part of the measurement
+std::vector<std::vector<Tegra::CommandList>> BuildCommandLists(
+    const std::vector<Tegra::CapturedSubmission>& submissions) {
+    std::vector<std::vector<Tegra::CommandList>> result(submissions.size());
+    for (size_t index = 0; index < submissions.size(); ++index) {
+        for (const auto& words : submissions[index].command_lists) {
+            if (words.empty()) {
+                continue;
+            }
+            result[index].emplace_back(
+                boost::container::small_vector<Tegra::CommandHeader, 512>(words.begin(),
+                                                                          words.end()));
+        }
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Common::DetachedTasks detached_tasks;
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    int option_index = 0;
+    char* endarg;
+    std::string filepath;
+    u32 repeat = 1;
+    u32 synthetic = 0;
+    std::string backend = "null";
+
+    static struct option long_options[] = {
+        {"backend", required_argument, 0, 'b'},
+        {"repeat", required_argument, 0, 'r'},
+        {"synthetic", required_argument, 0, 's'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "b:r:s:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'b':
+                backend = optarg;
+                break;
+            case 'r':
+                repeat = static_cast<u32>(strtoul(optarg, &endarg, 0));
+                break;
+            case 's':
+                synthetic = static_cast<u32>(strtoul(optarg, &endarg, 0));
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            }
+        } else {
+            filepath = argv[optind];
+            optind++;
+        }
+    }
+
+    if (filepath.empty() && synthetic == 0) {
+        LOG_CRITICAL(Frontend, "Failed to load capture: No capture specified");
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    if (backend != "null" && backend != "vulkan") {
+        LOG_CRITICAL(Frontend, "Unknown backend {}", backend);
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    // Guest memory reached only through host pointers isn't part of the capture, silence the
+    // warnings replayed engines emit for it so they don't dominate the measurement
+    Common::Log::Filter filter;
+    filter.ParseFilterString("*:Error");
+    Common::Log::SetGlobalFilter(filter);
+
+    const std::vector<Tegra::CapturedSubmission> submissions =
+        synthetic != 0 ? BuildSyntheticCapture(synthetic) : LoadCapture(filepath);
+    if (submissions.empty()) {
+        LOG_CRITICAL(Frontend, "Capture {} has no submissions", filepath);
+        return -1;
+    }
+
+    Settings::values.renderer_backend.SetValue(backend == "vulkan"
+                                                   ? Settings::RendererBackend::Vulkan
+                                                   : Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+    Settings::values.use_disk_shader_cache.SetValue(false);
+    Settings::values.dump_gpu_commands.SetValue(false);
+
+    Core::System system{};
+    system.Initialize();
+
+    HeadlessWindow headless_window;
+    Core::Frontend::EmuWindow* window = &headless_window;
+#ifdef HAVE_SDL2
+    std::unique_ptr<VulkanReplayWindow> vulkan_window;
+#endif
+    if (backend == "vulkan") {
+#ifdef HAVE_SDL2
+        vulkan_window = std::make_unique<VulkanReplayWindow>();
+        if (!vulkan_window->IsOpen()) {
+            return -1;
+        }
+        window = vulkan_window.get();
+#else
+        LOG_CRITICAL(Frontend, "The Vulkan backend requires a build with SDL2");
+        return -1;
+#endif
+    }
+    if (system.InitializeGPU(*window) != Core::SystemResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to initialize the GPU");
+        return -1;
+    }
+    SCOPE_EXIT {
+        system.ShutdownMainProcess();
+    };
+
+    // Released before the system shuts down the kernel owning its process
+    ReplayMemory memory{system};
+    if (!memory.Initialize(submissions)) {
+        return -1;
+    }
+
+    Tegra::GPU& gpu = system.GPU();
+    Tegra::DmaPusherStatistics statistics;
+    std::unordered_map<s32, std::shared_ptr<Tegra::Control::ChannelState>> channels;
+    for (const Tegra::CapturedSubmission& submission : submissions) {
+        if (channels.contains(submission.channel)) {
+            continue;
+        }
+        auto channel = gpu.AllocateChannel();
+        channel->memory_manager = std::make_shared<Tegra::MemoryManager>(system);
+        gpu.InitAddressSpace(*channel->memory_manager);
+        gpu.InitChannel(*channel, 0);
+        channels.emplace(submission.channel, std::move(channel));
+    }
+
+    // Restoring guest memory is timed apart and left out of the pass time, the invalidations it
+    // causes in the renderer caches are part of the restore time
+    std::chrono::duration<double> restore_time{};
+    const auto replay = [&](bool profile) {
+        std::vector<std::vector<Tegra::CommandList>> lists = BuildCommandLists(submissions);
+        for (const auto& [id, channel] : channels) {
+            channel->dma_pusher->BindStatistics(profile ? &statistics : nullptr);
+        }
+        std::chrono::duration<double> pass_restore_time{};
+        const auto start{std::chrono::steady_clock::now()};
+        for (size_t index = 0; index < submissions.size(); ++index) {
+            const auto& channel = channels.at(submissions[index].channel);
+            const auto restore_start{std::chrono::steady_clock::now()};
+            memory.Apply(*channel->memory_manager, submissions[index]);
+            pass_restore_time += std::chrono::steady_clock::now() - restore_start;
+            gpu.BindChannel(channel->bind_id);
+            for (Tegra::CommandList& list : lists[index]) {
+                channel->dma_pusher->Push(std::move(list));
+            }
+            channel->dma_pusher->DispatchCalls();
+        }
+        restore_time += pass_restore_time;
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start) -
+               pass_restore_time;
+    };
+
+    // The first pass warms up the macro and renderer caches and collects the method statistics,
+    // timing every method skews the total so the following passes run without them
+    VideoCore::RasterizerInterface* const rasterizer = gpu.Renderer().ReadRasterizer();
+    const auto profiled_time = replay(true);
+    const VideoCore::CacheStatistics first_pass_caches = rasterizer->GetCacheStatistics();
+    std::chrono::duration<double> replay_time{};
+    for (u32 pass = 0; pass < repeat; ++pass) {
+        replay_time += replay(false);
+    }
+
+    u64 total_methods = statistics.puller.methods;
+    for (const auto& counter : statistics.engines) {
+        total_methods += counter.methods;
+    }
+    const double seconds = repeat > 0 ? replay_time.count() / repeat : profiled_time.count();
+
+    std::cout << fmt::format("Replayed {} submissions on {} channels, {} methods per pass\n",
+                             submissions.size(), channels.size(), total_methods);
+    std::cout << fmt::format("Pass time: {:.3f} ms, {:.2f} M methods/s\n", seconds * 1000.0,
+                             static_cast<double>(total_methods) / seconds / 1e6);
+    std::cout << fmt::format("Memory restore time: {:.3f} ms per pass\n",
+                             restore_time.count() * 1000.0 / (repeat + 1));
+    std::cout << fmt::format("{:<14} {:>12} {:>12} {:>10}\n", "Engine", "Methods", "Time (ms)",
+                             "ns/method");
+    const auto print_counter = [](const char* name, const Tegra::DmaPusherStatistics::Counter& c) {
+        if (c.methods == 0) {
+            return;
+        }
+        const auto nanoseconds = static_cast<double>(c.time.count());
+        std::cout << fmt::format("{:<14} {:>12} {:>12.3f} {:>10.1f}\n", name, c.methods,
+                                 nanoseconds / 1e6, nanoseconds / static_cast<double>(c.methods));
+    };
+    print_counter("Puller", statistics.puller);
+    for (size_t engine = 0; engine < statistics.engines.size(); ++engine) {
+        print_counter(ENGINE_NAMES[engine], statistics.engines[engine]);
+    }
+
+    if (backend != "null") {
+        const VideoCore::CacheStatistics caches = rasterizer->GetCacheStatistics();
+        std::cout << fmt::format("{:<14} {:>10} {:>10} {:>8} {:>10} {:>10} {:>8}\n", "Cache",
+                                 "First hits", "Misses", "Rate", "Next hits", "Misses", "Rate");
+        PrintCacheCounters("Textures", first_pass_caches.textures, caches.textures);
+        PrintCacheCounters("Buffers", first_pass_caches.buffers, caches.buffers);
+        PrintCacheCounters("Pipelines", first_pass_caches.pipelines, caches.pipelines);
+    }
+    return 0;
+}